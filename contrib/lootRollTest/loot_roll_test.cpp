@@ -0,0 +1,337 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+// Loot group roller equivalence test and benchmark.
+//
+// LootTemplate::LootGroup used to roll its item by walking the explicitly chanced
+// entries and then picking one of the equal chanced ones. It now draws from an alias
+// table built by LootGroup::Compile(). This program holds a copy of both rollers,
+// rolls random groups (and a few edge cases) with each of them, and checks with a
+// two sample chi-square test that both give the same distribution of outcomes.
+// It also prints the time per roll of both.
+//
+// Build: g++ -O2 -o loot_roll_test loot_roll_test.cpp
+// Usage: loot_roll_test [groups] [rolls per group]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+typedef unsigned int uint32;
+
+static std::mt19937 rng(12345);
+
+static float rand_norm_f() { return std::uniform_real_distribution<float>(0.0f, 1.0f)(rng); }
+static float rand_chance_f() { return rand_norm_f() * 100.0f; }
+static uint32 urand(uint32 min, uint32 max) { return std::uniform_int_distribution<uint32>(min, max)(rng); }
+
+struct Entry
+{
+    float chance;                                           // 0 for equal chanced entries
+    bool disabled;                                          // DISABLE_TYPE_ITEM_DROP
+};
+
+struct Group
+{
+    std::vector<Entry> explicitlyChanced;
+    std::vector<Entry> equalChanced;
+};
+
+static int const NO_DROP = -1;
+
+// the roller before the alias tables, LootGroup::Roll() and the disable check of LootGroup::Process()
+static int OldRoll(Group const& group)
+{
+    Entry const* item = NULL;
+    int index = NO_DROP;
+
+    if (!group.explicitlyChanced.empty())
+    {
+        float roll = rand_chance_f();
+
+        for (uint32 i = 0; i < group.explicitlyChanced.size(); ++i)
+        {
+            if (group.explicitlyChanced[i].chance >= 100.0f)
+            {
+                item = &group.explicitlyChanced[i];
+                index = i;
+                break;
+            }
+
+            roll -= group.explicitlyChanced[i].chance;
+            if (roll < 0)
+            {
+                item = &group.explicitlyChanced[i];
+                index = i;
+                break;
+            }
+        }
+    }
+    if (!item && !group.equalChanced.empty())
+    {
+        uint32 i = urand(0, group.equalChanced.size() - 1);
+        item = &group.equalChanced[i];
+        index = group.explicitlyChanced.size() + i;
+    }
+
+    return item && !item->disabled ? index : NO_DROP;
+}
+
+struct AliasSlot
+{
+    float probability;
+    uint32 alias;
+    int item;
+};
+
+// copy of LootGroup::Compile(), outcomes are entry indexes (equal chanced after the explicit ones) or NO_DROP
+static std::vector<AliasSlot> Compile(Group const& group)
+{
+    std::vector<std::pair<int, float> > outcomes;
+    std::vector<AliasSlot> aliasTable;
+    float noDrop = 0.0f;
+    float used = 0.0f;
+
+    for (uint32 i = 0; i < group.explicitlyChanced.size() && used < 100.0f; ++i)
+    {
+        Entry const& entry = group.explicitlyChanced[i];
+        float chance = entry.chance >= 100.0f ? 100.0f - used : std::min(entry.chance, 100.0f - used);
+        used += chance;
+
+        if (entry.disabled)
+        {
+            noDrop += chance;
+        }
+        else
+        {
+            outcomes.push_back(std::make_pair(int(i), chance));
+        }
+    }
+
+    if (used < 100.0f)
+    {
+        if (group.equalChanced.empty())
+        {
+            noDrop += 100.0f - used;
+        }
+        else
+        {
+            float chance = (100.0f - used) / group.equalChanced.size();
+            for (uint32 i = 0; i < group.equalChanced.size(); ++i)
+            {
+                if (group.equalChanced[i].disabled)
+                {
+                    noDrop += chance;
+                }
+                else
+                {
+                    outcomes.push_back(std::make_pair(int(group.explicitlyChanced.size() + i), chance));
+                }
+            }
+        }
+    }
+
+    if (noDrop > 0.0f)
+    {
+        outcomes.push_back(std::make_pair(NO_DROP, noDrop));
+    }
+
+    if (outcomes.empty())
+    {
+        return aliasTable;
+    }
+
+    uint32 size = outcomes.size();
+    std::vector<float> scaled(size);
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < size; ++i)
+    {
+        AliasSlot slot = { 1.0f, i, outcomes[i].first };
+        aliasTable.push_back(slot);
+
+        scaled[i] = outcomes[i].second * size / 100.0f;
+        (scaled[i] < 1.0f ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+
+        aliasTable[less].probability = scaled[less];
+        aliasTable[less].alias = more;
+
+        scaled[more] -= 1.0f - scaled[less];
+        if (scaled[more] < 1.0f)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    return aliasTable;
+}
+
+// copy of LootGroup::Roll()
+static int NewRoll(std::vector<AliasSlot> const& aliasTable)
+{
+    if (aliasTable.empty())
+    {
+        return NO_DROP;
+    }
+
+    AliasSlot const& slot = aliasTable[urand(0, aliasTable.size() - 1)];
+    return rand_norm_f() < slot.probability ? slot.item : aliasTable[slot.alias].item;
+}
+
+static Group RandomGroup()
+{
+    Group group;
+    uint32 explicitCount = urand(0, 12);
+    uint32 equalCount = urand(0, 8);
+    // sums below and above 100, as in the world databases
+    float scale = urand(0, 3) == 0 ? 40.0f : 12.0f;
+
+    for (uint32 i = 0; i < explicitCount; ++i)
+    {
+        Entry entry = { std::max(0.01f, rand_norm_f() * scale), urand(0, 9) == 0 };
+        group.explicitlyChanced.push_back(entry);
+    }
+    for (uint32 i = 0; i < equalCount; ++i)
+    {
+        Entry entry = { 0.0f, urand(0, 9) == 0 };
+        group.equalChanced.push_back(entry);
+    }
+    return group;
+}
+
+static std::vector<Group> EdgeCases()
+{
+    std::vector<Group> groups;
+    Entry always = { 100.0f, false }, half = { 50.0f, false }, small = { 0.5f, false }, equal = { 0.0f, false }, disabled = { 30.0f, true };
+
+    Group g;
+    g.explicitlyChanced.push_back(half); g.explicitlyChanced.push_back(always); g.explicitlyChanced.push_back(half);
+    groups.push_back(g);                                    // entry after a 100% one
+
+    g = Group();
+    g.explicitlyChanced.push_back(half); g.explicitlyChanced.push_back(half); g.explicitlyChanced.push_back(half);
+    g.equalChanced.push_back(equal);
+    groups.push_back(g);                                    // chances above 100, equal chanced never reached
+
+    g = Group();
+    g.explicitlyChanced.push_back(small); g.explicitlyChanced.push_back(disabled);
+    groups.push_back(g);                                    // mostly no drop
+
+    g = Group();
+    for (int i = 0; i < 5; ++i)
+    {
+        g.equalChanced.push_back(equal);
+    }
+    g.equalChanced[2].disabled = true;
+    groups.push_back(g);                                    // equal chanced only
+
+    return groups;
+}
+
+// Wilson-Hilferty approximation of the chi-square distribution, as a standard normal z
+static double ChiSquareZ(double chi2, uint32 dof)
+{
+    double k = dof;
+    return (std::pow(chi2 / k, 1.0 / 3.0) - (1.0 - 2.0 / (9.0 * k))) / std::sqrt(2.0 / (9.0 * k));
+}
+
+int main(int argc, char** argv)
+{
+    uint32 groupCount = argc > 1 ? std::max(0, atoi(argv[1])) : 200;
+    uint32 rolls = argc > 2 ? std::max(1000, atoi(argv[2])) : 200000;
+    double const maxZ = 4.26;                               // p < 0.00001 per group, keeps false alarms rare over many groups
+
+    std::vector<Group> groups = EdgeCases();
+    while (groups.size() < groupCount + 4)
+    {
+        groups.push_back(RandomGroup());
+    }
+
+    uint32 failed = 0;
+    double oldNs = 0.0, newNs = 0.0;
+
+    for (uint32 g = 0; g < groups.size(); ++g)
+    {
+        Group const& group = groups[g];
+        uint32 outcomes = group.explicitlyChanced.size() + group.equalChanced.size() + 1;
+        std::vector<double> oldCount(outcomes), newCount(outcomes);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < rolls; ++i)
+        {
+            ++oldCount[OldRoll(group) + 1];
+        }
+        oldNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<AliasSlot> aliasTable = Compile(group);
+        start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < rolls; ++i)
+        {
+            ++newCount[NewRoll(aliasTable) + 1];
+        }
+        newNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        double chi2 = 0.0;
+        uint32 dof = 0;
+        for (uint32 o = 0; o < outcomes; ++o)
+        {
+            if (oldCount[o] + newCount[o] > 0.0)
+            {
+                chi2 += (oldCount[o] - newCount[o]) * (oldCount[o] - newCount[o]) / (oldCount[o] + newCount[o]);
+                ++dof;
+            }
+        }
+
+        if (dof > 1 && ChiSquareZ(chi2, dof - 1) > maxZ)
+        {
+            printf("Group %u (%zu explicitly chanced, %zu equal chanced): chi-square %.1f with %u degrees of freedom\n",
+                   g, group.explicitlyChanced.size(), group.equalChanced.size(), chi2, dof - 1);
+            ++failed;
+        }
+    }
+
+    double total = double(rolls) * groups.size();
+    printf("%zu groups, %u rolls each\n", groups.size(), rolls);
+    printf("sequential roll:   %6.1f ns per group roll\n", oldNs / total);
+    printf("alias table roll:  %6.1f ns per group roll\n", newNs / total);
+
+    if (failed)
+    {
+        printf("%u groups differ between the two rollers!\n", failed);
+        return 1;
+    }
+    printf("No distribution differences found.\n");
+    return 0;
+}
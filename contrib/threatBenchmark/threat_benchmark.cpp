@@ -0,0 +1,192 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+// Raid sized threat list benchmark.
+//
+// Replays the same fight against the threat list of ThreatContainer as it was
+// (std::list, list::sort when dirty) and as it is (std::vector, insertion sort
+// when dirty), and checks that both pick the same victim on every tick and
+// end with the same order.
+// The dirty rules are the ones of ThreatManager::processThreatEvent.
+//
+// Build: g++ -O2 -o threat_benchmark threat_benchmark.cpp
+// Usage: threat_benchmark [attackers] [ticks]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+
+struct Ref
+{
+    unsigned id;
+    float threat;
+};
+
+static bool SortPredicate(Ref const* lhs, Ref const* rhs)
+{
+    return lhs->threat > rhs->threat;
+}
+
+struct ListContainer
+{
+    typedef std::list<Ref*> List;
+    List list;
+    bool dirty;
+
+    ListContainer() : dirty(false) {}
+    void add(Ref* ref) { list.push_back(ref); }
+    void update()
+    {
+        if (dirty && list.size() > 1)
+        {
+            list.sort(SortPredicate);
+        }
+        dirty = false;
+    }
+    Ref* front() const { return list.front(); }
+};
+
+struct VectorContainer
+{
+    typedef std::vector<Ref*> List;
+    List list;
+    bool dirty;
+
+    VectorContainer() : dirty(false) {}
+    void add(Ref* ref) { list.push_back(ref); }
+    void update()
+    {
+        if (dirty && list.size() > 1)
+        {
+            for (List::iterator itr = list.begin() + 1; itr != list.end(); ++itr)
+            {
+                Ref* ref = *itr;
+                List::iterator pos = itr;
+                for (; pos != list.begin() && SortPredicate(ref, *(pos - 1)); --pos)
+                {
+                    *pos = *(pos - 1);
+                }
+                *pos = ref;
+            }
+        }
+        dirty = false;
+    }
+    Ref* front() const { return list.front(); }
+};
+
+// one threat change, marking the list dirty like UEV_THREAT_REF_THREAT_CHANGE does
+template<class Container>
+static void AddThreat(Container& container, Ref* ref, Ref* victim, float mod)
+{
+    ref->threat += mod;
+    if ((ref == victim && mod < 0.0f) || (ref != victim && mod > 0.0f))
+    {
+        container.dirty = true;
+    }
+}
+
+// the head walk of selectNextVictim with the 110% rule
+template<class Container>
+static Ref* SelectVictim(Container& container, Ref* victim)
+{
+    container.update();
+    Ref* best = container.front();
+    if (victim && best != victim && best->threat <= 1.1f * victim->threat)
+    {
+        return victim;
+    }
+    return best;
+}
+
+template<class Container>
+static double Run(unsigned attackers, unsigned ticks, std::vector<Ref>& refs, std::vector<unsigned>& victims, std::vector<unsigned>& order)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> damage(50.0f, 400.0f);
+    std::uniform_int_distribution<unsigned> who(0, attackers - 1);
+
+    refs.assign(attackers, Ref());
+    Container container;
+    for (unsigned i = 0; i < attackers; ++i)
+    {
+        refs[i].id = i;
+        refs[i].threat = 0.0f;
+        container.add(&refs[i]);
+    }
+
+    Ref* victim = NULL;
+    victims.assign(ticks, 0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned tick = 0; tick < ticks; ++tick)
+    {
+        // every attacker lands about one hit per 10 ticks, the tank every tick
+        AddThreat(container, &refs[0], victim, damage(rng) * 3.0f);
+        for (unsigned hit = 0; hit < attackers / 10; ++hit)
+        {
+            AddThreat(container, &refs[who(rng)], victim, damage(rng));
+        }
+        // threat wipes, as the modifyThreatPercent(-100) of boss scripts
+        if (tick % 500 == 499)
+        {
+            AddThreat(container, &refs[0], victim, -refs[0].threat);
+        }
+        victim = SelectVictim(container, victim);
+        victims[tick] = victim->id;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    order.clear();
+    for (typename Container::List::const_iterator itr = container.list.begin(); itr != container.list.end(); ++itr)
+    {
+        order.push_back((*itr)->id);
+    }
+    return ns / ticks;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned attackers = argc > 1 ? std::max(2, atoi(argv[1])) : 55;      // 40 players and 15 pets
+    unsigned ticks = argc > 2 ? std::max(1, atoi(argv[2])) : 200000;
+
+    std::vector<Ref> listRefs, vectorRefs;
+    std::vector<unsigned> listVictims, vectorVictims, listOrder, vectorOrder;
+    double listNs = Run<ListContainer>(attackers, ticks, listRefs, listVictims, listOrder);
+    double vectorNs = Run<VectorContainer>(attackers, ticks, vectorRefs, vectorVictims, vectorOrder);
+
+    printf("%u attackers, %u ticks\n", attackers, ticks);
+    printf("std::list   + list::sort:      %8.1f ns per getHostileTarget\n", listNs);
+    printf("std::vector + insertion sort:  %8.1f ns per getHostileTarget\n", vectorNs);
+
+    if (listVictims != vectorVictims || listOrder != vectorOrder)
+    {
+        printf("Victim or order mismatch between the two containers!\n");
+        return 1;
+    }
+    printf("Same victims and order in both containers.\n");
+    return 0;
+}
@@ -86,6 +86,9 @@ struct GroupQueueInfo
     uint32  JoinTime; /**< Time when group was added */
     uint32  RemoveInviteTime; /**< Time when we will remove invite for players in group */
     uint32  IsInvitedToBGInstanceGUID; /**< Was invited to certain BG */
+    BattleGroundBracketId BracketId; /**< Bracket of the queue the group waits in */
+    uint8   QueueType; /**< BattleGroundQueueGroupTypes of the queue the group waits in */
+    int64   QueueOrder; /**< Position in that queue, lower values are invited first */
 };
 
 /**
@@ -219,21 +222,54 @@ class BattleGroundQueue
         QueuedPlayersMap m_QueuedPlayers; /**< Map for storing queued players. */
 
         /**
-         * @brief List for storing queued groups.
-         * We need constant add to begin and constant remove / add from the end, therefore deque suits our problem well.
+         * @brief Orders queued groups by GroupQueueInfo::QueueOrder.
          */
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
+        struct GroupQueueOrder
+        {
+            bool operator()(GroupQueueInfo const* a, GroupQueueInfo const* b) const { return a->QueueOrder < b->QueueOrder; }
+        };
+
+        /**
+         * @brief Ordered set of groups waiting for an invitation.
+         * Groups are added at either end and removed from anywhere in O(log n); invited groups are taken out,
+         * so the match checks never have to step over them.
+         */
+        typedef std::set<GroupQueueInfo*, GroupQueueOrder> GroupsQueueType;
 
         /**
-         * @brief Two dimensional array for storing all queued groups.
-         * First dimension specifies the bgTypeId.
+         * @brief List of groups picked by a selection pool.
+         */
+        typedef std::list<GroupQueueInfo*> SelectedGroupsType;
+
+        /**
+         * @brief Two dimensional array for storing the groups waiting for an invitation.
+         * First dimension specifies the bracket.
          * Second dimension specifies the player's group types.
              BG_QUEUE_PREMADE_ALLIANCE  is used for premade alliance groups and alliance rated arena teams
              BG_QUEUE_PREMADE_HORDE     is used for premade horde groups and horde rated arena teams
              BG_QUEUE_NORMAL_ALLIANCE   is used for normal (or small) alliance groups or non-rated arena matches
              BG_QUEUE_NORMAL_HORDE      is used for normal (or small) horde groups or non-rated arena matches
          */
-        GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT]; /**< Two dimensional array for storing all queued groups. */
+        GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT]; /**< Two dimensional array for storing the waiting groups. */
+
+        uint32 m_QueuedPlayerCount[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT]; /**< Running player totals of m_QueuedGroups. */
+        int64 m_FirstQueueOrder; /**< QueueOrder of the group last added at the front of a queue. */
+        int64 m_LastQueueOrder; /**< QueueOrder of the group last added at the back of a queue. */
+
+        /**
+         * @brief Adds a group to the waiting groups of a queue.
+         * @param ginfo Pointer to the group queue info.
+         * @param bracketId The bracket id.
+         * @param queueType The BattleGroundQueueGroupTypes queue.
+         * @param atFront True to put the group before all groups already waiting.
+         */
+        void QueueGroup(GroupQueueInfo* ginfo, BattleGroundBracketId bracketId, uint8 queueType, bool atFront);
+
+        /**
+         * @brief Takes a group out of the waiting groups of its queue.
+         * @param ginfo Pointer to the group queue info.
+         */
+        void UnqueueGroup(GroupQueueInfo* ginfo);
 
         /**
          * @brief Class to select and invite groups to battleground.
@@ -273,7 +309,7 @@ class BattleGroundQueue
                 uint32 GetPlayerCount() const {return PlayerCount;}
 
             public:
-                GroupsQueueType SelectedGroups; /**< List of selected groups. */
+                SelectedGroupsType SelectedGroups; /**< List of selected groups. */
 
             private:
                 uint32 PlayerCount; /**< Player count in the selection pool. */
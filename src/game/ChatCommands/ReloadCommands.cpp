@@ -947,6 +947,7 @@ bool ChatHandler::HandleReloadDisablesCommand(char* /*args*/)
     sLog.outString("Re-loading Disables...");
     DisableMgr::LoadDisables();
     DisableMgr::CheckQuestDisables();
+    CompileLootTemplates();                                 // disabled item drops are left out of compiled loot
     SendGlobalSysMessage("DB table `disables` reloaded.", SEC_MODERATOR);
     return true;
 }
\ No newline at end of file
@@ -24,7 +24,10 @@
 
 #include "Chat.h"
 #include "ObjectMgr.h"
+#include "Database/DatabaseEnv.h"
 #include "World.h"
+#include "MapManager.h"
+#include "Spell.h"
 #include "Config.h"
 #include "GitRevision.h"
 #include "SystemConfig.h"
@@ -76,6 +79,42 @@ bool ChatHandler::HandleServerInfoCommand(char* /*args*/)
     PSendSysMessage(LANG_UPTIME, str.c_str());
     PSendSysMessage("World Delay: %u", updateTime); // ToDo: move to language string
 
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR && (sLog.GetAsyncDroppedCount() || sLog.GetAsyncOverflowCount()))
+    {
+        PSendSysMessage("Log lines dropped: " UI64FMTD ", written on overflow: " UI64FMTD, sLog.GetAsyncDroppedCount(), sLog.GetAsyncOverflowCount()); // ToDo: move to language string
+    }
+
+    uint64 skippedCreatureUpdates = sMapMgr.GetSkippedCreatureUpdateCount();
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR && skippedCreatureUpdates)
+    {
+        uint64 creatureUpdates = sMapMgr.GetCreatureUpdateCount();
+        PSendSysMessage("Creature updates: " UI64FMTD ", skipped far from players: " UI64FMTD " (%.1f%%)", creatureUpdates, skippedCreatureUpdates, // ToDo: move to language string
+                        skippedCreatureUpdates * 100.0 / (creatureUpdates + skippedCreatureUpdates));
+    }
+
+    SqlLatencyHistogram const& loginLatency = CharacterDatabase.GetHolderLatency();
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR && loginLatency.GetCount())
+    {
+        PSendSysMessage("Character loads: " UI64FMTD ", avg %u ms, p50 %u ms, p90 %u ms, p99 %u ms, max %u ms", loginLatency.GetCount(), // ToDo: move to language string
+                        loginLatency.GetAverage(), loginLatency.GetPercentile(50), loginLatency.GetPercentile(90), loginLatency.GetPercentile(99), loginLatency.GetMax());
+    }
+
+    uint64 spellsCreated = Spell::GetCreatedCount();
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR && spellsCreated)
+    {
+        PSendSysMessage("Spell objects: " UI64FMTD ", reused from pool: %.1f%%", spellsCreated, // ToDo: move to language string
+                        Spell::GetPooledCreatedCount() * 100.0 / spellsCreated);
+    }
+
+    MapTimeStats const& instanceCreates = sMapMgr.GetInstanceCreateTimes();
+    MapTimeStats const& instanceGridLoads = sMapMgr.GetInstanceGridLoadTimes();
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR && instanceGridLoads.GetCount())
+    {
+        PSendSysMessage("Instances created: " UI64FMTD ", avg %.1f ms, max %u ms; grids loaded: " UI64FMTD ", avg %.1f ms, max %u ms", // ToDo: move to language string
+                        instanceCreates.GetCount(), instanceCreates.GetAverage(), instanceCreates.GetMax(),
+                        instanceGridLoads.GetCount(), instanceGridLoads.GetAverage(), instanceGridLoads.GetMax());
+    }
+
     return true;
 }
 
@@ -659,6 +659,13 @@ bool ChatHandler::HandleGPSCommand(char* args)
         PSendSysMessage(LANG_LIQUID_STATUS, liquid_status.level, liquid_status.depth_level, liquid_status.type_flags, res);
     }
 
+    ScriptSchedule const& scriptSchedule = map->GetScriptSchedule();
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR && scriptSchedule.GetExecutedCount())
+    {
+        PSendSysMessage("Map script steps pending: %u (peak %u), executed: " UI64FMTD, // ToDo: move to language string
+                        scriptSchedule.size(), scriptSchedule.GetPeakSize(), scriptSchedule.GetExecutedCount());
+    }
+
     // Additional vmap debugging help
 #ifdef _DEBUG_VMAPS
     PSendSysMessage("Static terrain height (maps only): %f", obj->GetTerrain()->GetHeightStatic(obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ(), false));
@@ -0,0 +1,192 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "GridPreloader.h"
+#include "GridMap.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+/**
+ * @brief A request to prepare the terrain of one grid.
+ */
+class GridPreloadRequest : public ACE_Method_Request
+{
+    private:
+        GridPreloader& m_preloader; ///< Reference to the requesting preloader.
+        uint32 m_gx; ///< Terrain grid x coordinate.
+        uint32 m_gy; ///< Terrain grid y coordinate.
+
+    public:
+        /**
+         * @brief Constructor for GridPreloadRequest.
+         * @param p Reference to the preloader.
+         * @param gx Terrain grid x coordinate.
+         * @param gy Terrain grid y coordinate.
+         */
+        GridPreloadRequest(GridPreloader& p, uint32 gx, uint32 gy)
+            : m_preloader(p), m_gx(gx), m_gy(gy)
+        {
+        }
+
+        /**
+         * @brief Executes the preload request.
+         * @return Always returns 0.
+         */
+        virtual int call()
+        {
+            GridMap* map = m_preloader.prepare(m_gx, m_gy);
+            m_preloader.preload_finished(GridPreloader::PreparedGrid(m_gx, m_gy, map));
+            return 0;
+        }
+};
+
+/**
+ * @brief Constructor for GridPreloader.
+ * @param terrain Terrain data of the owning map.
+ */
+GridPreloader::GridPreloader(TerrainInfo* terrain):
+m_terrain(terrain), m_mutex(), m_condition(m_mutex), pending_requests(0)
+{
+}
+
+/**
+ * @brief Destructor for GridPreloader.
+ */
+GridPreloader::~GridPreloader()
+{
+    wait();
+}
+
+/**
+ * @brief Returns the worker pool shared by all preloaders.
+ * @return Reference to the executor.
+ */
+DelayExecutor& GridPreloader::executor()
+{
+    static DelayExecutor s_executor;
+    return s_executor;
+}
+
+int GridPreloader::activate(size_t num_threads)
+{
+    return executor()._activate((int)num_threads);
+}
+
+int GridPreloader::deactivate()
+{
+    return executor().deactivate();
+}
+
+bool GridPreloader::activated()
+{
+    return executor().activated();
+}
+
+/**
+ * @brief Waits for all pending requests to be processed.
+ * @return Always returns 0.
+ */
+int GridPreloader::wait()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+    while (pending_requests > 0)
+        m_condition.wait();
+
+    return 0;
+}
+
+/**
+ * @brief Schedules terrain preparation of a grid.
+ * @param gx Terrain grid x coordinate.
+ * @param gy Terrain grid y coordinate.
+ * @return True if the request was queued.
+ */
+bool GridPreloader::schedule_preload(uint32 gx, uint32 gy)
+{
+    if (!activated())
+    {
+        return false;
+    }
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, false);
+
+    ++pending_requests;
+
+    if (executor().execute(new GridPreloadRequest(*this, gx, gy)) == -1)
+    {
+        sLog.outError("GridPreloader: failed to schedule preload of grid [%u,%u] for map %u", gx, gy, m_terrain->GetMapId());
+
+        --pending_requests;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Moves the grids prepared since the last call into the given list.
+ * @param ready Receives the prepared grids.
+ */
+void GridPreloader::take_prepared(PreparedGrids& ready)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    ready.swap(m_prepared);
+    m_prepared.clear();
+}
+
+/**
+ * @brief Reads the map file of a grid, runs on a worker thread.
+ * @param gx Terrain grid x coordinate.
+ * @param gy Terrain grid y coordinate.
+ * @return The loaded terrain.
+ */
+GridMap* GridPreloader::prepare(uint32 gx, uint32 gy)
+{
+    return m_terrain->LoadGridMapFile(gx, gy);
+}
+
+/**
+ * @brief Called by a worker when the terrain of a grid is prepared.
+ * @param grid The prepared grid.
+ */
+void GridPreloader::preload_finished(PreparedGrid const& grid)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    if (pending_requests == 0)
+    {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("GridPreloader::preload_finished BUG, report to devs")));
+        delete grid.map;                                    // nobody takes it over
+        return;
+    }
+
+    --pending_requests;
+    m_prepared.push_back(grid);
+
+    m_condition.broadcast();
+}
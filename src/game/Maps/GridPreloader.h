@@ -0,0 +1,140 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef _GRID_PRELOADER_H_INCLUDED
+#define _GRID_PRELOADER_H_INCLUDED
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Common.h"
+#include "DelayExecutor.h"
+
+#include <vector>
+
+class TerrainInfo;
+class GridMap;
+
+/**
+ * @brief Reads terrain of grids on background threads.
+ *
+ * Every map owns one preloader. The map requests grids it expects to need soon and
+ * collects the prepared ones at a safe point of its update, where the GridMap is handed
+ * over to TerrainInfo and vmaps and mmaps are loaded. Vmap and mmap trees are shared with
+ * the map thread queries, so they are never touched from the workers. All preloaders share
+ * one pool of worker threads.
+ */
+class GridPreloader
+{
+    public:
+        /**
+         * @brief A grid whose map file was read in background.
+         */
+        struct PreparedGrid
+        {
+            PreparedGrid(uint32 x, uint32 y, GridMap* m) : gx(x), gy(y), map(m) {}
+
+            uint32 gx; ///< Terrain grid x coordinate.
+            uint32 gy; ///< Terrain grid y coordinate.
+            GridMap* map; ///< Loaded terrain, owned by the receiver of take_prepared.
+        };
+        typedef std::vector<PreparedGrid> PreparedGrids;
+
+        /**
+         * @brief Constructor for GridPreloader.
+         * @param terrain Terrain data of the owning map.
+         */
+        explicit GridPreloader(TerrainInfo* terrain);
+
+        /**
+         * @brief Destructor for GridPreloader, waits for the pending requests.
+         */
+        ~GridPreloader();
+
+        friend class GridPreloadRequest;
+
+        /**
+         * @brief Schedules terrain preparation of a grid.
+         * @param gx Terrain grid x coordinate.
+         * @param gy Terrain grid y coordinate.
+         * @return True if the request was queued.
+         */
+        bool schedule_preload(uint32 gx, uint32 gy);
+
+        /**
+         * @brief Moves the grids prepared since the last call into the given list.
+         * @param ready Receives the prepared grids.
+         */
+        void take_prepared(PreparedGrids& ready);
+
+        /**
+         * @brief Waits for all pending requests to be processed.
+         * @return Always returns 0.
+         */
+        int wait();
+
+        /**
+         * @brief Starts the shared worker threads.
+         * @param num_threads Number of threads to activate.
+         * @return Result of the activation.
+         */
+        static int activate(size_t num_threads);
+
+        /**
+         * @brief Stops the shared worker threads.
+         * @return Result of the deactivation.
+         */
+        static int deactivate();
+
+        /**
+         * @brief Checks if the worker threads are running.
+         * @return True if activated, false otherwise.
+         */
+        static bool activated();
+
+    private:
+        static DelayExecutor& executor();
+
+        /**
+         * @brief Reads the map file of a grid, runs on a worker thread.
+         * @param gx Terrain grid x coordinate.
+         * @param gy Terrain grid y coordinate.
+         * @return The loaded terrain.
+         */
+        GridMap* prepare(uint32 gx, uint32 gy);
+
+        /**
+         * @brief Called by a worker when the terrain of a grid is prepared.
+         * @param grid The prepared grid.
+         */
+        void preload_finished(PreparedGrid const& grid);
+
+        TerrainInfo* m_terrain; ///< Terrain data the grids are prepared for.
+        ACE_Thread_Mutex m_mutex; ///< Mutex for the pending counter and the prepared list.
+        ACE_Condition_Thread_Mutex m_condition; ///< Condition variable for signaling when requests are processed.
+        size_t pending_requests; ///< Number of queued preload requests.
+        PreparedGrids m_prepared; ///< Grids prepared but not yet taken by the map.
+};
+
+#endif //_GRID_PRELOADER_H_INCLUDED
@@ -29,6 +29,7 @@
 #include "CreatureAI.h"
 #include "WaypointManager.h"
 #include "ScriptMgr.h"
+#include "PathFinder.h"
 #include "movement/MoveSplineInit.h"
 #include "movement/MoveSpline.h"
 
@@ -81,6 +82,7 @@ void WaypointMovementGenerator<Creature>::LoadPath(Creature& creature, int32 pat
     }
     // Initialize the i_currentNode to point to the first node
     i_currentNode = i_path->begin()->first;
+    m_currentIndex = 0;
     m_lastReachedWaypoint = 0;
 }
 
@@ -162,9 +164,10 @@ void WaypointMovementGenerator<Creature>::OnArrived(Creature& creature)
     creature.clearUnitState(UNIT_STAT_ROAMING_MOVE);
     m_isArrivalDone = true;
 
-    WaypointPath::const_iterator currPoint = i_path->find(i_currentNode);
-    MANGOS_ASSERT(currPoint != i_path->end());
-    WaypointNode const& node = currPoint->second;
+    WaypointRoute const& route = *i_path->GetRoute();
+    uint32 index = GetCurrentIndex(route);
+    MANGOS_ASSERT(index < route.size());
+    WaypointNode const& node = route[index].node;
 
     if (node.script_id)
     {
@@ -256,10 +259,11 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature& creature)
         return;
     }
 
-    WaypointPath::const_iterator currPoint = i_path->find(i_currentNode);
-    MANGOS_ASSERT(currPoint != i_path->end());
+    WaypointRoute const& route = *i_path->GetRoute();
+    uint32 index = GetCurrentIndex(route);
+    MANGOS_ASSERT(index < route.size());
 
-    if (WaypointBehavior* behavior = currPoint->second.behavior)
+    if (WaypointBehavior* behavior = route[index].node.behavior)
     {
         if (behavior->model2 != 0)
         {
@@ -268,14 +272,14 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature& creature)
         creature.SetUInt32Value(UNIT_NPC_EMOTESTATE, 0);
     }
 
+    bool fromPreviousPoint = m_isArrivalDone;
     if (m_isArrivalDone)
     {
         bool reachedLast = false;
-        ++currPoint;
-        if (currPoint == i_path->end())
+        if (++index == route.size())
         {
             reachedLast = true;
-            currPoint = i_path->begin();
+            index = 0;
         }
 
         // Inform AI
@@ -283,11 +287,11 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature& creature)
         {
             if (!reachedLast)
             {
-                creature.AI()->MovementInform(EXTERNAL_WAYPOINT_MOVE_START + m_pathId, currPoint->first);
+                creature.AI()->MovementInform(EXTERNAL_WAYPOINT_MOVE_START + m_pathId, route[index].pointId);
             }
             else
             {
-                creature.AI()->MovementInform(EXTERNAL_WAYPOINT_FINISHED_LAST + m_pathId, currPoint->first);
+                creature.AI()->MovementInform(EXTERNAL_WAYPOINT_FINISHED_LAST + m_pathId, route[index].pointId);
             }
 
             if (creature.IsDead() || !creature.IsInWorld()) // Might have happened with above calls
@@ -296,16 +300,18 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature& creature)
             }
         }
 
-        i_currentNode = currPoint->first;
+        i_currentNode = route[index].pointId;
+        m_currentIndex = index;
     }
 
     m_isArrivalDone = false;
 
     creature.addUnitState(UNIT_STAT_ROAMING_MOVE);
 
-    WaypointNode const& nextNode = currPoint->second;;
+    WaypointNode const& nextNode = route[index].node;
     Movement::MoveSplineInit init(creature);
-    init.MoveTo(nextNode.x, nextNode.y, nextNode.z, true);
+    // keeps the shared segment lengths alive until Launch
+    WaypointSegmentPathPtr segment = MoveToPoint(creature, init, route, index, fromPreviousPoint);
 
     if (nextNode.orientation != 100 && nextNode.delay != 0)
     {
@@ -315,6 +321,113 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature& creature)
     init.Launch();
 }
 
+/**
+ * @brief Gets the route index of the current node.
+ * The stored index is only looked up again when the path was changed meanwhile.
+ * @param route The route of the current path.
+ * @return The index of i_currentNode, route.size() if the path has no such point anymore.
+ */
+uint32 WaypointMovementGenerator<Creature>::GetCurrentIndex(WaypointRoute const& route)
+{
+    if (m_currentIndex >= route.size() || route[m_currentIndex].pointId != i_currentNode)
+    {
+        m_currentIndex = route.Find(i_currentNode);
+    }
+
+    return m_currentIndex;
+}
+
+/**
+ * @brief Stores the movement state that shapes a segment path: the navmesh filter and the height adjustment of its points.
+ * @param segment The segment path to fill.
+ * @param creature Reference to the creature the path is built for.
+ */
+static void SetMovementFlags(WaypointSegmentPath& segment, Creature const& creature)
+{
+    segment.canWalk = creature.CanWalk();
+    segment.canSwim = creature.CanSwim();
+    segment.canFly = creature.CanFly();
+    segment.levitating = creature.IsLevitating();
+    segment.waterWalking = creature.HasAuraType(SPELL_AURA_WATER_WALK);
+}
+
+/**
+ * @brief Checks if a segment path was built for the movement state the creature has now.
+ * @param segment The segment path to check.
+ * @param creature Reference to the creature.
+ * @return bool True if the path can be reused by the creature, false otherwise.
+ */
+static bool HasSameMovementFlags(WaypointSegmentPath const& segment, Creature const& creature)
+{
+    return segment.canWalk == creature.CanWalk() && segment.canSwim == creature.CanSwim() &&
+           segment.canFly == creature.CanFly() && segment.levitating == creature.IsLevitating() &&
+           segment.waterWalking == creature.HasAuraType(SPELL_AURA_WATER_WALK);
+}
+
+/**
+ * @brief Sets up the spline to a point of the route.
+ * Creatures leaving from where an earlier creature left reuse its spline path and segment lengths,
+ * the first one to walk a segment from the previous point leaves its path in the route.
+ * @param creature Reference to the creature.
+ * @param init The spline to set up.
+ * @param route The route of the current path.
+ * @param index Index of the point to move to.
+ * @param fromPreviousPoint Whether the creature has just arrived at the previous point.
+ * @return The reused segment path, init refers to its lengths until Launch.
+ */
+WaypointSegmentPathPtr WaypointMovementGenerator<Creature>::MoveToPoint(Creature& creature, Movement::MoveSplineInit& init, WaypointRoute const& route, uint32 index, bool fromPreviousPoint)
+{
+    WaypointNode const& node = route[index].node;
+
+    // a spline still running would be continued from its current position instead
+    if (!creature.movespline->Finalized())
+    {
+        init.MoveTo(node.x, node.y, node.z, true);
+        return WaypointSegmentPathPtr();
+    }
+
+    bool smooth = init.IsSmooth();
+    WaypointSegmentPathPtr segment = route.GetSegment(index);
+    if (segment)
+    {
+        Vector3 start(creature.GetPositionX(), creature.GetPositionY(), creature.GetPositionZ());
+        if (segment->mapId == creature.GetMapId() && segment->smooth == smooth && HasSameMovementFlags(*segment, creature) &&
+            (segment->points[0] - start).squaredLength() < 0.01f)
+        {
+            init.MovebyPath(segment->points);
+            init.SetSegmentLengths(segment->lengths);
+            return segment;
+        }
+
+        init.MoveTo(node.x, node.y, node.z, true);
+        return WaypointSegmentPathPtr();
+    }
+
+    PathFinder path(&creature);
+    path.calculate(node.x, node.y, node.z);
+    if (path.getPathType() & PATHFIND_NOPATH)
+    {
+        init.MoveTo(node.x, node.y, node.z);
+        return WaypointSegmentPathPtr();
+    }
+
+    init.MovebyPath(path.getPath());
+
+    // only a full navmesh path is the same for the next creature, a shortcut may be taken for an unloaded tile
+    if (fromPreviousPoint && path.getPathType() == PATHFIND_NORMAL)
+    {
+        WaypointSegmentPath* newSegment = new WaypointSegmentPath;
+        newSegment->mapId = creature.GetMapId();
+        newSegment->smooth = smooth;
+        SetMovementFlags(*newSegment, creature);
+        newSegment->points = path.getPath();
+        Movement::MoveSpline::MeasureSegments(newSegment->points, smooth, newSegment->lengths);
+        route.SetSegment(index, WaypointSegmentPathPtr(newSegment));
+    }
+
+    return WaypointSegmentPathPtr();
+}
+
 /**
  * @brief Updates the WaypointMovementGenerator.
  * @param creature Reference to the creature.
@@ -403,16 +516,17 @@ bool WaypointMovementGenerator<Creature>::GetResetPosition(Creature&, float& x,
         return false;
     }
 
-    WaypointPath::const_iterator lastPoint = i_path->find(m_lastReachedWaypoint);
+    WaypointRoute const& route = *i_path->GetRoute();
+    uint32 lastIndex = route.Find(m_lastReachedWaypoint);
     // Special case: Before the first waypoint is reached, m_lastReachedWaypoint is set to 0 (which may not be contained in i_path)
-    if (!m_lastReachedWaypoint && lastPoint == i_path->end())
+    if (!m_lastReachedWaypoint && lastIndex == route.size())
     {
         return false;
     }
 
-    MANGOS_ASSERT(lastPoint != i_path->end());
+    MANGOS_ASSERT(lastIndex < route.size());
 
-    WaypointNode const* curWP = &(lastPoint->second);
+    WaypointNode const* curWP = &route[lastIndex].node;
 
     x = curWP->x;
     y = curWP->y;
@@ -424,16 +538,8 @@ bool WaypointMovementGenerator<Creature>::GetResetPosition(Creature&, float& x,
     }
     else                                                    // Calculate the resulting angle based on positions between previous and current waypoint
     {
-        WaypointNode const* prevWP;
-        if (lastPoint != i_path->begin())                   // Not the first waypoint
-        {
-            --lastPoint;
-            prevWP = &(lastPoint->second);
-        }
-        else                                                // Take the last waypoint (crbegin()) as previous
-        {
-            prevWP = &(i_path->rbegin()->second);
-        }
+        // Take the last waypoint as previous of the first one
+        WaypointNode const* prevWP = &route[lastIndex ? lastIndex - 1 : route.size() - 1].node;
 
         float dx = x - prevWP->x;
         float dy = y - prevWP->y;
@@ -481,8 +587,9 @@ bool WaypointMovementGenerator<Creature>::SetNextWaypoint(uint32 pointId)
         return false;
     }
 
-    WaypointPath::const_iterator currPoint = i_path->find(pointId);
-    if (currPoint == i_path->end())
+    WaypointRoute const& route = *i_path->GetRoute();
+    uint32 index = route.Find(pointId);
+    if (index == route.size())
     {
         return false;
     }
@@ -495,6 +602,7 @@ bool WaypointMovementGenerator<Creature>::SetNextWaypoint(uint32 pointId)
 
     // Set the point
     i_currentNode = pointId;
+    m_currentIndex = index;
     return true;
 }
 
@@ -34,12 +34,36 @@
 #include "MovementGenerator.h"
 #include "WaypointManager.h"
 #include "DBCStructure.h"
+#include "movement/MoveSplineInitArgs.h"
 
 #include <set>
 
 #define FLIGHT_TRAVEL_UPDATE  100
 #define STOP_TIME_FOR_PLAYER  (3 * MINUTE * IN_MILLISECONDS)// 3 Minutes
 
+namespace Movement
+{
+    class MoveSplineInit;
+}
+
+/**
+ * @brief Spline path between two points of a waypoint route, as found for the first
+ * creature that walked it, with the lengths of its spline segments.
+ * Only reused by creatures that would get the same path from the navmesh.
+ */
+struct WaypointSegmentPath
+{
+    uint32 mapId; ///< Map the path was searched on.
+    bool smooth; ///< CatmullRom spline (flying).
+    bool canWalk; ///< Navmesh filter of the creature.
+    bool canSwim; ///< Navmesh filter of the creature.
+    bool canFly; ///< Height adjustment of the path points.
+    bool levitating; ///< Height adjustment of the path points.
+    bool waterWalking; ///< Height adjustment of the path points.
+    Movement::PointsArray points; ///< Spline points, the first one is the start position.
+    std::vector<float> lengths; ///< Segment lengths, see Movement::MoveSpline::MeasureSegments.
+};
+
 /**
  * @brief Base class for path movement generators.
  * @tparam T Type of the unit (Player or Creature).
@@ -75,7 +99,7 @@ class WaypointMovementGenerator<Creature>
       public PathMovementBase<Creature, WaypointPath const*>
 {
     public:
-        WaypointMovementGenerator(Creature&) : i_nextMoveTime(0), m_isArrivalDone(false), m_lastReachedWaypoint(0), m_pathId(0) {}
+        WaypointMovementGenerator(Creature&) : i_nextMoveTime(0), m_isArrivalDone(false), m_lastReachedWaypoint(0), m_currentIndex(0), m_pathId(0) {}
         ~WaypointMovementGenerator() { i_path = NULL; }
 
         void Initialize(Creature& u);
@@ -105,9 +129,13 @@ class WaypointMovementGenerator<Creature>
         void OnArrived(Creature&);
         void StartMove(Creature&);
 
+        uint32 GetCurrentIndex(WaypointRoute const& route);
+        WaypointSegmentPathPtr MoveToPoint(Creature& creature, Movement::MoveSplineInit& init, WaypointRoute const& route, uint32 index, bool fromPreviousPoint);
+
         TimeTracker i_nextMoveTime; ///< Time tracker for the next move.
         bool m_isArrivalDone; ///< Indicates if the arrival is done.
         uint32 m_lastReachedWaypoint; ///< Last reached waypoint.
+        uint32 m_currentIndex; ///< Index of i_currentNode in the route, checked against the point id before use.
 
         int32 m_pathId; ///< Path ID.
         WaypointPathOrigin m_PathOrigin; ///< Path origin.
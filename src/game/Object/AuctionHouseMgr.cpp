@@ -590,10 +590,11 @@ void AuctionHouseObject::Update()
             {
                 sAuctionMgr.SendAuctionExpiredMail(old->second);
 
-                old->second->DeleteFromDB();
-                sAuctionMgr.RemoveAItem(old->second->itemGuidLow);
-                delete old->second;
-                AuctionsMap.erase(old);
+                AuctionEntry* auction = old->second;
+                auction->DeleteFromDB();
+                sAuctionMgr.RemoveAItem(auction->itemGuidLow);
+                RemoveAuction(auction->Id);
+                delete auction;
                 continue;
             }
         }
@@ -632,82 +633,290 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-        std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
-        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-        uint32& count, uint32& totalcount)
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
+    MANGOS_ASSERT(ah);
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionEntryMap::iterator itr = AuctionsMap.find(ah->Id);
+    if (itr != AuctionsMap.end())
     {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
+        UnindexAuction(itr->second);
+    }
+
+    AuctionsMap[ah->Id] = ah;
+    IndexAuction(ah);
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+    {
+        return false;
+    }
+
+    UnindexAuction(itr->second);
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::IndexAuction(AuctionEntry* auction)
+{
+    AuctionIdSet& auctions = m_auctionsByTemplate[auction->itemTemplate];
+    if (auctions.empty())
+    {
+        if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate))
         {
-            continue;
+            m_templatesByClass[proto->Class].insert(auction->itemTemplate);
         }
+    }
 
-        {
-            ItemPrototype const* proto = item->GetProto();
+    auctions.insert(auction->Id);
+    UpdateSearchCache(auction, true);
+}
 
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-            {
-                continue;
-            }
+void AuctionHouseObject::UnindexAuction(AuctionEntry* auction)
+{
+    AuctionsByTemplateMap::iterator itr = m_auctionsByTemplate.find(auction->itemTemplate);
+    if (itr == m_auctionsByTemplate.end())
+    {
+        return;
+    }
 
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
+    itr->second.erase(auction->Id);
+    if (itr->second.empty())
+    {
+        m_auctionsByTemplate.erase(itr);
+        if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate))
+        {
+            TemplatesByClassMap::iterator classItr = m_templatesByClass.find(proto->Class);
+            if (classItr != m_templatesByClass.end())
             {
-                continue;
+                classItr->second.erase(auction->itemTemplate);
+                if (classItr->second.empty())
+                {
+                    m_templatesByClass.erase(classItr);
+                }
             }
+        }
+    }
 
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            {
-                continue;
-            }
+    UpdateSearchCache(auction, false);
+}
+
+/**
+ * Adds the auction to, or removes it from, the cached searches it matches. Only searches
+ * over the item class and subclass of the auction are looked at, all others stay as they are.
+ */
+void AuctionHouseObject::UpdateSearchCache(AuctionEntry* auction, bool added)
+{
+    if (m_searchCache.empty())
+    {
+        return;
+    }
+
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+    {
+        return;
+    }
+
+    for (SearchCacheMap::iterator itr = m_searchCache.begin(); itr != m_searchCache.end(); ++itr)
+    {
+        SearchFilter const& filter = itr->first;
+        if ((filter.itemClass != 0xffffffff && proto->Class != filter.itemClass) ||
+            (filter.itemSubClass != 0xffffffff && proto->SubClass != filter.itemSubClass))
+        {
+            continue;
+        }
+
+        std::vector<uint32>& auctions = itr->second.auctions;
+        std::vector<uint32>::iterator pos = std::lower_bound(auctions.begin(), auctions.end(), auction->Id);
+        bool listed = pos != auctions.end() && *pos == auction->Id;
+
+        if (!added && listed)
+        {
+            auctions.erase(pos);
+        }
+        else if (added && !listed && IsTemplateMatching(auction->itemTemplate, filter))
+        {
+            auctions.insert(pos, auction->Id);              // new ids are the highest, so this appends
+        }
+    }
+}
+
+bool AuctionHouseObject::IsTemplateMatching(uint32 itemTemplate, SearchFilter const& filter) const
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itemTemplate);
+    if (!proto)
+    {
+        return false;
+    }
 
-            if (quality != 0xffffffff && proto->Quality < quality)
+    if (filter.itemClass != 0xffffffff && proto->Class != filter.itemClass)
+    {
+        return false;
+    }
+
+    if (filter.itemSubClass != 0xffffffff && proto->SubClass != filter.itemSubClass)
+    {
+        return false;
+    }
+
+    if (filter.inventoryType != 0xffffffff && proto->InventoryType != filter.inventoryType)
+    {
+        return false;
+    }
+
+    if (filter.quality != 0xffffffff && proto->Quality < filter.quality)
+    {
+        return false;
+    }
+
+    if (filter.levelmin != 0x00 && (proto->RequiredLevel < filter.levelmin || (filter.levelmax != 0x00 && proto->RequiredLevel > filter.levelmax)))
+    {
+        return false;
+    }
+
+    if (!filter.name.empty())
+    {
+        std::string name = proto->Name1;
+        sObjectMgr.GetItemLocaleStrings(proto->ItemId, filter.locale, &name);
+
+        if (!Utf8FitTo(name, filter.name))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Returns the auctions passing all item template based filters. The filters are checked once
+ * per item entry instead of once per auction, and the result is kept up to date as auctions are
+ * added or removed, so paging through a search or repeating it does not look at the auctions again.
+ */
+std::vector<uint32> const& AuctionHouseObject::GetSearchCandidates(SearchFilter const& filter)
+{
+    ++m_searchCacheUses;
+
+    SearchCacheMap::iterator cached = m_searchCache.find(filter);
+    if (cached != m_searchCache.end())
+    {
+        cached->second.lastUse = m_searchCacheUses;
+        return cached->second.auctions;
+    }
+
+    // keep the cache small, it is rebuilt from the index cheaply
+    if (m_searchCache.size() >= 64)
+    {
+        SearchCacheMap::iterator oldest = m_searchCache.begin();
+        for (SearchCacheMap::iterator itr = m_searchCache.begin(); itr != m_searchCache.end(); ++itr)
+        {
+            if (itr->second.lastUse < oldest->second.lastUse)
             {
-                continue;
+                oldest = itr;
             }
+        }
+        m_searchCache.erase(oldest);
+    }
+
+    SearchCacheEntry& entry = m_searchCache[filter];
+    entry.lastUse = m_searchCacheUses;
+    std::vector<uint32>& candidates = entry.auctions;
+
+    std::vector<uint32> templates;
+    if (filter.itemClass != 0xffffffff)
+    {
+        TemplatesByClassMap::const_iterator classItr = m_templatesByClass.find(filter.itemClass);
+        if (classItr != m_templatesByClass.end())
+        {
+            templates.assign(classItr->second.begin(), classItr->second.end());
+        }
+    }
+    else
+    {
+        templates.reserve(m_auctionsByTemplate.size());
+        for (AuctionsByTemplateMap::const_iterator itr = m_auctionsByTemplate.begin(); itr != m_auctionsByTemplate.end(); ++itr)
+        {
+            templates.push_back(itr->first);
+        }
+    }
 
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+    for (std::vector<uint32>::const_iterator tItr = templates.begin(); tItr != templates.end(); ++tItr)
+    {
+        if (!IsTemplateMatching(*tItr, filter))
+        {
+            continue;
+        }
+
+        AuctionIdSet const& auctions = m_auctionsByTemplate[*tItr];
+        candidates.insert(candidates.end(), auctions.begin(), auctions.end());
+    }
+
+    // list in auction id order, as the search over all auctions did
+    std::sort(candidates.begin(), candidates.end());
+
+    return candidates;
+}
+
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
+        std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
+        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+        uint32& count, uint32& totalcount)
+{
+    SearchFilter filter;
+    filter.name = wsearchedname;
+    filter.locale = player->GetSession()->GetSessionDbLocaleIndex();
+    filter.levelmin = levelmin;
+    filter.levelmax = levelmax;
+    filter.inventoryType = inventoryType;
+    filter.itemClass = itemClass;
+    filter.itemSubClass = itemSubClass;
+    filter.quality = quality;
+
+    std::vector<uint32> const& candidates = GetSearchCandidates(filter);
+
+    for (std::vector<uint32>::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+    {
+        AuctionEntry* Aentry = GetAuction(*itr);
+        if (!Aentry)
+        {
+            continue;
+        }
+
+        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
+        if (!item)
+        {
+            continue;
+        }
+
+        // usability depends on the player, so it is not part of the cached result
+        if (usable != 0x00)
+        {
+            if (player->CanUseItem(item) != EQUIP_ERR_OK)
             {
                 continue;
             }
 
-            if (usable != 0x00)
+            ItemPrototype const* proto = item->GetProto();
+            if (proto->Class == ITEM_CLASS_RECIPE)
             {
-                if (player->CanUseItem(item) != EQUIP_ERR_OK)
-                {
-                    continue;
-                }
-
-                if (proto->Class == ITEM_CLASS_RECIPE)
+                if (SpellEntry const* spell = sSpellStore.LookupEntry(proto->Spells[0].SpellId))
                 {
-                    if (SpellEntry const* spell = sSpellStore.LookupEntry(proto->Spells[0].SpellId))
+                    if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
                     {
-                        if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
-                        {
-                            continue;
-                        }
+                        continue;
                     }
                 }
             }
+        }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-            {
-                continue;
-            }
-
-            if (count < 50 && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
+        if (count < 50 && totalcount >= listfrom)
+        {
+            ++count;
+            Aentry->BuildAuctionInfo(data);
         }
 
         ++totalcount;
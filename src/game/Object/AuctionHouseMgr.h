@@ -42,6 +42,8 @@
 #include "Policies/Singleton.h"
 #include "DBCStructure.h"
 
+#include <tuple>
+
 /** \addtogroup auctionhouse
  * @{
  * \file
@@ -110,7 +112,7 @@ struct AuctionEntry
 class AuctionHouseObject
 {
     public:
-        AuctionHouseObject() {}
+        AuctionHouseObject() : m_searchCacheUses(0) {}
         ~AuctionHouseObject()
         {
             for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -127,11 +129,7 @@ class AuctionHouseObject
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -139,10 +137,7 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : NULL;
         }
 
-        bool RemoveAuction(uint32 id)
-        {
-            return AuctionsMap.erase(id);
-        }
+        bool RemoveAuction(uint32 id);
 
         void Update();
 
@@ -155,7 +150,44 @@ class AuctionHouseObject
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = NULL);
         AuctionEntry* AddAuctionByGuid(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout, uint32 lowguid);
     private:
+        // Browse filters that only depend on the item template, used as search cache key
+        struct SearchFilter
+        {
+            std::wstring name;
+            int locale;
+            uint32 levelmin, levelmax;
+            uint32 inventoryType, itemClass, itemSubClass, quality;
+
+            bool operator<(SearchFilter const& other) const
+            {
+                return std::tie(name, locale, levelmin, levelmax, inventoryType, itemClass, itemSubClass, quality) <
+                       std::tie(other.name, other.locale, other.levelmin, other.levelmax, other.inventoryType, other.itemClass, other.itemSubClass, other.quality);
+            }
+        };
+
+        typedef std::set<uint32> AuctionIdSet;
+        typedef std::map<uint32 /*item template*/, AuctionIdSet> AuctionsByTemplateMap;
+        typedef std::map<uint32 /*item class*/, std::set<uint32 /*item template*/> > TemplatesByClassMap;
+        // matching auctions of a browse filter, sorted by auction id
+        struct SearchCacheEntry
+        {
+            std::vector<uint32> auctions;
+            uint32 lastUse;                                 // m_searchCacheUses at the last search, the least recent is dropped first
+        };
+        typedef std::map<SearchFilter, SearchCacheEntry> SearchCacheMap;
+
+        void IndexAuction(AuctionEntry* auction);
+        void UnindexAuction(AuctionEntry* auction);
+        void UpdateSearchCache(AuctionEntry* auction, bool added);
+        bool IsTemplateMatching(uint32 itemTemplate, SearchFilter const& filter) const;
+        std::vector<uint32> const& GetSearchCandidates(SearchFilter const& filter);
+
         AuctionEntryMap AuctionsMap;
+
+        AuctionsByTemplateMap m_auctionsByTemplate;         // all auctions grouped by item entry
+        TemplatesByClassMap m_templatesByClass;             // item entries with auctions, by item class
+        SearchCacheMap m_searchCache;                       // matching auctions per browse filter, kept up to date on add/remove
+        uint32 m_searchCacheUses;
 };
 
 /**
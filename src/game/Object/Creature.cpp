@@ -152,7 +152,7 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     lootForPickPocketed(false), lootForBody(false), lootForSkin(false),
     m_groupLootTimer(0), m_groupLootId(0),
     m_lootMoney(0), m_lootGroupRecipientId(0),
-    m_corpseRemoveTime(0), m_respawnTime(0), m_respawnDelay(25), m_corpseDelay(60), m_aggroDelay(0), m_respawnradius(5.0f),
+    m_corpseRemoveTime(0), m_respawnTime(0), m_respawnDelay(25), m_corpseDelay(60), m_aggroDelay(0), m_skippedUpdateTime(0), m_respawnradius(5.0f),
     m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE), m_equipmentId(0),
     m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false),
     m_AI_locked(false), m_IsDeadByDefault(false), m_temporaryFactionFlags(TEMPFACTION_NONE),
@@ -1618,14 +1618,17 @@ bool Creature::CreateFromProto(uint32 guidlow, CreatureInfo const* cinfo, Team t
 bool Creature::LoadFromDB(uint32 guidlow, Map* map)
 {
     CreatureData const* data = sObjectMgr.GetCreatureData(guidlow);
+    return LoadFromDB(guidlow, map, data, data ? ObjectMgr::GetCreatureTemplate(data->id) : NULL);
+}
 
+bool Creature::LoadFromDB(uint32 guidlow, Map* map, CreatureData const* data, CreatureInfo const* cinfo)
+{
     if (!data)
     {
         sLog.outErrorDb("Creature (GUID: %u) not found in table `creature`, can't load. ", guidlow);
         return false;
     }
 
-    CreatureInfo const* cinfo = ObjectMgr::GetCreatureTemplate(data->id);
     if (!cinfo)
     {
         sLog.outErrorDb("Creature (Entry: %u) not found in table `creature_template`, can't load. ", data->id);
@@ -2710,6 +2713,17 @@ bool Creature::IsInEvadeMode() const
     return !i_motionMaster.empty() && i_motionMaster.GetCurrentMovementGeneratorType() == HOME_MOTION_TYPE;
 }
 
+bool Creature::CanUpdateAtReducedRate() const
+{
+    // fights, owned creatures and creatures kept active by scripts or viewers stay at full rate
+    if (IsInCombat() || IsInEvadeMode() || IsActiveObject() || !GetCharmerOrOwnerGuid().IsEmpty())
+    {
+        return false;
+    }
+
+    return !IsNonMeleeSpellCasted(false);
+}
+
 bool Creature::HasSpell(uint32 spellID) const
 {
     uint8 i;
@@ -590,6 +590,12 @@ class Creature : public Unit
 
         bool IsInEvadeMode() const;
 
+        // Update level of detail: creatures far from all players may skip map updates, the skipped time is added to the next one
+        bool CanUpdateAtReducedRate() const;
+        uint32 GetSkippedUpdateTime() const { return m_skippedUpdateTime; }
+        void SkipUpdate(uint32 diff) { m_skippedUpdateTime += diff; }
+        uint32 TakeSkippedUpdateTime() { uint32 skipped = m_skippedUpdateTime; m_skippedUpdateTime = 0; return skipped; }
+
         bool AIM_Initialize();
 
         CreatureAI* AI() { return i_AI; }
@@ -660,6 +666,7 @@ class Creature : public Unit
         void SetDeathState(DeathState s) override;          // overwrite virtual Unit::SetDeathState
 
         bool LoadFromDB(uint32 guid, Map* map);
+        bool LoadFromDB(uint32 guid, Map* map, CreatureData const* data, CreatureInfo const* cinfo); // data already looked up
         virtual void SaveToDB();
         // overwrited in Pet
         virtual void SaveToDB(uint32 mapid);
@@ -862,6 +869,7 @@ class Creature : public Unit
         uint32 m_respawnDelay;                              // (secs) delay between corpse disappearance and respawning
         uint32 m_corpseDelay;                               // (secs) delay between death and corpse disappearance
         uint32 m_aggroDelay;                                // (msecs)delay between respawn and aggro due to movement
+        uint32 m_skippedUpdateTime;                         // (msecs)map updates skipped since the last one, see CanUpdateAtReducedRate
         float m_respawnradius;
 
         time_t m_killedTime;                                // Exact time of the death.
@@ -80,20 +80,22 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
     {
         if (itr->Event.action[2].type != ACTION_T_NONE)
         {
-            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1, itr->Event.action[2].type, itr->Event.action[2].raw.param1);
+            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", GetRemainingTime(*itr) / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1, itr->Event.action[2].type, itr->Event.action[2].raw.param1);
         }
         else if (itr->Event.action[1].type != ACTION_T_NONE)
         {
-            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1);
+            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", GetRemainingTime(*itr) / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1);
         }
         else
         {
-            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) action[type(param1)]:  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1);
+            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) action[type(param1)]:  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", GetRemainingTime(*itr) / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1);
         }
     }
 }
 
 CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
+    m_EventClock(0),
+    m_TimerPhase(0),
     m_Phase(0),
     m_MeleeEnabled(true),
     m_currSpell(0),
@@ -153,6 +155,32 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
     {
         sLog.outErrorEventAI("EventMap for Creature %u is empty but creature is using CreatureEventAI.", m_creature->GetEntry());
     }
+
+    // Group the events by type, so that every hook only walks its own events
+    memset(m_EventTypeOffsets, 0, sizeof(m_EventTypeOffsets));
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    {
+        if (i->Event.event_type < EVENT_T_END)
+        {
+            ++m_EventTypeOffsets[i->Event.event_type + 1];
+        }
+    }
+    for (uint32 type = 0; type < EVENT_T_END; ++type)
+    {
+        m_EventTypeOffsets[type + 1] += m_EventTypeOffsets[type];
+    }
+
+    m_EventsByType.resize(m_EventTypeOffsets[EVENT_T_END]);
+    std::vector<uint32> nextOffset(m_EventTypeOffsets, m_EventTypeOffsets + EVENT_T_END);
+    for (uint32 index = 0; index < m_CreatureEventAIList.size(); ++index)
+    {
+        uint32 type = m_CreatureEventAIList[index].Event.event_type;
+        if (type < EVENT_T_END)
+        {
+            m_EventsByType[nextOffset[type]++] = index;
+        }
+    }
+
     // Handle Spawned Events, also calls Reset()
     JustRespawned();
 }
@@ -186,6 +214,80 @@ inline static bool IsTimerBasedEvent(EventAI_Type type)
     }
 }
 
+void CreatureEventAI::ScheduleTimer(CreatureEventAIHolder& holder)
+{
+    uint32 index = &holder - &m_CreatureEventAIList[0];
+
+    // A new id makes the heap skip the entry of the previous schedule
+    ++holder.TimerId;
+    holder.Frozen = false;
+
+    if (!holder.Time)
+    {
+        if (!holder.Ready && IsTimerBasedEvent(holder.Event.event_type))
+        {
+            holder.Ready = true;
+            m_ReadyTimerEvents.push_back(index);
+        }
+        return;
+    }
+
+    // Do not run timers if event cannot trigger in this phase
+    if (holder.Event.event_inverse_phase_mask & (1 << m_TimerPhase))
+    {
+        holder.Frozen = true;
+        return;
+    }
+
+    holder.DueTime = m_EventClock + holder.Time;
+
+    EventTimer timer;
+    timer.dueTime = holder.DueTime;
+    timer.index = index;
+    timer.timerId = holder.TimerId;
+    m_EventTimers.push(timer);
+}
+
+void CreatureEventAI::UpdateTimerPhase()
+{
+    m_TimerPhase = m_Phase;
+
+    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    {
+        if (!i->Time)
+        {
+            continue;
+        }
+
+        bool frozen = (i->Event.event_inverse_phase_mask & (1 << m_TimerPhase)) != 0;
+        if (frozen == i->Frozen)
+        {
+            continue;
+        }
+
+        if (frozen)
+        {
+            i->Time = std::max(GetRemainingTime(*i), uint32(1));
+            i->Frozen = true;
+            ++i->TimerId;
+        }
+        else
+        {
+            ScheduleTimer(*i);                              // Time holds what was left when it was stopped
+        }
+    }
+}
+
+uint32 CreatureEventAI::GetRemainingTime(CreatureEventAIHolder const& holder) const
+{
+    if (!holder.Time || holder.Frozen)
+    {
+        return holder.Time;
+    }
+
+    return holder.DueTime > m_EventClock ? uint32(holder.DueTime - m_EventClock) : 0;
+}
+
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pActionInvoker, Creature* pAIEventSender /*=NULL*/)
 {
     if (!pHolder.Enabled || pHolder.Time)
@@ -550,6 +652,9 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pAction
             break;
     }
 
+    // Start the repeat timer set above
+    ScheduleTimer(pHolder);
+
     // Disable non-repeatable events
     if (!(pHolder.Event.event_flags & EFLAG_REPEATABLE))
     {
@@ -823,9 +928,11 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             break;
         case ACTION_T_THREAT_ALL_PCT:       //14
         {
-            ThreatList const& threatList = m_creature->GetThreatManager().getThreatList();
-            for (ThreatList::const_iterator i = threatList.begin(); i != threatList.end(); ++i)
-                if (Unit* Temp = m_creature->GetMap()->GetUnit((*i)->getUnitGuid()))
+            // threat changes reorder the threat list, so work on a copy
+            GuidVector threatGuids;
+            m_creature->FillGuidsListFromThreatList(threatGuids);
+            for (GuidVector::const_iterator i = threatGuids.begin(); i != threatGuids.end(); ++i)
+                if (Unit* Temp = m_creature->GetMap()->GetUnit(*i))
                 {
                     m_creature->GetThreatManager().modifyThreatPercent(Temp, action.threat_all_pct.percent);
                 }
@@ -1273,20 +1380,23 @@ void CreatureEventAI::JustRespawned()                       // NOTE that this is
 {
     Reset();
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    // Reset generic timer
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_TIMER_GENERIC); i != EventsEnd(EVENT_T_TIMER_GENERIC); ++i)
     {
-        // Reset generic timer
-        if (i->Event.event_type == EVENT_T_TIMER_GENERIC)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+        if (holder.UpdateRepeatTimer(m_creature, holder.Event.timer.initialMin, holder.Event.timer.initialMax))
         {
-            if (i->UpdateRepeatTimer(m_creature, i->Event.timer.initialMin, i->Event.timer.initialMax))
-            {
-                i->Enabled = true;
-            }
+            holder.Enabled = true;
+            ScheduleTimer(holder);
         }
-        // Handle Spawned Events
-        else if (SpawnedEventConditionsCheck(i->Event))
+    }
+
+    // Handle Spawned Events
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_SPAWNED); i != EventsEnd(EVENT_T_SPAWNED); ++i)
+    {
+        if (SpawnedEventConditionsCheck(m_CreatureEventAIList[*i].Event))
         {
-            ProcessEvent(*i);
+            ProcessEvent(m_CreatureEventAIList[*i]);
         }
     }
 }
@@ -1298,38 +1408,24 @@ void CreatureEventAI::Reset()
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
 
-    // Reset all events to enabled
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    // Reset all out of combat timers
+    // TODO: verify if events previously disabled (ex. aggro yell) should be enabled here, instead of enable this in void Aggro()
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_TIMER_OOC); i != EventsEnd(EVENT_T_TIMER_OOC); ++i)
     {
-        CreatureEventAI_Event const& event = i->Event;
-        switch (event.event_type)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+        if (holder.UpdateRepeatTimer(m_creature, holder.Event.timer.initialMin, holder.Event.timer.initialMax))
         {
-                // Reset all out of combat timers
-            case EVENT_T_TIMER_OOC:
-            {
-                if (i->UpdateRepeatTimer(m_creature, event.timer.initialMin, event.timer.initialMax))
-                {
-                    i->Enabled = true;
-                }
-                break;
-            }
-            default:
-            // TODO: enable below code line / verify this is correct to enable events previously disabled (ex. aggro yell), instead of enable this in void Aggro()
-            //i->Enabled = true;
-            //i->Time = 0;
-            break;
+            holder.Enabled = true;
+            ScheduleTimer(holder);
         }
     }
 }
 
 void CreatureEventAI::JustReachedHome()
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_REACHED_HOME); i != EventsEnd(EVENT_T_REACHED_HOME); ++i)
     {
-        if (i->Event.event_type == EVENT_T_REACHED_HOME)
-        {
-            ProcessEvent(*i);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i]);
     }
 
     Reset();
@@ -1352,12 +1448,9 @@ void CreatureEventAI::EnterEvadeMode()
     SetSpellsList(m_creature->GetCreatureInfo()->SpellListId);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_EVADE); i != EventsEnd(EVENT_T_EVADE); ++i)
     {
-        if (i->Event.event_type == EVENT_T_EVADE)
-        {
-            ProcessEvent(*i);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i]);
     }
     m_creature->ResetPlayerDamageReq();
 }
@@ -1381,12 +1474,9 @@ void CreatureEventAI::JustDied(Unit* killer)
     }
 
     // Handle On Death events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_DEATH); i != EventsEnd(EVENT_T_DEATH); ++i)
     {
-        if (i->Event.event_type == EVENT_T_DEATH)
-        {
-            ProcessEvent(*i, killer);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i], killer);
     }
 
     // reset phase after any death state events
@@ -1400,45 +1490,33 @@ void CreatureEventAI::KilledUnit(Unit* victim)
         return;
     }
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_KILL); i != EventsEnd(EVENT_T_KILL); ++i)
     {
-        if (i->Event.event_type == EVENT_T_KILL)
-        {
-            ProcessEvent(*i, victim);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i], victim);
     }
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_UNIT); i != EventsEnd(EVENT_T_SUMMONED_UNIT); ++i)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_UNIT)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i], pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_JUST_DIED); i != EventsEnd(EVENT_T_SUMMONED_JUST_DIED); ++i)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i], pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_JUST_DESPAWN); i != EventsEnd(EVENT_T_SUMMONED_JUST_DESPAWN); ++i)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[*i], pUnit);
     }
 }
 
@@ -1446,13 +1524,13 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Creature* pSender, U
 {
     MANGOS_ASSERT(pSender);
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_RECEIVE_AI_EVENT); i != EventsEnd(EVENT_T_RECEIVE_AI_EVENT); ++i)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-            itr->Event.receiveAIEvent.eventType == eventType && (!itr->Event.receiveAIEvent.senderEntry || itr->Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
-            {
-                ProcessEvent(*itr, pInvoker, pSender);
-            }
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+        if (holder.Event.receiveAIEvent.eventType == eventType && (!holder.Event.receiveAIEvent.senderEntry || holder.Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
+        {
+            ProcessEvent(holder, pInvoker, pSender);
+        }
     }
 }
 
@@ -1466,19 +1544,21 @@ void CreatureEventAI::EnterCombat(Unit* enemy)
         {
             case EVENT_T_AGGRO:
                 i->Enabled = true;
-                ProcessEvent(*i, enemy);
+                ProcessEvent(*i, enemy);                    // starts its own repeat timer when it triggers
                 break;
                 // Reset all in combat timers
             case EVENT_T_TIMER_IN_COMBAT:
                 if (i->UpdateRepeatTimer(m_creature, event.timer.initialMin, event.timer.initialMax))
                 {
                     i->Enabled = true;
+                    ScheduleTimer(*i);
                 }
                 break;
                 // All normal events need to be re-enabled and their time set to 0
             default:
                 i->Enabled = true;
                 i->Time = 0;
+                ScheduleTimer(*i);
                 break;
         }
     }
@@ -1514,22 +1594,21 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     // Check for OOC LOS Event
     if (m_HasOOCLoSEvent && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_OOC_LOS); i != EventsEnd(EVENT_T_OOC_LOS); ++i)
         {
-            if (itr->Event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr->Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
 
-                // if friendly event && who is not hostile OR hostile event && who is hostile
-                if ((itr->Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                    ((!itr->Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            // if friendly event && who is not hostile OR hostile event && who is hostile
+            if ((holder.Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                ((!holder.Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            {
+                // if range is ok and we are actually in LOS
+                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
                 {
-                    // if range is ok and we are actually in LOS
-                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                    {
-                        ProcessEvent(*itr, who);
-                    }
+                    ProcessEvent(holder, who);
                 }
             }
         }
@@ -1567,17 +1646,16 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 
 void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_SPELLHIT); i != EventsEnd(EVENT_T_SPELLHIT); ++i)
     {
-        if (i->Event.event_type == EVENT_T_SPELLHIT)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || pSpell->Id == holder.Event.spell_hit.spellId)
         {
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i->Event.spell_hit.spellId || pSpell->Id == i->Event.spell_hit.spellId)
+            if (GetSchoolMask(pSpell->School) & holder.Event.spell_hit.schoolMask)
             {
-                if (GetSchoolMask(pSpell->School) & i->Event.spell_hit.schoolMask)
-                {
-                    ProcessEvent(*i, pUnit);
-                }
+                ProcessEvent(holder, pUnit);
             }
         }
     }
@@ -1593,35 +1671,52 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     {
         m_EventDiff += diff;
 
-        // Check for time based events
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        // Stop or restart timers for a changed phase before they advance
+        if (m_TimerPhase != m_Phase)
         {
-            // Decrement Timers
-            if (i->Time)
+            UpdateTimerPhase();
+        }
+
+        m_EventClock += m_EventDiff;
+
+        // Collect the timers that ran out
+        while (!m_EventTimers.empty() && m_EventTimers.top().dueTime <= m_EventClock)
+        {
+            EventTimer timer = m_EventTimers.top();
+            m_EventTimers.pop();
+
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[timer.index];
+            if (timer.timerId != holder.TimerId || holder.Frozen)
             {
-                if (i->Time > m_EventDiff)
-                {
-                    // Do not decrement timers if event cannot trigger in this phase
-                    if (!(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
-                    {
-                        i->Time -= m_EventDiff;
-                    }
-                }
-                else
-                {
-                    i->Time = 0;
-                }
+                continue;                                   // rescheduled or stopped since
             }
 
-            // Skip processing of events that have time remaining or are disabled
-            if (!(i->Enabled) || i->Time)
+            holder.Time = 0;
+            ScheduleTimer(holder);
+        }
+
+        // Check for time based events, in list order
+        EventIndexList readyEvents;
+        readyEvents.swap(m_ReadyTimerEvents);
+        std::sort(readyEvents.begin(), readyEvents.end());
+        for (EventIndexList::const_iterator i = readyEvents.begin(); i != readyEvents.end(); ++i)
+        {
+            m_CreatureEventAIList[*i].Ready = false;
+        }
+
+        for (EventIndexList::const_iterator i = readyEvents.begin(); i != readyEvents.end(); ++i)
+        {
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+            if (holder.Enabled && !holder.Time)
             {
-                continue;
+                ProcessEvent(holder);
             }
 
-            if (IsTimerBasedEvent(i->Event.event_type))
+            // Events that did not trigger are checked again at the next update, disabled ones when they get enabled
+            if (holder.Enabled && !holder.Time && !holder.Ready)
             {
-                ProcessEvent(*i);
+                holder.Ready = true;
+                m_ReadyTimerEvents.push_back(*i);
             }
         }
 
@@ -1789,21 +1884,19 @@ void CreatureEventAI::DoFindFriendlyMissingBuff(std::list<Creature*>& _list, flo
 
 void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
 {
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (EventIndexList::const_iterator i = EventsBegin(EVENT_T_RECEIVE_EMOTE); i != EventsEnd(EVENT_T_RECEIVE_EMOTE); ++i)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_EMOTE)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*i];
+        if (holder.Event.receive_emote.emoteId != text_emote)
         {
-            if (itr->Event.receive_emote.emoteId != text_emote)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            PlayerCondition pcon(0, itr->Event.receive_emote.condition, itr->Event.receive_emote.conditionValue1, itr->Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon(0, holder.Event.receive_emote.condition, holder.Event.receive_emote.conditionValue1, holder.Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            ProcessEvent(holder, pPlayer);
         }
     }
 }
@@ -30,6 +30,8 @@
 #include "CreatureAI.h"
 #include "Unit.h"
 
+#include <queue>
+
 class Player;
 class WorldObject;
 
@@ -633,12 +635,17 @@ typedef UNORDERED_MAP<uint32, CreatureEventAI_Summon> CreatureEventAI_Summon_Map
 
 struct CreatureEventAIHolder
 {
-    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true) {}
+    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true), DueTime(0), TimerId(0), Frozen(false), Ready(false) {}
 
     CreatureEventAI_Event Event;
-    uint32 Time;
+    uint32 Time;                                            // Time left when the timer was last (re)scheduled, 0 once it ran out
     bool Enabled;
 
+    uint64 DueTime;                                         // Event clock at which Time runs out, unused while Frozen
+    uint32 TimerId;                                         // Changed on every reschedule, older heap entries of the event are skipped
+    bool Frozen;                                            // Time does not run, the event can't trigger in the current phase
+    bool Ready;                                             // Timer based event waiting in the ready list
+
     // helper
     bool UpdateRepeatTimer(Creature* creature, uint32 repeatMin, uint32 repeatMax);
 };
@@ -692,6 +699,27 @@ class CreatureEventAI : public CreatureAI
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range);
 
     protected:
+        struct EventTimer
+        {
+            uint64 dueTime;
+            uint32 index;                                   // into m_CreatureEventAIList
+            uint32 timerId;
+
+            bool operator>(EventTimer const& other) const { return dueTime > other.dueTime; }
+        };
+        typedef std::priority_queue<EventTimer, std::vector<EventTimer>, std::greater<EventTimer> > EventTimerQueue;
+        typedef std::vector<uint32> EventIndexList;
+
+        // Indexes of the events of one type, in list order
+        EventIndexList::const_iterator EventsBegin(EventAI_Type type) const { return m_EventsByType.begin() + m_EventTypeOffsets[type]; }
+        EventIndexList::const_iterator EventsEnd(EventAI_Type type) const { return m_EventsByType.begin() + m_EventTypeOffsets[type + 1]; }
+
+        // Starts the timer of the event after its Time was set, or marks the event ready if Time is 0
+        void ScheduleTimer(CreatureEventAIHolder& holder);
+        // Stops the timers of events which can't trigger in the current phase and restarts the others
+        void UpdateTimerPhase();
+        uint32 GetRemainingTime(CreatureEventAIHolder const& holder) const;
+
         uint32 m_EventUpdateTime;                           // Time between event updates
         uint32 m_EventDiff;                                 // Time between the last event call
 
@@ -699,6 +727,13 @@ class CreatureEventAI : public CreatureAI
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
 
+        EventIndexList m_EventsByType;                      // m_CreatureEventAIList indexes grouped by event type
+        uint32 m_EventTypeOffsets[EVENT_T_END + 1];         // Start of each event type in m_EventsByType
+        uint64 m_EventClock;                                // Sum of the diffs of all event updates
+        EventTimerQueue m_EventTimers;                      // Running timers, soonest first
+        EventIndexList m_ReadyTimerEvents;                  // Timer based events whose time ran out, checked at each event update
+        uint8  m_TimerPhase;                                // Phase the timers were last frozen for
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
         bool   m_HasOOCLoSEvent;                            // Cache if a OOC-LoS Event exists
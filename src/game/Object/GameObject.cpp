@@ -833,8 +833,11 @@ void GameObject::SaveToDB(uint32 mapid)
 
 bool GameObject::LoadFromDB(uint32 guid, Map* map)
 {
-    GameObjectData const* data = sObjectMgr.GetGOData(guid);
+    return LoadFromDB(guid, map, sObjectMgr.GetGOData(guid));
+}
 
+bool GameObject::LoadFromDB(uint32 guid, Map* map, GameObjectData const* data)
+{
     if (!data)
     {
         sLog.outErrorDb("Gameobject (GUID: %u) not found in table `gameobject`, can't load. ", guid);
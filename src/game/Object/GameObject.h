@@ -589,6 +589,7 @@ class GameObject : public WorldObject
         void SaveToDB();
         void SaveToDB(uint32 mapid);
         bool LoadFromDB(uint32 guid, Map* map);
+        bool LoadFromDB(uint32 guid, Map* map, GameObjectData const* data); // data already looked up
         virtual void DeleteFromDB();
 
         void SetOwnerGuid(ObjectGuid ownerGuid)
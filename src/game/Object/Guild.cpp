@@ -261,6 +261,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
         pl->SetInGuild(m_Id);
         pl->SetRank(newmember.RankId);
         pl->SetGuildIdInvited(0);
+        MemberLoggedIn(pl);
     }
 
     UpdateAccountsNumber();
@@ -612,6 +613,7 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
         }
     }
 
+    MemberLoggedOut(guid);
     members.erase(lowguid);
 
     Player* player = sObjectMgr.GetPlayer(guid);
@@ -651,6 +653,40 @@ bool Guild::ChangeMemberRank(ObjectGuid guid, uint8 newRank)
     return false;
 }
 
+void Guild::MemberLoggedIn(Player* player)
+{
+    MemberSlot* slot = GetMemberSlot(player->GetObjectGuid());
+    if (!slot)
+    {
+        return;
+    }
+
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+    if (!slot->Online)
+    {
+        m_onlineMembers.push_back(slot);
+        slot->Online = true;
+    }
+}
+
+void Guild::MemberLoggedOut(ObjectGuid guid)
+{
+    MemberSlot* slot = GetMemberSlot(guid);
+    if (!slot)
+    {
+        return;
+    }
+
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+    if (!slot->Online)
+    {
+        return;
+    }
+
+    slot->Online = false;
+    m_onlineMembers.erase(std::remove(m_onlineMembers.begin(), m_onlineMembers.end(), slot), m_onlineMembers.end());
+}
+
 void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint32 language)
 {
     if (!session)
@@ -667,9 +703,10 @@ void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        Player* pl = sObjectMgr.GetPlayer((*itr)->guid);
 
         if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
         {
@@ -691,12 +728,13 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
         return;
     }
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        WorldPacket data;
-        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-        Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        Player* pl = sObjectMgr.GetPlayer((*itr)->guid);
 
         if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
         {
@@ -707,10 +745,10 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
 
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (player)
+        if (Player* player = sObjectMgr.GetPlayer((*itr)->guid))
         {
             player->GetSession()->SendPacket(packet);
         }
@@ -719,12 +757,12 @@ void Guild::BroadcastPacket(WorldPacket* packet)
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        if (itr->second.RankId == rankId)
+        if ((*itr)->RankId == rankId)
         {
-            Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-            if (player)
+            if (Player* player = sObjectMgr.GetPlayer((*itr)->guid))
             {
                 player->GetSession()->SendPacket(packet);
             }
@@ -863,7 +901,7 @@ void Guild::Roster(WorldSession* session /*= NULL*/)
 
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
-        if (Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
+        if (Player* pl = itr->second.Online ? sObjectMgr.GetPlayer(itr->second.guid) : NULL)
         {
             data << pl->GetObjectGuid();
             data << uint8(1);
@@ -160,6 +160,8 @@ struct GuildEventLogEntry
 
 struct MemberSlot
 {
+    MemberSlot() : accountId(0), RankId(0), Level(0), Class(0), ZoneId(0), LogoutTime(0), Online(false) {}
+
     void SetMemberStats(Player* player);
     void UpdateLogoutTime();
     void SetPNOTE(std::string pnote);
@@ -176,6 +178,7 @@ struct MemberSlot
     uint64 LogoutTime;
     std::string Pnote;
     std::string OFFnote;
+    bool Online;                                            // set between login and logout, see Guild::MemberLoggedIn
 };
 
 struct RankInfo
@@ -199,6 +202,7 @@ class Guild
         void Disband();
 
         typedef UNORDERED_MAP<uint32, MemberSlot> MemberList;
+        typedef std::vector<MemberSlot*> OnlineMemberList;
         typedef std::vector<RankInfo> RankList;
 
         uint32 GetId() { return m_Id; }
@@ -229,6 +233,10 @@ class Guild
         void SetEmblem(uint32 emblemStyle, uint32 emblemColor, uint32 borderStyle, uint32 borderColor, uint32 backgroundColor);
 
         uint32 GetMemberSize() const { return members.size(); }
+
+        // keep the online member list used by broadcasts, called at login/logout and join/leave
+        void MemberLoggedIn(Player* player);
+        void MemberLoggedOut(ObjectGuid guid);
         uint32 GetAccountsNumber();
 
         bool LoadGuildFromDB(QueryResult* guildDataResult);
@@ -250,8 +258,9 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = NULL)
         {
-            for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
-                if (Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
+            ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, m_onlineMembersLock);
+            for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if (Player* player = sObjectAccessor.FindPlayer((*itr)->guid))
                     if (player != except)
                     {
                         _do(player);
@@ -324,6 +333,8 @@ class Guild
         RankList m_Ranks;
 
         MemberList members;
+        OnlineMemberList m_onlineMembers;                   // slots of logged in members, points into members
+        ACE_Recursive_Thread_Mutex m_onlineMembersLock;     // petition turn-in adds members from map threads
 
         /** These are actually ordered lists. The first element is the oldest entry.*/
         typedef std::list<GuildEventLogEntry> GuildEventLog;
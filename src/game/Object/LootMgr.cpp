@@ -78,14 +78,24 @@ class LootTemplate::LootGroup                               // A set of loot def
         */
         bool HasStartingQuestDropForPlayer(Player const* player) const;
         void Process(Loot& loot) const;                     // Rolls an item from the group (if any) and adds the item to the loot
+        void Compile();                                     // Builds the alias table used by Process(), after loading
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
 
         void Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const;
         void CheckLootRefs(LootIdSet* ref_set) const;
     private:
+        // One column of the alias table: own outcome with the given probability, else the outcome of column alias
+        struct AliasSlot
+        {
+            float probability;
+            uint32 alias;
+            LootStoreItem const* item;                      // NULL for no drop (all missed or disabled item)
+        };
+
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        std::vector<AliasSlot> m_aliasTable;
 
         LootStoreItem const* Roll() const;                  // Rolls an item from the group, returns NULL if all miss their chances
 };
@@ -121,7 +131,7 @@ void LootStore::LoadLootTable()
     Clear();
 
     //                                                 0      1     2                    3        4              5         6
-    QueryResult* result = WorldDatabase.PQuery("SELECT `entry`, `item`, `ChanceOrQuestChance`, `groupid`, `mincountOrRef`, `maxcount`, `condition_id` FROM `%s`", GetName());
+    QueryResult* result = WorldDatabase.PQueryBinary("SELECT `entry`, `item`, `ChanceOrQuestChance`, `groupid`, `mincountOrRef`, `maxcount`, `condition_id` FROM `%s`", GetName());
 
     if (result)
     {
@@ -193,6 +203,7 @@ void LootStore::LoadLootTable()
         delete result;
 
         Verify();                                           // Checks validity of the loot store
+        Compile();
 
         sLog.outString(">> Loaded %u loot definitions (%zu templates) from table %s", count, m_LootTemplates.size(), GetName());
         sLog.outString();
@@ -264,6 +275,20 @@ LootTemplate const* LootStore::GetLootFor(uint32 loot_id) const
     return tab->second;
 }
 
+// Compiles all templates of the store, templates of other stores must not change meanwhile
+void LootStore::Compile()
+{
+    for (LootTemplateMap::const_iterator tab = m_LootTemplates.begin(); tab != m_LootTemplates.end(); ++tab)
+    {
+        tab->second->ResetCompiled();
+    }
+
+    for (LootTemplateMap::const_iterator tab = m_LootTemplates.begin(); tab != m_LootTemplates.end(); ++tab)
+    {
+        tab->second->Compile();
+    }
+}
+
 void LootStore::LoadAndCollectLootIds(LootIdSet& ids_set)
 {
     LoadLootTable();
@@ -1019,33 +1044,106 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
     }
 }
 
-// Rolls an item from the group, returns NULL if all miss their chances
-LootStoreItem const* LootTemplate::LootGroup::Roll() const
+// Builds the alias table of the group: every possible outcome of a roll with its chance
+// An explicitly chanced entry takes the part of 0..100 it covers after the entries before it,
+// the rest is split between equal chanced entries or is no drop. Items disabled for drop are no drop.
+void LootTemplate::LootGroup::Compile()
 {
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    std::vector<std::pair<LootStoreItem const*, float> > outcomes;
+    float noDrop = 0.0f;
+    float used = 0.0f;
+
+    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end() && used < 100.0f; ++i)
     {
-        float Roll = rand_chance_f();
+        float chance = i->chance >= 100.0f ? 100.0f - used : std::min(i->chance, 100.0f - used);
+        used += chance;
 
-        for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i) // check each explicitly chanced entry in the template and modify its chance based on quality.
+        if (DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, i->itemid))
         {
-            if (ExplicitlyChanced[i].chance >= 100.0f)
-            {
-                return &ExplicitlyChanced[i];
-            }
+            noDrop += chance;
+        }
+        else
+        {
+            outcomes.push_back(std::make_pair(&*i, chance));
+        }
+    }
 
-            Roll -= ExplicitlyChanced[i].chance;
-            if (Roll < 0)
+    if (used < 100.0f)
+    {
+        if (EqualChanced.empty())
+        {
+            noDrop += 100.0f - used;
+        }
+        else
+        {
+            float chance = (100.0f - used) / EqualChanced.size();
+            for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
             {
-                return &ExplicitlyChanced[i];
+                if (DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, i->itemid))
+                {
+                    noDrop += chance;
+                }
+                else
+                {
+                    outcomes.push_back(std::make_pair(&*i, chance));
+                }
             }
         }
     }
-    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+
+    if (noDrop > 0.0f)
+    {
+        outcomes.push_back(std::make_pair((LootStoreItem const*)NULL, noDrop));
+    }
+
+    // Vose's alias method: columns below the average are topped up from one above it
+    m_aliasTable.clear();
+    if (outcomes.empty())
+    {
+        return;
+    }
+
+    uint32 size = outcomes.size();
+    std::vector<float> scaled(size);
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < size; ++i)
+    {
+        AliasSlot slot = { 1.0f, i, outcomes[i].first };
+        m_aliasTable.push_back(slot);
+
+        scaled[i] = outcomes[i].second * size / 100.0f;
+        (scaled[i] < 1.0f ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+
+        m_aliasTable[less].probability = scaled[less];
+        m_aliasTable[less].alias = more;
+
+        scaled[more] -= 1.0f - scaled[less];
+        if (scaled[more] < 1.0f)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // columns left in either list are full up to rounding errors and keep probability 1
+}
+
+// Rolls an item from the group, returns NULL if all miss their chances
+LootStoreItem const* LootTemplate::LootGroup::Roll() const
+{
+    if (m_aliasTable.empty())
     {
-        return &EqualChanced[irand(0, EqualChanced.size() - 1)];
+        return NULL;
     }
 
-    return NULL;                                            // Empty drop from the group
+    AliasSlot const& slot = m_aliasTable[urand(0, m_aliasTable.size() - 1)];
+    return rand_norm_f() < slot.probability ? slot.item : m_aliasTable[slot.alias].item;
 }
 
 // True if group includes at least 1 quest drop entry
@@ -1140,8 +1238,7 @@ bool LootTemplate::LootGroup::HasStartingQuestDropForPlayer(Player const* player
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
 void LootTemplate::LootGroup::Process(Loot& loot) const
 {
-    LootStoreItem const* item = Roll();
-    if (item != NULL && !DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, item->itemid))
+    if (LootStoreItem const* item = Roll())                 // disabled items are never rolled
     {
         loot.AddItem(*item);
     }
@@ -1256,45 +1353,121 @@ void LootTemplate::Process(Loot& loot, LootStore const& store, bool rate, uint8
         return;
     }
 
-    // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin() ; i != Entries.end() ; ++i)
+    for (LootRollSteps::const_iterator i = m_rollSteps.begin(); i != m_rollSteps.end(); ++i)
     {
-        if (DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, i->itemid) || !i->Roll(rate))
+        LootStoreItem const* item = i->item;
+
+        switch (i->type)
         {
-            continue; // Bad luck for the entry
+            case LootRollStep::LOOT_STEP_ITEM:              // Plain entries (not a reference, not grouped)
+            {
+                if (item->chance < 100.0f)
+                {
+                    float qualityModifier = rate && i->quality >= 0 ? sWorld.getConfig(qualityToRate[i->quality]) : 1.0f;
+                    if (!roll_chance_f(item->chance * qualityModifier))
+                    {
+                        break; // Bad luck for the entry
+                    }
+                }
+
+                loot.AddItem(*item);
+                break;
+            }
+            case LootRollStep::LOOT_STEP_REFERENCE:         // References processing
+            {
+                if (!item->Roll(rate))
+                {
+                    break;
+                }
+
+                // Check condition
+                if (item->conditionId && !sObjectMgr.IsPlayerMeetToCondition(item->conditionId, NULL, NULL, loot.GetLootTarget(), CONDITION_FROM_REFERING_LOOT))
+                {
+                    break;
+                }
+
+                for (uint32 loop = 0; loop < item->maxcount; ++loop) // Ref multiplicator
+                {
+                    i->reference->Process(loot, store, rate, item->group);
+                }
+                break;
+            }
+            case LootRollStep::LOOT_STEP_GROUP:
+                i->group->Process(loot);
+                break;
         }
+    }
+}
 
-        if (i->mincountOrRef < 0)                           // References processing
+// Builds the roll steps of the template: non-grouped entries in DB order, then the groups.
+// Disabled items are left out. A reference that always drops once without condition is
+// replaced by the steps of the referenced template (or its group), unless it loops back.
+void LootTemplate::Compile()
+{
+    if (m_compileState != LOOT_NOT_COMPILED)
+    {
+        return;
+    }
+
+    m_compileState = LOOT_COMPILING;
+
+    for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
+    {
+        i->Compile();
+    }
+
+    m_rollSteps.clear();
+    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    {
+        if (DisableMgr::IsDisabledFor(DISABLE_TYPE_ITEM_DROP, i->itemid))
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-i->mincountOrRef);
+            continue;
+        }
+
+        LootRollStep step = { LootRollStep::LOOT_STEP_ITEM, -1, &*i, NULL, NULL };
 
-            if (!Referenced)
+        if (i->mincountOrRef < 0)
+        {
+            LootTemplate* referenced = const_cast<LootTemplate*>(LootTemplates_Reference.GetLootFor(-i->mincountOrRef));
+            if (!referenced)
             {
                 continue; // Error message already printed at loading stage
             }
 
-            // Check condition
-            if (i->conditionId && !sObjectMgr.IsPlayerMeetToCondition(i->conditionId, NULL, NULL, loot.GetLootTarget(), CONDITION_FROM_REFERING_LOOT))
+            referenced->Compile();
+
+            if (i->chance >= 100.0f && !i->conditionId && i->maxcount == 1 && referenced->m_compileState == LOOT_COMPILED)
             {
+                if (!i->group)
+                {
+                    m_rollSteps.insert(m_rollSteps.end(), referenced->m_rollSteps.begin(), referenced->m_rollSteps.end());
+                }
+                else if (i->group <= referenced->Groups.size())
+                {
+                    LootRollStep groupStep = { LootRollStep::LOOT_STEP_GROUP, -1, NULL, NULL, &referenced->Groups[i->group - 1] };
+                    m_rollSteps.push_back(groupStep);
+                }
                 continue;
             }
 
-            for (uint32 loop = 0; loop < i->maxcount; ++loop) // Ref multiplicator
-            {
-                Referenced->Process(loot, store, rate, i->group);
-            }
+            step.type = LootRollStep::LOOT_STEP_REFERENCE;
+            step.reference = referenced;
         }
-        else                                                // Plain entries (not a reference, not grouped)
+        else if (ItemPrototype const* pProto = ObjectMgr::GetItemPrototype(i->itemid))
         {
-            loot.AddItem(*i); // Chance is already checked, just add
+            step.quality = int8(pProto->Quality);
         }
+
+        m_rollSteps.push_back(step);
     }
 
-    // Now processing groups
-    for (LootGroups::const_iterator i = Groups.begin() ; i != Groups.end() ; ++i)
+    for (LootGroups::const_iterator i = Groups.begin(); i != Groups.end(); ++i)
     {
-        i->Process(loot);
+        LootRollStep step = { LootRollStep::LOOT_STEP_GROUP, -1, NULL, NULL, &*i };
+        m_rollSteps.push_back(step);
     }
+
+    m_compileState = LOOT_COMPILED;
 }
 
 // True if template includes at least 1 quest drop entry
@@ -1757,4 +1930,22 @@ void LoadLootTemplates_Reference()
 
     // output error for any still listed ids (not referenced from any loot table)
     LootTemplates_Reference.ReportUnusedIds(ids_set);
+
+    // other stores may have inlined steps of the replaced reference templates
+    CompileLootTemplates();
+}
+
+// Rebuilds the roll steps of all loot stores, needed when references or item drop disables change
+void CompileLootTemplates()
+{
+    LootTemplates_Reference.Compile();
+
+    LootTemplates_Creature.Compile();
+    LootTemplates_Fishing.Compile();
+    LootTemplates_Gameobject.Compile();
+    LootTemplates_Item.Compile();
+    LootTemplates_Pickpocketing.Compile();
+    LootTemplates_Skinning.Compile();
+    LootTemplates_Disenchant.Compile();
+    LootTemplates_Mail.Compile();
 }
@@ -154,6 +154,7 @@ class LootStore
         void Verify() const;
 
         void LoadAndCollectLootIds(LootIdSet& ids_set);
+        void Compile();                                     // rebuild roll lists of all templates, see LootTemplate::Compile()
         void CheckLootRefs(LootIdSet* ref_set = NULL) const;// check existence reference and remove it from ref_set
         void ReportUnusedIds(LootIdSet const& ids_set) const;
         void ReportNotExistedId(uint32 id) const;
@@ -200,12 +201,43 @@ class LootTemplate
         class LootGroup;                                   // A set of loot definitions for items (refs are not allowed inside)
         typedef std::vector<LootGroup> LootGroups;
 
+        // One step of the compiled template: roll a plain entry, roll a reference or pick from a group
+        struct LootRollStep
+        {
+            enum Type
+            {
+                LOOT_STEP_ITEM,
+                LOOT_STEP_REFERENCE,
+                LOOT_STEP_GROUP
+            };
+
+            Type type;
+            int8 quality;                                   // ITEM: quality for the drop rate, -1 without prototype
+            LootStoreItem const* item;                      // ITEM, REFERENCE: the rolled entry
+            LootTemplate const* reference;                  // REFERENCE: referenced template
+            LootGroup const* group;                         // GROUP: group of this or an inlined template
+        };
+        typedef std::vector<LootRollStep> LootRollSteps;
+
+        enum CompileState
+        {
+            LOOT_NOT_COMPILED,
+            LOOT_COMPILING,
+            LOOT_COMPILED
+        };
+
     public:
+        LootTemplate() : m_compileState(LOOT_NOT_COMPILED) {}
+
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem& item);
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, LootStore const& store, bool rate, uint8 GroupId = 0) const;
 
+        // Builds the roll steps used by Process() (after loading, and again when references or disables change)
+        void ResetCompiled() { m_compileState = LOOT_NOT_COMPILED; }
+        void Compile();
+
         // True if template includes at least 1 quest drop entry
         bool HasQuestDrop(LootTemplateMap const& store, uint8 GroupId = 0) const;
         // True if template includes at least 1 quest drop for an active quest of the player
@@ -237,6 +269,10 @@ class LootTemplate
     private:
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
+
+        // Entries with disabled items left out, always dropping unconditional references replaced by their steps
+        LootRollSteps     m_rollSteps;
+        CompileState      m_compileState;
 };
 
 //=====================================================
@@ -399,6 +435,8 @@ void LoadLootTemplates_Disenchant();
 
 void LoadLootTemplates_Reference();
 
+void CompileLootTemplates();
+
 inline void LoadLootTables()
 {
     LoadLootTemplates_Creature();
@@ -54,6 +54,7 @@
 
 #include "ItemEnchantmentMgr.h"
 #include <limits>
+#include <ace/Guard_T.h>
 
 INSTANTIATE_SINGLETON_1(ObjectMgr);
 
@@ -860,7 +861,7 @@ void ObjectMgr::LoadCreatureAddons()
     {
         if (CreatureDataAddon const* addon = sCreatureDataAddonStorage.LookupEntry<CreatureDataAddon>(i))
         {
-            if (mCreatureDataMap.find(addon->guidOrEntry) == mCreatureDataMap.end())
+            if (!mCreatureDataMap.Find(addon->guidOrEntry))
             {
                 sLog.outErrorDb("Creature (GUID: %u) does not exist but has a record in `creature_addon`", addon->guidOrEntry);
             }
@@ -1357,11 +1358,39 @@ void ObjectMgr::LoadCreatureSpells()
     sLog.outString(">> Loaded %lu creature spell templates.", (unsigned long)m_CreatureSpellsMap.size());
 }
 
+// orders spawn rows by map and grid cell, so the rows of one cell are stored next to each other
+template<class T>
+struct SpawnCellOrder
+{
+    bool operator()(std::pair<uint32, T> const& a, std::pair<uint32, T> const& b) const
+    {
+        if (a.second.mapid != b.second.mapid)
+        {
+            return a.second.mapid < b.second.mapid;
+        }
+
+        uint32 cellA = CellId(a.second);
+        uint32 cellB = CellId(b.second);
+        if (cellA != cellB)
+        {
+            return cellA < cellB;
+        }
+
+        return a.first < b.first;
+    }
+
+    static uint32 CellId(T const& data)
+    {
+        CellPair cell_pair = MaNGOS::ComputeCellPair(data.posX, data.posY);
+        return (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
+    }
+};
+
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
     //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT `creature`.`guid`, `creature`.`id`, `map`, `modelid`,"
+    QueryResult* result = WorldDatabase.QueryBinary("SELECT `creature`.`guid`, `creature`.`id`, `map`, `modelid`,"
                           //   4             5           6           7           8            9              10         11
                           "`equipment_id`, `position_x`, `position_y`, `position_z`, `orientation`, `spawntimesecs`, `spawndist`, `currentwaypoint`,"
                           //   12         13       14          15            16
@@ -1407,7 +1436,7 @@ void ObjectMgr::LoadCreatures()
             continue;
         }
 
-        CreatureData& data = mCreatureDataMap[guid];
+        CreatureData& data = mCreatureDataMap.NewOrExist(guid);
 
         data.id                 = entry;
         data.mapid              = fields[ 2].GetUInt32();
@@ -1515,6 +1544,9 @@ void ObjectMgr::LoadCreatures()
 
     delete result;
 
+    // nothing holds a reference to the rows yet
+    mCreatureDataMap.Sort(SpawnCellOrder<CreatureData>());
+
     sLog.outString(">> Loaded %zu creatures", mCreatureDataMap.size());
     sLog.outString();
 }
@@ -1524,8 +1556,13 @@ void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mapSpawnTemplatesLock);
+
     CellObjectGuids& cell_guids = mMapObjectGuids[data->mapid][cell_id];
     cell_guids.creatures.insert(guid);
+
+    // instances loading grids right now keep the old template
+    m_mapSpawnTemplates.erase(data->mapid);
 }
 
 void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
@@ -1533,14 +1570,19 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mapSpawnTemplatesLock);
+
     CellObjectGuids& cell_guids = mMapObjectGuids[data->mapid][cell_id];
     cell_guids.creatures.erase(guid);
+
+    // instances loading grids right now keep the old template
+    m_mapSpawnTemplates.erase(data->mapid);
 }
 
 void ObjectMgr::LoadGameObjects()
 {
     //                                                           0                1              2               3                      4                      5                      6
-    QueryResult* result = WorldDatabase.Query("SELECT `gameobject`.`guid`, `gameobject`.`id`, `gameobject`.`map`, `gameobject`.`position_x`, `gameobject`.`position_y`, `gameobject`.`position_z`, `gameobject`.`orientation`, "
+    QueryResult* result = WorldDatabase.QueryBinary("SELECT `gameobject`.`guid`, `gameobject`.`id`, `gameobject`.`map`, `gameobject`.`position_x`, `gameobject`.`position_y`, `gameobject`.`position_z`, `gameobject`.`orientation`, "
                           //          7                     8                     9                     10                    11                        12                       13
                           "`gameobject`.`rotation0`, `gameobject`.`rotation1`, `gameobject`.`rotation2`, `gameobject`.`rotation3`, `gameobject`.`spawntimesecs`, `gameobject`.`animprogress`, `gameobject`.`state`, "
                           //                      14                      15                                   16
@@ -1589,7 +1631,7 @@ void ObjectMgr::LoadGameObjects()
             continue;
         }
 
-        GameObjectData& data = mGameObjectDataMap[guid];
+        GameObjectData& data = mGameObjectDataMap.NewOrExist(guid);
 
         data.id             = entry;
         data.mapid          = fields[ 2].GetUInt32();
@@ -1672,6 +1714,9 @@ void ObjectMgr::LoadGameObjects()
 
     delete result;
 
+    // nothing holds a reference to the rows yet
+    mGameObjectDataMap.Sort(SpawnCellOrder<GameObjectData>());
+
     sLog.outString();
     sLog.outString(">> Loaded %zu gameobjects", mGameObjectDataMap.size());
     sLog.outString(">>> Loaded %u local transport objects", local_transports);
@@ -1682,8 +1727,13 @@ void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mapSpawnTemplatesLock);
+
     CellObjectGuids& cell_guids = mMapObjectGuids[data->mapid][cell_id];
     cell_guids.gameobjects.insert(guid);
+
+    // instances loading grids right now keep the old template
+    m_mapSpawnTemplates.erase(data->mapid);
 }
 
 void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data)
@@ -1691,8 +1741,63 @@ void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mapSpawnTemplatesLock);
+
     CellObjectGuids& cell_guids = mMapObjectGuids[data->mapid][cell_id];
     cell_guids.gameobjects.erase(guid);
+
+    // instances loading grids right now keep the old template
+    m_mapSpawnTemplates.erase(data->mapid);
+}
+
+MapSpawnTemplatePtr ObjectMgr::GetMapSpawnTemplate(uint32 mapid)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mapSpawnTemplatesLock, MapSpawnTemplatePtr());
+
+    MapSpawnTemplateMap::const_iterator found = m_mapSpawnTemplates.find(mapid);
+    if (found != m_mapSpawnTemplates.end())
+    {
+        return found->second;
+    }
+
+    std::shared_ptr<MapSpawnTemplate> spawns = std::make_shared<MapSpawnTemplate>();
+
+    MapObjectGuids::const_iterator mapItr = mMapObjectGuids.find(mapid);
+    if (mapItr != mMapObjectGuids.end())
+    {
+        for (CellObjectGuidsMap::const_iterator cellItr = mapItr->second.begin(); cellItr != mapItr->second.end(); ++cellItr)
+        {
+            CellObjectGuids const& cell_guids = cellItr->second;
+            if (cell_guids.creatures.empty() && cell_guids.gameobjects.empty())
+            {
+                continue;
+            }
+
+            CellSpawnTemplate& cell = spawns->cells[cellItr->first];
+
+            cell.creatures.reserve(cell_guids.creatures.size());
+            for (CellGuidSet::const_iterator itr = cell_guids.creatures.begin(); itr != cell_guids.creatures.end(); ++itr)
+            {
+                // missing data is reported by the creature load, same as without template
+                CreatureData const* data = GetCreatureData(*itr);
+                CellSpawnTemplate::CreatureSpawn spawn = { *itr, data, data ? GetCreatureTemplate(data->id) : NULL };
+                cell.creatures.push_back(spawn);
+            }
+
+            cell.gameobjects.reserve(cell_guids.gameobjects.size());
+            for (CellGuidSet::const_iterator itr = cell_guids.gameobjects.begin(); itr != cell_guids.gameobjects.end(); ++itr)
+            {
+                CellSpawnTemplate::GameObjectSpawn spawn = { *itr, GetGOData(*itr) };
+                cell.gameobjects.push_back(spawn);
+            }
+        }
+    }
+
+    DEBUG_LOG("ObjectMgr: built spawn template of map %u (%zu cells with spawns)", mapid, spawns->cells.size());
+
+    MapSpawnTemplatePtr result = spawns;
+    m_mapSpawnTemplates[mapid] = result;
+    return result;
 }
 
 // name must be checked to correctness (if received) before call this function
@@ -4988,7 +5093,23 @@ void ObjectMgr::LoadGossipTextLocales()
     sLog.outString();
 }
 
-// not very fast function but it is called only once a day, or on starting-up
+// Maximal amount of ids placed in a single IN (...) list while processing expired mails,
+// every chunk is written in its own transaction to keep the character DB locks short.
+#define EXPIRED_MAIL_CHUNK_SIZE 1000
+
+static void AppendIdList(std::ostringstream& ss, std::vector<uint32> const& ids, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (i != begin)
+        {
+            ss << ",";
+        }
+        ss << ids[i];
+    }
+}
+
+// called once a day, or on starting-up
 /// @param serverUp true if the server is already running, false when the server is started
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
@@ -4997,114 +5118,137 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
     uint64 basetime(curTime);
     sLog.outString("Returning mails current time: hour: %d, minute: %d, second: %d ", lt.tm_hour, lt.tm_min, lt.tm_sec);
 
-    // delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
+    // items of the mails are not selected, they are deleted or updated by joins against the current `mail_items`
+    //                           0     1              2        3          4           5
+    char const* query = "SELECT `id`,`messageType`,`sender`,`receiver`,`has_items`,`checked` "
+                        "FROM `mail` WHERE `expire_time` < '" UI64FMTD "' ORDER BY `id`";
+
+    // while running, the select is done by the DB worker and the result is processed
+    // on the world thread, where the online state of the receivers is known
+    if (serverUp)
     {
-        CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `expire_time` < '" UI64FMTD "' AND `has_items` = '0' AND `body` = ''", (uint64)basetime);
+        CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, basetime, query, basetime);
+        return;
     }
-    //                                                     0  1           2      3        4          5         6           7   8       9
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `id`,`messageType`,`sender`,`receiver`,`has_items`,`expire_time`,`cod`,`checked`,`mailTemplateId` FROM `mail` WHERE `expire_time` < '" UI64FMTD "'", (uint64)basetime);
+
+    // delete all old mails without item and without body immediately, if starting server
+    CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `expire_time` < '" UI64FMTD "' AND `has_items` = '0' AND `body` = ''", basetime);
+
+    ProcessOldMails(CharacterDatabase.PQuery(query, basetime), basetime, false);
+}
+
+void ObjectMgr::ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime)
+{
+    ProcessOldMails(result, basetime, true);
+}
+
+void ObjectMgr::ProcessOldMails(QueryResult* result, uint64 basetime, bool serverUp)
+{
     if (!result)
     {
-        BarGoLink bar(1);
-        bar.step();
+        if (!serverUp)
+        {
+            BarGoLink bar(1);
+            bar.step();
+        }
         sLog.outString(">> Only expired mails (need to be return or delete) or DB table `mail` is empty.");
         sLog.outString();
         return;                                             // any mails need to be returned or deleted
     }
 
-    // std::ostringstream delitems, delmails; // will be here for optimization
-    // bool deletemail = false, deleteitem = false;
-    // delitems << "DELETE FROM `item_instance` WHERE `guid` IN ( ";
-    // delmails << "DELETE FROM `mail` WHERE `id` IN ( "
+    struct ReturnedMail
+    {
+        uint32 id;
+        uint32 sender;
+        uint32 receiver;
+    };
 
-    BarGoLink bar(result->GetRowCount());
-    uint32 count = 0;
-    Field* fields;
+    std::vector<uint32> deletedMails;
+    std::vector<ReturnedMail> returnedMails;
+    uint32 skipped = 0;
 
     do
     {
-        bar.step();
-
-        fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+        Field* fields = result->Fetch();
+        uint32 mailId = fields[0].GetUInt32();
+        uint8 messageType = fields[1].GetUInt8();
+        uint32 sender = fields[2].GetUInt32();
+        uint32 receiver = fields[3].GetUInt32();
         bool has_items = fields[4].GetBool();
-        m->expire_time = (time_t)fields[5].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt32();
-        m->mailTemplateId = fields[8].GetInt16();
+        uint32 checked = fields[5].GetUInt32();
 
-        Player* pl = 0;
-        if (serverUp)
+        // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        // his in mailbox and he has already listed his mails )
+        if (serverUp && GetPlayer(ObjectGuid(HIGHGUID_PLAYER, receiver)))
         {
-            pl = GetPlayer(m->receiverGuid);
+            ++skipped;
+            continue;
         }
-        if (pl)
+
+        // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (has_items && messageType == MAIL_NORMAL && !(checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
         {
-            // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            // his in mailbox and he has already listed his mails )
-            delete m;
+            ReturnedMail rm;
+            rm.id = mailId;
+            rm.sender = sender;
+            rm.receiver = receiver;
+            returnedMails.push_back(rm);                    // items follow the mail back to its sender
             continue;
         }
-        // delete or return mail:
-        if (has_items)
-        {
-            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT `item_guid`,`item_template` FROM `mail_items` WHERE `mail_id`='%u'", m->messageID);
-            if (resultItems)
-            {
-                do
-                {
-                    Field* fields2 = resultItems->Fetch();
 
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+        deletedMails.push_back(mailId);
+    }
+    while (result->NextRow());
+    delete result;
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
+    for (size_t begin = 0; begin < deletedMails.size(); begin += EXPIRED_MAIL_CHUNK_SIZE)
+    {
+        size_t end = std::min(deletedMails.size(), begin + EXPIRED_MAIL_CHUNK_SIZE);
 
-                delete resultItems;
-            }
-            // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
-            {
-                // mail open and then not returned
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    CharacterDatabase.PExecute("DELETE FROM `item_instance` WHERE `guid` = '%u'", itr2->item_guid);
-                }
-            }
-            else
+        std::ostringstream ids;
+        AppendIdList(ids, deletedMails, begin, end);
+
+        // mail open and then not returned, its items go with it
+        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.PExecute("DELETE `ii` FROM `item_instance` `ii` JOIN `mail_items` `mi` ON `mi`.`item_guid` = `ii`.`guid` WHERE `mi`.`mail_id` IN (%s)", ids.str().c_str());
+        CharacterDatabase.PExecute("DELETE FROM `mail_items` WHERE `mail_id` IN (%s)", ids.str().c_str());
+        CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `id` IN (%s)", ids.str().c_str());
+        CharacterDatabase.CommitTransaction();
+    }
+
+    for (size_t begin = 0; begin < returnedMails.size(); begin += EXPIRED_MAIL_CHUNK_SIZE)
+    {
+        size_t end = std::min(returnedMails.size(), begin + EXPIRED_MAIL_CHUNK_SIZE);
+
+        // sender and receiver are swapped per mail, a single UPDATE can not read the old value of a column it already set;
+        // built without PExecute as the CASE lists of a full chunk exceed its query length
+        std::ostringstream ids, senders, receivers;
+        for (size_t i = begin; i < end; ++i)
+        {
+            ReturnedMail const& rm = returnedMails[i];
+            if (i != begin)
             {
-                // mail will be returned:
-                CharacterDatabase.PExecute("UPDATE `mail` SET `sender` = '%u', `receiver` = '%u', `expire_time` = '" UI64FMTD "', `deliver_time` = '" UI64FMTD "', `cod` = '0', `checked` = '%u' WHERE `id` = '%u'",
-                                           m->receiverGuid.GetCounter(), m->sender, (uint64)(basetime + 30 * DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE `mail_items` SET `receiver` = %u WHERE `item_guid` = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE `item_instance` SET `owner_guid` = %u WHERE `guid` = '%u'", m->sender, itr2->item_guid);
-                }
-                delete m;
-                continue;
+                ids << ",";
             }
+            ids << rm.id;
+            senders << " WHEN " << rm.id << " THEN " << rm.receiver;
+            receivers << " WHEN " << rm.id << " THEN " << rm.sender;
         }
 
-        // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `id` = '%u'", m->messageID);
-        delete m;
-        ++count;
+        std::ostringstream update;
+        update << "UPDATE `mail` SET `sender` = CASE `id`" << senders.str() << " END, `receiver` = CASE `id`" << receivers.str() << " END, "
+               << "`expire_time` = '" << (basetime + 30 * DAY) << "', `deliver_time` = '" << basetime << "', `cod` = '0', "
+               << "`checked` = '" << uint32(MAIL_CHECK_MASK_RETURNED) << "' WHERE `id` IN (" << ids.str() << ")";
+
+        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.Execute(update.str().c_str());
+        // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+        CharacterDatabase.PExecute("UPDATE `mail_items` `mi` JOIN `mail` `m` ON `m`.`id` = `mi`.`mail_id` SET `mi`.`receiver` = `m`.`receiver` WHERE `mi`.`mail_id` IN (%s)", ids.str().c_str());
+        CharacterDatabase.PExecute("UPDATE `item_instance` `ii` JOIN `mail_items` `mi` ON `mi`.`item_guid` = `ii`.`guid` SET `ii`.`owner_guid` = `mi`.`receiver` WHERE `mi`.`mail_id` IN (%s)", ids.str().c_str());
+        CharacterDatabase.CommitTransaction();
     }
-    while (result->NextRow());
-    delete result;
 
-    sLog.outString(">> Loaded %u mails", count);
+    sLog.outString(">> Expired mails: %zu deleted, %zu returned, %u skipped for online receivers", deletedMails.size(), returnedMails.size(), skipped);
     sLog.outString();
 }
 
@@ -6745,7 +6889,7 @@ void ObjectMgr::DeleteCreatureData(uint32 guid)
         RemoveCreatureFromGrid(guid, data);
     }
 
-    mCreatureDataMap.erase(guid);
+    mCreatureDataMap.Erase(guid);
 }
 
 void ObjectMgr::DeleteGOData(uint32 guid)
@@ -6757,7 +6901,7 @@ void ObjectMgr::DeleteGOData(uint32 guid)
         RemoveGameobjectFromGrid(guid, data);
     }
 
-    mGameObjectDataMap.erase(guid);
+    mGameObjectDataMap.Erase(guid);
 }
 
 void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance)
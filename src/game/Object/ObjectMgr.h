@@ -40,9 +40,11 @@
 #include "ObjectGuid.h"
 #include "Policies/Singleton.h"
 #include "ObjectAccessor.h"
+#include "SpawnDataStore.h"
 
 #include <map>
 #include <limits>
+#include <memory>
 
 class Group;
 class Item;
@@ -106,6 +108,43 @@ struct CellObjectGuids
 typedef UNORDERED_MAP < uint32/*cell_id*/, CellObjectGuids > CellObjectGuidsMap;
 typedef UNORDERED_MAP < uint32/*mapid*/, CellObjectGuidsMap > MapObjectGuids;
 
+// static spawns of one cell with their data already looked up, see MapSpawnTemplate
+struct CellSpawnTemplate
+{
+    struct CreatureSpawn
+    {
+        uint32 guid;
+        CreatureData const* data;
+        CreatureInfo const* info;
+    };
+
+    struct GameObjectSpawn
+    {
+        uint32 guid;
+        GameObjectData const* data;
+    };
+
+    std::vector<CreatureSpawn> creatures;
+    std::vector<GameObjectSpawn> gameobjects;
+};
+
+// Static spawns of an instanceable map, resolved once and shared by all instances of the map.
+// Never changed after it is built: a spawn change replaces the template of the map,
+// a grid load in progress keeps using the one it started with.
+struct MapSpawnTemplate
+{
+    typedef UNORDERED_MAP < uint32/*cell_id*/, CellSpawnTemplate > CellSpawns;
+
+    CellSpawnTemplate const* GetCell(uint32 cell_id) const
+    {
+        CellSpawns::const_iterator itr = cells.find(cell_id);
+        return itr != cells.end() ? &itr->second : NULL;
+    }
+
+    CellSpawns cells;                                       // only cells with spawns
+};
+typedef std::shared_ptr<MapSpawnTemplate const> MapSpawnTemplatePtr;
+
 // mangos string ranges
 #define MIN_MANGOS_STRING_ID           1                    // 'mangos_string'
 #define MAX_MANGOS_STRING_ID           2000000000
@@ -128,7 +167,7 @@ struct MangosStringLocale
     uint32 Emote;
 };
 
-typedef UNORDERED_MAP<uint32 /*guid*/, CreatureData> CreatureDataMap;
+typedef SpawnDataStore<CreatureData> CreatureDataMap;
 typedef CreatureDataMap::value_type CreatureDataPair;
 
 typedef std::multimap<uint32 /*mapId*/, uint32 /*guid*/> ActiveCreatureGuidsOnMap;
@@ -154,7 +193,7 @@ class FindCreatureData
         float i_spawnedDist;
 };
 
-typedef UNORDERED_MAP<uint32, GameObjectData> GameObjectDataMap;
+typedef SpawnDataStore<GameObjectData> GameObjectDataMap;
 typedef GameObjectDataMap::value_type GameObjectDataPair;
 
 class FindGOData
@@ -810,6 +849,7 @@ class ObjectMgr
         void LoadStandingList();
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        void ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime);
 
         void SetHighestGuids();
 
@@ -893,12 +933,7 @@ class ObjectMgr
 
         CreatureDataPair const* GetCreatureDataPair(uint32 guid) const
         {
-            CreatureDataMap::const_iterator itr = mCreatureDataMap.find(guid);
-            if (itr == mCreatureDataMap.end())
-            {
-                return NULL;
-            }
-            return &*itr;
+            return mCreatureDataMap.Find(guid);
         }
 
         CreatureData const* GetCreatureData(uint32 guid) const
@@ -909,7 +944,7 @@ class ObjectMgr
 
         CreatureData& NewOrExistCreatureData(uint32 guid)
         {
-            return mCreatureDataMap[guid];
+            return mCreatureDataMap.NewOrExist(guid);
         }
         void DeleteCreatureData(uint32 guid);
 
@@ -1028,12 +1063,7 @@ class ObjectMgr
         LocalTransportGuidsOnMap const* GetLocalTransportGuids() const { return &m_localTransports; }
         GameObjectDataPair const* GetGODataPair(uint32 guid) const
         {
-            GameObjectDataMap::const_iterator itr = mGameObjectDataMap.find(guid);
-            if (itr == mGameObjectDataMap.end())
-            {
-                return NULL;
-            }
-            return &*itr;
+            return mGameObjectDataMap.Find(guid);
         }
 
         GameObjectData const* GetGOData(uint32 guid) const
@@ -1044,7 +1074,7 @@ class ObjectMgr
 
         GameObjectData& NewGOData(uint32 guid)
         {
-            return mGameObjectDataMap[guid];
+            return mGameObjectDataMap.NewOrExist(guid);
         }
         void DeleteGOData(uint32 guid);
 
@@ -1088,6 +1118,9 @@ class ObjectMgr
             return mMapObjectGuids[mapid][cell_id];
         }
 
+        // static spawns of instanceable map, built at first use after any change of the map spawns
+        MapSpawnTemplatePtr GetMapSpawnTemplate(uint32 mapid);
+
         // modifiers for global grid objects state (static DB spawns, global spawn mods from gameevent system)
         // Don't must be used for modify instance specific spawn state modifications
         void AddCreatureToGrid(uint32 guid, CreatureData const* data);
@@ -1339,6 +1372,7 @@ class ObjectMgr
         void LoadQuestRelationsHelper(QuestRelationsMap& map, QuestActor actor, QuestRole role);
         void LoadVendors(char const* tableName, bool isTemplates);
         void LoadTrainers(char const* tableName, bool isTemplates);
+        void ProcessOldMails(QueryResult* result, uint64 basetime, bool serverUp);
 
         void LoadGossipMenu(std::set<uint32>& gossipScriptSet);
         void LoadGossipMenuItems(std::set<uint32>& gossipScriptSet);
@@ -1374,6 +1408,11 @@ class ObjectMgr
         CreatureClassLvlStats m_creatureClassLvlStats[DEFAULT_MAX_CREATURE_LEVEL + 1][MAX_CREATURE_CLASS];
 
         MapObjectGuids mMapObjectGuids;
+
+        // grids of instances load on the map threads, spawn changes come from the world thread
+        typedef UNORDERED_MAP<uint32 /*mapid*/, MapSpawnTemplatePtr> MapSpawnTemplateMap;
+        MapSpawnTemplateMap m_mapSpawnTemplates;
+        ACE_Thread_Mutex m_mapSpawnTemplatesLock;
         ActiveCreatureGuidsOnMap m_activeCreatures;
         LocalTransportGuidsOnMap m_localTransports;
         CreatureDataMap mCreatureDataMap;
@@ -1619,6 +1619,10 @@ void Player::Update(uint32 update_diff, uint32 p_time)
     if (m_playerbotAI)
     {
         m_playerbotAI->UpdateAI(p_time);
+
+        // bot sessions have no socket, so Map::Update does not process their thread-safe packets
+        MapSessionFilter updater(GetSession());
+        GetSession()->HandleBotPackets(updater);
     }
     if (m_playerbotMgr)
     {
@@ -0,0 +1,167 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_SPAWNDATASTORE_H
+#define MANGOS_SPAWNDATASTORE_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/**
+ * Static spawn data (`creature`, `gameobject` rows) by db guid.
+ *
+ * Rows are kept in fixed size chunks instead of one allocation per row, and a
+ * guid indexed slot table replaces the hash. After loading, Sort() puts the rows
+ * of one map cell next to each other, so loading a grid reads them in sequence.
+ *
+ * References stay valid until Sort() is called: rows added later are appended,
+ * a deleted row only leaves the index and keeps its slot.
+ *
+ * The index costs 4 bytes per guid up to the highest one loaded, so it suits the
+ * dense guid ranges of the spawn tables; Sort() briefly holds a second copy of the rows.
+ */
+template<class T>
+class SpawnDataStore
+{
+    public:
+        typedef std::pair<uint32 /*guid*/, T> value_type;
+
+        class const_iterator
+        {
+            public:
+                const_iterator(SpawnDataStore const* store, uint32 slot) : m_store(store), m_slot(slot) { SkipDeleted(); }
+
+                value_type const& operator*() const { return m_store->GetSlot(m_slot); }
+                value_type const* operator->() const { return &m_store->GetSlot(m_slot); }
+                const_iterator& operator++() { ++m_slot; SkipDeleted(); return *this; }
+                bool operator==(const_iterator const& other) const { return m_slot == other.m_slot; }
+                bool operator!=(const_iterator const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                void SkipDeleted()
+                {
+                    while (m_slot < m_store->m_slotCount && !m_store->IsLive(m_slot))
+                    {
+                        ++m_slot;
+                    }
+                }
+
+                SpawnDataStore const* m_store;
+                uint32 m_slot;
+        };
+
+        SpawnDataStore() : m_slotCount(0), m_count(0) {}
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_slotCount); }
+        size_t size() const { return m_count; }
+
+        value_type const* Find(uint32 guid) const
+        {
+            uint32 slot = guid < m_index.size() ? m_index[guid] : 0;
+            return slot ? &GetSlot(slot - 1) : NULL;
+        }
+
+        // same as operator[] of the map it replaces: new rows start value initialized
+        T& NewOrExist(uint32 guid)
+        {
+            if (guid >= m_index.size())
+            {
+                m_index.resize(std::max<size_t>(guid + 1, m_index.size() + m_index.size() / 2), 0);
+            }
+
+            if (uint32 slot = m_index[guid])
+            {
+                return GetSlot(slot - 1).second;
+            }
+
+            value_type& row = AppendSlot();
+            row.first = guid;
+            row.second = T();
+            m_index[guid] = m_slotCount;
+            ++m_count;
+            return row.second;
+        }
+
+        void Erase(uint32 guid)
+        {
+            if (guid < m_index.size() && m_index[guid])
+            {
+                m_index[guid] = 0;
+                --m_count;
+            }
+        }
+
+        // rewrite the rows in the given order, dropping deleted ones; invalidates references
+        template<class Less>
+        void Sort(Less less)
+        {
+            std::vector<value_type> rows;
+            rows.reserve(m_count);
+            for (const_iterator itr = begin(); itr != end(); ++itr)
+            {
+                rows.push_back(*itr);
+            }
+
+            std::sort(rows.begin(), rows.end(), less);
+
+            m_chunks.clear();
+            m_slotCount = 0;
+            std::fill(m_index.begin(), m_index.end(), 0);
+
+            for (typename std::vector<value_type>::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+            {
+                AppendSlot() = *itr;
+                m_index[itr->first] = m_slotCount;
+            }
+        }
+
+    private:
+        static uint32 const CHUNK_SIZE = 1024;
+
+        value_type& GetSlot(uint32 slot) { return m_chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE]; }
+        value_type const& GetSlot(uint32 slot) const { return m_chunks[slot / CHUNK_SIZE][slot % CHUNK_SIZE]; }
+        bool IsLive(uint32 slot) const { return m_index[GetSlot(slot).first] == slot + 1; }
+
+        value_type& AppendSlot()
+        {
+            if (m_slotCount == m_chunks.size() * CHUNK_SIZE)
+            {
+                m_chunks.push_back(std::unique_ptr<value_type[]>(new value_type[CHUNK_SIZE]));
+            }
+
+            return GetSlot(m_slotCount++);
+        }
+
+        std::vector<std::unique_ptr<value_type[]> > m_chunks;
+        std::vector<uint32> m_index;                        // guid -> slot + 1, 0 for none
+        uint32 m_slotCount;
+        uint32 m_count;
+};
+
+#endif
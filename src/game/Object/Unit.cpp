@@ -9412,6 +9412,9 @@ void Unit::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
+    // pending relocation notify stays with the old map, reschedule at next AddToWorld
+    m_AINotifyScheduled = false;
+
 #ifdef ENABLE_ELUNA
     // if multistate, delete elunaEvents and set to nullptr. events shouldn't move across states.
     // in single state, the timed events should move across maps
@@ -11034,45 +11037,12 @@ SpellAuraHolder* Unit::GetSpellAuraHolder(uint32 spellid, ObjectGuid casterGuid)
     return NULL;
 }
 
-class RelocationNotifyEvent : public BasicEvent
-{
-    public:
-        RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
-        {
-            m_owner._SetAINotifyScheduled(true);
-        }
-
-        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
-        {
-            float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-            if (m_owner.GetTypeId() == TYPEID_PLAYER)
-            {
-                MaNGOS::PlayerRelocationNotifier notify((Player&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            else // if (m_owner.GetTypeId() == TYPEID_UNIT)
-            {
-                MaNGOS::CreatureRelocationNotifier notify((Creature&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            m_owner._SetAINotifyScheduled(false);
-            return true;
-        }
-
-        void Abort(uint64)
-        {
-            m_owner._SetAINotifyScheduled(false);
-        }
-
-    private:
-        Unit& m_owner;
-};
-
 void Unit::ScheduleAINotify(uint32 delay)
 {
-    if (!IsAINotifyScheduled())
+    if (!IsAINotifyScheduled() && IsInWorld())
     {
-        m_Events.AddEvent(new RelocationNotifyEvent(*this), m_Events.CalculateTime(delay));
+        m_AINotifyScheduled = true;
+        GetMap()->ScheduleRelocationNotify(this, delay);
     }
 }
 
@@ -11089,8 +11059,7 @@ void Unit::OnRelocated()
         m_last_notified_position.y = GetPositionY();
         m_last_notified_position.z = GetPositionZ();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
-        UpdateObjectVisibility();
+        GetMap()->ScheduleVisibilityUpdate(this);
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
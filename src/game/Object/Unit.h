@@ -3751,7 +3751,7 @@ class Unit : public WorldObject
 
         void ScheduleAINotify(uint32 delay);
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
-        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
+        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from Map::ProcessRelocationNotifies
         void OnRelocated();
 
         bool IsLinkingEventTrigger() { return m_isCreatureLinkingTrigger; }
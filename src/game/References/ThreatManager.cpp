@@ -31,6 +31,8 @@
 #include "ObjectAccessor.h"
 #include "UnitEvents.h"
 
+#include <algorithm>
+
 //==============================================================
 //================= ThreatCalcHelper ===========================
 //==============================================================
@@ -235,6 +237,25 @@ Unit* HostileReference::getSourceUnit()
 //================ ThreatContainer ===========================
 //============================================================
 
+static bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
+{
+    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
+}
+
+//============================================================
+// Keep the order of the others, the list is only sorted in update()
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    ThreatList::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), pRef);
+    if (itr != iThreatList.end())
+    {
+        iThreatList.erase(itr);
+    }
+}
+
+//============================================================
+
 void ThreatContainer::clearReferences()
 {
     for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
@@ -295,21 +316,24 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 }
 
 //============================================================
-
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
-{
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
-}
-
-//============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list is dirty and sort if necessary.
+// The threat changes of one tick only move a few references, so an insertion sort
+// over the contiguous list is close to a single pass. It is stable like the list sort it replaces.
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        for (ThreatList::iterator itr = iThreatList.begin() + 1; itr != iThreatList.end(); ++itr)
+        {
+            HostileReference* ref = *itr;
+            ThreatList::iterator pos = itr;
+            for (; pos != iThreatList.begin() && HostileReferenceSortPredicate(ref, *(pos - 1)); --pos)
+            {
+                *pos = *(pos - 1);
+            }
+            *pos = ref;
+        }
     }
     iDirty = false;
 }
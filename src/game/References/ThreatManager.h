@@ -30,7 +30,7 @@
 #include "Utilities/LinkedReference/Reference.h"
 #include "UnitEvents.h"
 #include "ObjectGuid.h"
-#include <list>
+#include <vector>
 
 //==============================================================
 
@@ -137,7 +137,10 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// Sorted by threat, highest first, as of the last ThreatContainer::update(). Threat changes only
+// mark the list dirty, so threat can be changed while iterating over a ThreatList; adding or
+// removing references (a new victim, modifyThreatPercent below -100) must not be done meanwhile.
+typedef std::vector<HostileReference*> ThreatList;
 
 class ThreatContainer
 {
@@ -147,7 +150,7 @@ class ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
+        void remove(HostileReference* pRef);
         void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
         void clearReferences();
         // Sort the list if necessary
@@ -373,7 +373,8 @@ bool WorldSession::Update(PacketFilter& updater)
     }
 
 #ifdef ENABLE_PLAYERBOTS
-    if (GetPlayer() && GetPlayer()->GetPlayerbotMgr())
+    // bots process their thread-safe packets in their own Player::Update, the rest belongs to the world thread
+    if (updater.ProcessLogout() && GetPlayer() && GetPlayer()->GetPlayerbotMgr())
     {
         GetPlayer()->GetPlayerbotMgr()->UpdateSessions(0);
     }
@@ -419,10 +420,10 @@ bool WorldSession::Update(PacketFilter& updater)
 }
 
 #ifdef ENABLE_PLAYERBOTS
-void WorldSession::HandleBotPackets()
+void WorldSession::HandleBotPackets(PacketFilter& updater)
 {
     WorldPacket* packet;
-    while (_recvQueue.next(packet))
+    while (_recvQueue.next(packet, updater))
     {
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
         (this->*opHandle.handler)(*packet);
@@ -587,6 +588,7 @@ void WorldSession::LogoutPlayer(bool Save)
             }
 
             guild->BroadcastEvent(GE_SIGNED_OFF, _player->GetObjectGuid(), _player->GetName());
+            guild->MemberLoggedOut(_player->GetObjectGuid());
         }
 
         ///- Remove pet
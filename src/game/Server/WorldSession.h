@@ -729,7 +729,7 @@ class WorldSession
         void HandleSetTaxiBenchmarkOpcode(WorldPacket& recv_data);
 
 #ifdef ENABLE_PLAYERBOTS
-        void HandleBotPackets();
+        void HandleBotPackets(PacketFilter& updater);
 #endif
 
         // for Warden
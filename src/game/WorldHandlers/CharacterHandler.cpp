@@ -786,6 +786,12 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
     sObjectAccessor.AddObject(pCurrChar);
     DEBUG_LOG("Player %s added to map %i", pCurrChar->GetName(), pCurrChar->GetMapId());
 
+    /* From now on guild broadcasts reach the player */
+    if (Guild* guild = sGuildMgr.GetGuildById(pCurrChar->GetGuildId()))
+    {
+        guild->MemberLoggedIn(pCurrChar);
+    }
+
     /* send the player's social lists */
     pCurrChar->GetSocial()->SendFriendList();
     pCurrChar->GetSocial()->SendIgnoreList();
@@ -838,7 +838,7 @@ TerrainInfo::~TerrainInfo()
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
 }
 
-GridMap* TerrainInfo::Load(const uint32 x, const uint32 y)
+GridMap* TerrainInfo::Load(const uint32 x, const uint32 y, GridMap* preloaded /*= NULL*/)
 {
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
@@ -850,7 +850,11 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y)
     GridMap* pMap = m_GridMaps[x][y];
     if (!pMap)
     {
-        pMap = LoadMapAndVMap(x, y);
+        pMap = LoadMapAndVMap(x, y, preloaded);
+    }
+    else
+    {
+        delete preloaded;
     }
 
     return pMap;
@@ -1282,7 +1286,27 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y)
     return pMap;
 }
 
-GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
+GridMap* TerrainInfo::LoadGridMapFile(const uint32 x, const uint32 y) const
+{
+    GridMap* map = new GridMap();
+
+    // map file name
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+
+    if (!map->loadData(tmp))
+    {
+        sLog.outError("Error load map file: \n %s\n", tmp);
+        // ASSERT(false);
+    }
+
+    delete[] tmp;
+    return map;
+}
+
+GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, GridMap* preloaded /*= NULL*/)
 {
     // double checked lock pattern
     if (!m_GridMaps[x][y])
@@ -1291,22 +1315,7 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 
         if (!m_GridMaps[x][y])
         {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
-
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: \n %s\n", tmp);
-                // ASSERT(false);
-            }
-
-            delete[] tmp;
-            m_GridMaps[x][y] = map;
+            m_GridMaps[x][y] = preloaded ? preloaded : LoadGridMapFile(x, y);
 
             // load VMAPs for current map/grid...
             const MapEntry* i_mapEntry = sMapStore.LookupEntry(m_mapId);
@@ -1329,6 +1338,14 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
             // load navmesh
             MMAP::MMapFactory::createOrGetMMapManager()->loadMap(m_mapId, x, y);
         }
+        else
+        {
+            delete preloaded;
+        }
+    }
+    else
+    {
+        delete preloaded;
     }
 
     return  m_GridMaps[x][y];
@@ -255,8 +255,9 @@ class TerrainInfo : public Referencable<AtomicLong>
 
     protected:
         friend class Map;
-        // load/unload terrain data
-        GridMap* Load(const uint32 x, const uint32 y);
+        friend class GridPreloader;
+        // load/unload terrain data, a GridMap read in advance by GridPreloader can be handed over
+        GridMap* Load(const uint32 x, const uint32 y, GridMap* preloaded = NULL);
         void Unload(const uint32 x, const uint32 y);
 
     private:
@@ -264,7 +265,9 @@ class TerrainInfo : public Referencable<AtomicLong>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y);
-        GridMap* LoadMapAndVMap(const uint32 x, const uint32 y);
+        GridMap* LoadMapAndVMap(const uint32 x, const uint32 y, GridMap* preloaded = NULL);
+        // only reads the map file, touches no shared state so it is safe from any thread
+        GridMap* LoadGridMapFile(const uint32 x, const uint32 y) const;
 
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
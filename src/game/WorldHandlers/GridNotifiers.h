@@ -115,7 +115,12 @@ namespace MaNGOS
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32& diff) : i_timeDiff(diff) {}
+        uint32 i_reducedInterval;                           // update interval of creatures far from players, 0 for full rate everywhere
+        bool i_reducedRate;                                 // the visited cell is far from all players
+        uint32 i_updatedCount;
+        uint32 i_skippedCount;
+        explicit ObjectUpdater(const uint32& diff, uint32 reducedInterval = 0) : i_timeDiff(diff), i_reducedInterval(reducedInterval),
+            i_reducedRate(false), i_updatedCount(0), i_skippedCount(0) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
@@ -126,7 +131,8 @@ namespace MaNGOS
     struct PlayerRelocationNotifier
     {
         Player& i_player;
-        PlayerRelocationNotifier(Player& pl) : i_player(pl) {}
+        GuidSet const* i_skip;                              // units whose pair with i_player was already handled
+        PlayerRelocationNotifier(Player& pl, GuidSet const* skip = NULL) : i_player(pl), i_skip(skip) {}
         template<class T> void Visit(GridRefManager<T>&) {}
         void Visit(CreatureMapType&);
     };
@@ -134,7 +140,8 @@ namespace MaNGOS
     struct CreatureRelocationNotifier
     {
         Creature& i_creature;
-        CreatureRelocationNotifier(Creature& c) : i_creature(c) {}
+        GuidSet const* i_skip;                              // units whose pair with i_creature was already handled
+        CreatureRelocationNotifier(Creature& c, GuidSet const* skip = NULL) : i_creature(c), i_skip(skip) {}
         template<class T> void Visit(GridRefManager<T>&) {}
 #ifdef WIN32
         template<> void Visit(PlayerMapType&);
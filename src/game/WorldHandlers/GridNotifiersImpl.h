@@ -48,11 +48,28 @@ inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        WorldObject::UpdateHelper helper(iter->getSource());
-        helper.Update(i_timeDiff);
+        Creature* creature = iter->getSource();
+
+        // far from players: update once per interval, with the diffs accumulated meanwhile
+        if (i_reducedRate && i_reducedInterval && creature->CanUpdateAtReducedRate() &&
+            creature->GetSkippedUpdateTime() + i_timeDiff < i_reducedInterval)
+        {
+            creature->SkipUpdate(i_timeDiff);
+            ++i_skippedCount;
+            continue;
+        }
+
+        ++i_updatedCount;
+        WorldObject::UpdateHelper helper(creature);
+        helper.Update(i_timeDiff + creature->TakeSkippedUpdateTime());
     }
 }
 
+inline bool IsRelocationPairHandled(GuidSet const* skip, Unit const* other)
+{
+    return skip && !skip->empty() && skip->find(other->GetObjectGuid()) != skip->end();
+}
+
 inline void PlayerCreatureRelocationWorker(Player* pl, Creature* c)
 {
     // Creature AI reaction
@@ -94,7 +111,7 @@ inline void MaNGOS::PlayerRelocationNotifier::Visit(CreatureMapType& m)
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->getSource();
-        if (c->IsAlive())
+        if (c->IsAlive() && !IsRelocationPairHandled(i_skip, c))
         {
             PlayerCreatureRelocationWorker(&i_player, c);
         }
@@ -112,7 +129,7 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(PlayerMapType& m)
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Player* player = iter->getSource();
-        if (player->IsAlive() && !player->IsTaxiFlying())
+        if (player->IsAlive() && !player->IsTaxiFlying() && !IsRelocationPairHandled(i_skip, player))
         {
             PlayerCreatureRelocationWorker(player, &i_creature);
         }
@@ -130,7 +147,7 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType& m)
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->getSource();
-        if (c != &i_creature && c->IsAlive())
+        if (c != &i_creature && c->IsAlive() && !IsRelocationPairHandled(i_skip, c))
         {
             CreatureCreatureRelocationWorker(c, &i_creature);
         }
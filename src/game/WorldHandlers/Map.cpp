@@ -44,6 +44,7 @@
 #include "Weather.h"
 #include "Transports.h"
 #include "ObjectGridLoader.h"
+#include "movement/MoveSpline.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -71,6 +72,15 @@ Map::~Map()
     eluna = nullptr;
 #endif /* ENABLE_ELUNA */
 
+    // drop terrain prepared in background but never committed
+    m_gridPreloader.wait();
+    GridPreloader::PreparedGrids prepared;
+    m_gridPreloader.take_prepared(prepared);
+    for (GridPreloader::PreparedGrids::const_iterator itr = prepared.begin(); itr != prepared.end(); ++itr)
+    {
+        delete itr->map;
+    }
+
     UnloadAll(true);
 
     if (!m_scriptSchedule.empty())
@@ -124,7 +134,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(NULL)
+      i_data(NULL), m_relocationNotifyClock(0), m_gridPreloader(m_TerrainData)
 {
 #ifdef ENABLE_ELUNA
     // lua state begins uninitialized
@@ -337,9 +347,15 @@ bool Map::EnsureGridLoaded(const Cell& cell)
         // active object A(loaded with loader.LoadN call and added to the  map)
         // summons some active object B, while B added to map grid loading called again and so on..
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+        uint32 loadStart = getMSTime();
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
 
+        if (Instanceable())
+        {
+            sMapMgr.GetInstanceGridLoadTimes().Add(getMSTimeDiff(loadStart, getMSTime()));
+        }
+
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(), cell.GridY()), (*grid)(cell.CellX(), cell.CellY()), this);
         return true;
@@ -348,6 +364,134 @@ bool Map::EnsureGridLoaded(const Cell& cell)
     return false;
 }
 
+/**
+ * Request preloading of grids the player is going to reach in the next GridPreload.LookAhead seconds.
+ * Flight paths are known in advance, for other movement the current speed and facing is used.
+ */
+void Map::PreloadGridsAhead(Player* player)
+{
+    if (!GridPreloader::activated())
+    {
+        return;
+    }
+
+    uint32 lookAhead = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD);
+    if (!lookAhead)
+    {
+        return;
+    }
+
+    if (player->IsTaxiFlying())
+    {
+        if (!player->movespline->Initialized() || player->movespline->Finalized())
+        {
+            return;
+        }
+
+        // spline lengths are stored in milliseconds
+        Movement::MoveSpline::MySpline const& spline = player->movespline->_Spline();
+        int32 current = player->movespline->_currentSplineIdx();
+        for (int32 i = current + 1; i <= spline.last(); ++i)
+        {
+            if (spline.length(current, i) > int32(lookAhead * IN_MILLISECONDS))
+            {
+                break;
+            }
+
+            RequestGridPreload(spline.getPoint(i).x, spline.getPoint(i).y);
+        }
+        return;
+    }
+
+    if (!player->m_movementInfo.HasMovementFlag(MOVEFLAG_FORWARD))
+    {
+        return;
+    }
+
+    // grid must be ready before visibility reaches it, not the player
+    float distance = player->GetSpeed(MOVE_RUN) * lookAhead + GetVisibilityDistance();
+    float angle = player->GetOrientation();
+    for (float step = SIZE_OF_GRIDS / 2; step < distance + SIZE_OF_GRIDS / 2; step += SIZE_OF_GRIDS / 2)
+    {
+        float d = std::min(step, distance);
+        RequestGridPreload(player->GetPositionX() + d * cos(angle), player->GetPositionY() + d * sin(angle));
+    }
+}
+
+void Map::RequestGridPreload(float x, float y)
+{
+    GridPair p = MaNGOS::ComputeGridPair(x, y);
+    if (p.x_coord >= MAX_NUMBER_OF_GRIDS || p.y_coord >= MAX_NUMBER_OF_GRIDS || loaded(p))
+    {
+        return;
+    }
+
+    if (!m_preloadRequested.insert(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord).second)
+    {
+        return;
+    }
+
+    // z coord
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+    // terrain already here, only the objects are missing
+    if (m_bLoadedGrids[gx][gy])
+    {
+        m_preloadObjectGrids.push_back(p);
+    }
+    else if (!m_gridPreloader.schedule_preload(gx, gy))
+    {
+        m_preloadRequested.erase(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord);
+    }
+}
+
+/**
+ * Take over the terrain read in background (vmaps and mmaps are loaded here, on the map thread)
+ * and spawn the objects of up to GridPreload.GridsPerUpdate preloaded grids. Called at the start
+ * of the map update.
+ */
+void Map::CommitPreloadedGrids()
+{
+    GridPreloader::PreparedGrids prepared;
+    m_gridPreloader.take_prepared(prepared);
+
+    for (GridPreloader::PreparedGrids::const_iterator itr = prepared.begin(); itr != prepared.end(); ++itr)
+    {
+        uint32 gx = itr->gx;
+        uint32 gy = itr->gy;
+
+        // loaded by the map meantime
+        if (m_bLoadedGrids[gx][gy])
+        {
+            delete itr->map;
+        }
+        else if (m_TerrainData->Load(gx, gy, itr->map))
+        {
+            m_bLoadedGrids[gx][gy] = true;
+        }
+
+        GridPair p((MAX_NUMBER_OF_GRIDS - 1) - gx, (MAX_NUMBER_OF_GRIDS - 1) - gy);
+        EnsureGridCreated(p);
+        m_preloadObjectGrids.push_back(p);
+    }
+
+    for (uint32 count = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_GRIDS_PER_UPDATE); count && !m_preloadObjectGrids.empty(); --count)
+    {
+        GridPair p = m_preloadObjectGrids.front();
+        m_preloadObjectGrids.pop_front();
+        m_preloadRequested.erase(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord);
+
+        if (loaded(p))
+        {
+            continue;
+        }
+
+        Cell cell(CellPair(p.x_coord * MAX_NUMBER_OF_CELLS + MAX_NUMBER_OF_CELLS / 2, p.y_coord * MAX_NUMBER_OF_CELLS + MAX_NUMBER_OF_CELLS / 2));
+        EnsureGridLoadedAtEnter(cell);
+    }
+}
+
 void Map::ForceLoadGrid(float x, float y)
 {
     if (!IsLoaded(x, y))
@@ -536,7 +680,7 @@ bool Map::loaded(const GridPair& p) const
     return (getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord));
 }
 
-void Map::VisitNearbyCellsOf(WorldObject* obj,
+void Map::VisitNearbyCellsOf(WorldObject* obj, MaNGOS::ObjectUpdater& updater,
                              TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor,
                              TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
 {
@@ -561,6 +705,7 @@ void Map::VisitNearbyCellsOf(WorldObject* obj,
                 CellPair pair(x, y);
                 Cell cell(pair);
                 cell.SetNoCreate();
+                updater.i_reducedRate = !m_fullRateCells.test(cell_id);
                 Visit(cell, gridVisitor);
                 Visit(cell, worldVisitor);
             }
@@ -568,10 +713,35 @@ void Map::VisitNearbyCellsOf(WorldObject* obj,
     }
 }
 
+void Map::MarkFullRateCells(float distance)
+{
+    m_fullRateCells.reset();
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* plr = itr->getSource();
+        if (!plr || !plr->IsInWorld() || !plr->IsPositionValid())
+        {
+            continue;
+        }
+
+        CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), distance);
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                m_fullRateCells.set((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x);
+            }
+        }
+    }
+}
+
 void Map::Update(const uint32& t_diff)
 {
     m_dyn_tree.update(t_diff);
 
+    CommitPreloadedGrids();
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -606,7 +776,15 @@ void Map::Update(const uint32& t_diff)
     /// update active cells around players and active objects
     resetMarkedCells();
 
-    MaNGOS::ObjectUpdater updater(t_diff);
+    // creatures far from all players update at a reduced rate
+    uint32 reducedInterval = 0;
+    if (float reducedDistance = sWorld.getConfig(CONFIG_FLOAT_CREATURE_REDUCED_UPDATE_DISTANCE))
+    {
+        reducedInterval = sWorld.getConfig(CONFIG_UINT32_CREATURE_REDUCED_UPDATE_INTERVAL);
+        MarkFullRateCells(reducedDistance);
+    }
+
+    MaNGOS::ObjectUpdater updater(t_diff, reducedInterval);
     // for creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
@@ -623,7 +801,9 @@ void Map::Update(const uint32& t_diff)
             continue;
         }
 
-        VisitNearbyCellsOf(plr, grid_object_update, world_object_update);
+        VisitNearbyCellsOf(plr, updater, grid_object_update, world_object_update);
+
+        PreloadGridsAhead(plr);
 
         // Collect and remove references to creatures too far away from player's m_HostileRefManager
         // Combat state will change on next tick, if case
@@ -652,7 +832,7 @@ void Map::Update(const uint32& t_diff)
 
                 href.deleteReference(*it);
 
-                VisitNearbyCellsOf(*it, grid_object_update, world_object_update);
+                VisitNearbyCellsOf(*it, updater, grid_object_update, world_object_update);
             }
         }
     }
@@ -674,10 +854,18 @@ void Map::Update(const uint32& t_diff)
                 continue;
             }
 
-            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(obj, updater, grid_object_update, world_object_update);
         }
     }
 
+    if (reducedInterval)
+    {
+        sMapMgr.AddCreatureUpdateCounts(updater.i_updatedCount, updater.i_skippedCount);
+    }
+
+    // AI reactions and visibility for everything that moved during this tick
+    ProcessRelocationNotifies(t_diff);
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -696,6 +884,7 @@ void Map::Update(const uint32& t_diff)
     }
 
     ///- Process necessary scripts
+    m_scriptSchedule.Update(t_diff);
     if (!m_scriptSchedule.empty())
     {
         ScriptsProcess();
@@ -1043,6 +1232,104 @@ const char* Map::GetMapName() const
     return i_mapEntry ? i_mapEntry->name[sWorld.GetDefaultDbcLocale()] : "UNNAMEDMAP\x0";
 }
 
+void Map::ScheduleRelocationNotify(Unit* unit, uint32 delay)
+{
+    m_relocationNotifyQueue.push_back(RelocationNotifyEntry(unit->GetObjectGuid(), m_relocationNotifyClock + delay));
+}
+
+void Map::ScheduleVisibilityUpdate(Unit* unit)
+{
+    m_relocatedVisibility.insert(unit->GetObjectGuid());
+}
+
+/**
+ * Process relocation work collected during the map update.
+ *
+ * Visibility is updated once per moved unit, however often it was relocated in this tick.
+ * AI notifies of all due units are handled in one sweep: a pair of nearby movers is only
+ * checked by the first of them, the second one skips it. At most Visibility.RelocationNotifyBudget
+ * units are notified per tick, the rest wait in the queue for the next one.
+ */
+void Map::ProcessRelocationNotifies(uint32 diff)
+{
+    m_relocationNotifyClock += diff;
+
+    if (!m_relocatedVisibility.empty())
+    {
+        GuidSet relocated;
+        relocated.swap(m_relocatedVisibility);
+
+        for (GuidSet::const_iterator itr = relocated.begin(); itr != relocated.end(); ++itr)
+        {
+            Unit* unit = GetUnit(*itr);
+            if (!unit || !unit->IsInWorld())
+            {
+                continue;
+            }
+
+            unit->GetViewPoint().Call_UpdateVisibilityForOwner();
+            unit->UpdateObjectVisibility();
+        }
+    }
+
+    if (m_relocationNotifyQueue.empty())
+    {
+        return;
+    }
+
+    uint32 budget = World::GetRelocationNotifyBudget();
+
+    std::vector<Unit*> movers;
+    GuidSet moverGuids;
+    RelocationNotifyQueue delayed;
+
+    for (RelocationNotifyQueue::const_iterator itr = m_relocationNotifyQueue.begin(); itr != m_relocationNotifyQueue.end(); ++itr)
+    {
+        // not due yet or over this tick's budget
+        if (int32(itr->dueTime - m_relocationNotifyClock) > 0 || (budget && movers.size() >= budget))
+        {
+            delayed.push_back(*itr);
+            continue;
+        }
+
+        // left the map meantime, it is rescheduled at next AddToWorld
+        Unit* unit = GetUnit(itr->guid);
+        if (!unit || !unit->IsInWorld())
+        {
+            continue;
+        }
+
+        unit->_SetAINotifyScheduled(false);
+        if (moverGuids.insert(itr->guid).second)
+        {
+            movers.push_back(unit);
+        }
+    }
+
+    m_relocationNotifyQueue.swap(delayed);
+
+    float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+
+    // movers already processed in this sweep, pairs with them are done
+    GuidSet notified;
+    for (std::vector<Unit*>::const_iterator itr = movers.begin(); itr != movers.end(); ++itr)
+    {
+        Unit* unit = *itr;
+        if (unit->GetTypeId() == TYPEID_PLAYER)
+        {
+            MaNGOS::PlayerRelocationNotifier notify((Player&)*unit, &notified);
+            Cell::VisitAllObjects(unit, notify, radius);
+        }
+        else
+        {
+            MaNGOS::CreatureRelocationNotifier notify((Creature&)*unit, &notified);
+            Cell::VisitAllObjects(unit, notify, radius);
+        }
+
+        notified.insert(unit->GetObjectGuid());
+    }
+}
+
 void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair)
 {
     cell.SetNoCreate();
@@ -1943,18 +2230,13 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
     ObjectGuid targetGuid = target ? target->GetObjectGuid() : ObjectGuid();
     ObjectGuid ownerGuid  = source->isType(TYPEMASK_ITEM) ? ((Item*)source)->GetOwnerGuid() : ObjectGuid();
 
-    if (execParams)                                         // Check if the execution should be uniquely
+    if (execParams &&                                       // Check if the execution should be uniquely
+        m_scriptSchedule.IsScheduled(type, id,
+                                     (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE) ? sourceGuid : ObjectGuid(),
+                                     (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET) ? targetGuid : ObjectGuid(), ownerGuid))
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
-        {
-            if (searchItr->second.IsSameScript(type, id,
-                                               (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE) ? sourceGuid : ObjectGuid(),
-                                               (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET) ? targetGuid : ObjectGuid(), ownerGuid))
-            {
-                DEBUG_LOG("DB-SCRIPTS: Process table `dbscripts [type=%d]` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", type, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
-                return true;
-            }
-        }
+        DEBUG_LOG("DB-SCRIPTS: Process table `dbscripts [type=%d]` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", type, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
+        return true;
     }
 
     ///- Schedule script execution for all scripts in the script map
@@ -1963,7 +2245,7 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
     {
         ScriptAction sa(type, this, sourceGuid, targetGuid, ownerGuid, &(*iter));
 
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->delay), sa));
+        m_scriptSchedule.Add(iter->delay * IN_MILLISECONDS, sa);
 
         sScriptMgr.IncreaseScheduledScriptsCount();
     }
@@ -1982,7 +2264,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     ScriptAction sa(DBS_INTERNAL, this, sourceGuid, targetGuid, ownerGuid, &script);
 
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+    m_scriptSchedule.Add(delay * IN_MILLISECONDS, sa);
 
     sScriptMgr.IncreaseScheduledScriptsCount();
 }
@@ -1995,40 +2277,20 @@ void Map::ScriptsProcess()
         return;
     }
 
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= sWorld.GetGameTime()))
+    ///- Process overdue queued scripts, in order of due time and scheduling
+    while (ScriptAction const* next = m_scriptSchedule.GetNextDue())
     {
-        if (iter->second.HandleScriptStep())
+        ScriptAction step = *next;                          // the step may schedule further steps
+        if (step.HandleScriptStep())
         {
-            // Terminate following script steps of this script
-            DBScriptType type = iter->second.GetType();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
-
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
-            {
-                if (rmItr->second.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
-                {
-                    m_scriptSchedule.erase(rmItr++);
-                    sScriptMgr.DecreaseScheduledScriptCount();
-                }
-                else
-                {
-                    ++rmItr;
-                }
-            }
+            // Terminate following script steps of this script, this one included
+            sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.Cancel(step.GetType(), step.GetId(), step.GetSourceGuid(), step.GetTargetGuid(), step.GetOwnerGuid()));
         }
-        else
-        {
-            m_scriptSchedule.erase(iter);
 
+        if (m_scriptSchedule.PopDue())
+        {
             sScriptMgr.DecreaseScheduledScriptCount();
         }
-        iter = m_scriptSchedule.begin();
     }
 }
 
@@ -40,13 +40,16 @@
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
 #include "ScriptMgr.h"
+#include "ScriptSchedule.h"
 #include "CreatureLinkingMgr.h"
 #include "DynamicTree.h"
+#include "GridPreloader.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
 
 #include <bitset>
+#include <deque>
 
 struct CreatureInfo;
 class Creature;
@@ -148,6 +151,10 @@ class Map : public GridRefManager<NGridType>
         void PlayerRelocation(Player*, float x, float y, float z, float angl);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float orientation);
 
+        // deferred relocation handling, collected while the map updates and processed once per tick
+        void ScheduleRelocationNotify(Unit* unit, uint32 delay);
+        void ScheduleVisibilityUpdate(Unit* unit);
+
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
         bool IsRemovalGrid(float x, float y) const
@@ -228,6 +235,7 @@ class Map : public GridRefManager<NGridType>
         };
         bool ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* target, ScriptExecutionParam execParams = SCRIPT_EXEC_PARAM_NONE);
         void ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target);
+        ScriptSchedule const& GetScriptSchedule() const { return m_scriptSchedule; }
 
         // must called with AddToWorld
         void AddToActive(WorldObject* obj);
@@ -338,16 +346,25 @@ class Map : public GridRefManager<NGridType>
             return i_grids[x][y];
         }
 
-        void VisitNearbyCellsOf(WorldObject* obj,
+        void VisitNearbyCellsOf(WorldObject* obj, MaNGOS::ObjectUpdater& updater,
                                 TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor,
                                 TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
 
+        // mark cells within CreatureUpdate.ReducedRate.Distance of a player, creatures there update at full rate
+        void MarkFullRateCells(float distance);
+
         bool isGridObjectDataLoaded(uint32 x, uint32 y) const { return getNGrid(x, y)->isGridObjectDataLoaded(); }
         void setGridObjectDataLoaded(bool pLoaded, uint32 x, uint32 y) { getNGrid(x, y)->setGridObjectDataLoaded(pLoaded); }
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
 
+        // predictive grid preloading along player movement
+        void PreloadGridsAhead(Player* player);
+        void RequestGridPreload(float x, float y);
+        void CommitPreloadedGrids();
+        void ProcessRelocationNotifies(uint32 diff);
+
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
 
@@ -377,15 +394,28 @@ class Map : public GridRefManager<NGridType>
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> m_fullRateCells;
 
         std::set<WorldObject*> i_objectsToRemove;
         std::set<Transport*> i_transports;
 
-        typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
-        ScriptScheduleMap m_scriptSchedule;
+        ScriptSchedule m_scriptSchedule;
 
         InstanceData* i_data;
 
+        // Units waiting for their AI relocation notify, due time is in m_relocationNotifyClock units (ms)
+        struct RelocationNotifyEntry
+        {
+            RelocationNotifyEntry(ObjectGuid _guid, uint32 _dueTime) : guid(_guid), dueTime(_dueTime) {}
+
+            ObjectGuid guid;
+            uint32 dueTime;
+        };
+        typedef std::vector<RelocationNotifyEntry> RelocationNotifyQueue;
+        RelocationNotifyQueue m_relocationNotifyQueue;
+        uint32 m_relocationNotifyClock;
+        GuidSet m_relocatedVisibility;                      // units moved far enough to need a visibility update this tick
+
         // Map local low guid counters
         ObjectGuidGenerator<HIGHGUID_UNIT> m_CreatureGuids;
         ObjectGuidGenerator<HIGHGUID_GAMEOBJECT> m_GameObjectGuids;
@@ -404,6 +434,11 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        // Background terrain preparation and grids waiting for their object data
+        GridPreloader m_gridPreloader;
+        std::set<uint32> m_preloadRequested;                // grid ids (x * MAX_NUMBER_OF_GRIDS + y) requested and not yet loaded
+        std::deque<GridPair> m_preloadObjectGrids;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
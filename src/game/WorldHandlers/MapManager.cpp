@@ -82,6 +82,13 @@ MapManager::Initialize()
         abort();
     }
 
+    // Start grid preloading threads if needed.
+    uint32 preload_threads = sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS);
+    if (preload_threads > 0 && GridPreloader::activate(preload_threads) == -1)
+    {
+        abort();
+    }
+
     InitStateMachine();
     InitMaxInstanceId();
 }
@@ -299,6 +306,11 @@ void MapManager::UnloadAll()
         i_maps.erase(i_maps.begin());
     }
 
+    if (GridPreloader::activated())
+    {
+        GridPreloader::deactivate();
+    }
+
     TerrainManager::Instance().UnloadAll();
 
     if (m_updater.activated())
@@ -417,12 +429,16 @@ DungeonMap* MapManager::CreateDungeonMap(uint32 id, uint32 InstanceId, DungeonPe
 
     DEBUG_LOG("MapInstanced::CreateInstanceMap: %s map instance %d for %d created", save ? "" : "new ", InstanceId, id);
 
+    uint32 createStart = getMSTime();
+
     DungeonMap* map = new DungeonMap(id, i_gridCleanUpDelay, InstanceId);
 
     // Dungeons can have saved instance data
     bool load_data = save != NULL;
     map->CreateInstanceData(load_data);
 
+    m_instanceCreateTimes.Add(getMSTimeDiff(createStart, getMSTime()));
+
     return map;
 }
 
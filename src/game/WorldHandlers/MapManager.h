@@ -29,6 +29,9 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include <ace/Recursive_Thread_Mutex.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Guard_T.h>
+#include <ace/Atomic_Op.h>
 #include "Map.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
@@ -36,6 +39,31 @@
 class Transport;
 class BattleGround;
 
+// count, total and worst time of a repeated map operation in ms, filled from the map threads
+class MapTimeStats
+{
+    public:
+        MapTimeStats() : m_count(0), m_total(0), m_max(0) {}
+
+        void Add(uint32 time)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+            ++m_count;
+            m_total += time;
+            m_max = std::max(m_max, time);
+        }
+
+        uint64 GetCount() const { ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0); return m_count; }
+        float GetAverage() const { ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0.0f); return m_count ? float(m_total) / m_count : 0.0f; }
+        uint32 GetMax() const { ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0); return m_max; }
+
+    private:
+        mutable ACE_Thread_Mutex m_lock;
+        uint64 m_count;
+        uint64 m_total;
+        uint32 m_max;
+};
+
 struct MapID
 {
     explicit MapID(uint32 id) : nMapId(id), nInstanceId(0) {}
@@ -157,6 +185,14 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
 
+        // creature updates done and skipped by the reduced update rate far from players, since startup
+        void AddCreatureUpdateCounts(uint32 updated, uint32 skipped) { m_creatureUpdates += updated; m_creatureUpdatesSkipped += skipped; }
+        uint64 GetCreatureUpdateCount() const { return m_creatureUpdates.value(); }
+        uint64 GetSkippedCreatureUpdateCount() const { return m_creatureUpdatesSkipped.value(); }
+
+        // creation of instance maps and loading of their grids, since startup
+        MapTimeStats& GetInstanceCreateTimes() { return m_instanceCreateTimes; }
+        MapTimeStats& GetInstanceGridLoadTimes() { return m_instanceGridLoadTimes; }
 
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
@@ -201,6 +237,12 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         MapUpdater m_updater;
         uint32 i_MaxInstanceId;
 
+        // maps update on several threads
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_creatureUpdates;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_creatureUpdatesSkipped;
+        MapTimeStats m_instanceCreateTimes;
+        MapTimeStats m_instanceGridLoadTimes;
+
         typedef ACE_Recursive_Thread_Mutex LOCK_TYPE;
         mutable LOCK_TYPE m_lock;
 };
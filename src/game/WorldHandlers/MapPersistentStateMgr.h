@@ -29,8 +29,10 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include <ace/Thread_Mutex.h>
+#include <algorithm>
 #include <list>
 #include <map>
+#include <vector>
 #include "Utilities/UnorderedMapSet.h"
 #include "Database/DatabaseEnv.h"
 #include "DBCEnums.h"
@@ -47,7 +49,38 @@ class Player;
 class Group;
 class Map;
 
-typedef std::set<uint32> CellGuidSet;
+// db guids of one cell, sorted in one allocation: cells hold few spawns and change rarely
+class CellGuidSet
+{
+    public:
+        typedef std::vector<uint32>::const_iterator const_iterator;
+
+        void insert(uint32 guid)
+        {
+            std::vector<uint32>::iterator itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr == m_guids.end() || *itr != guid)
+            {
+                m_guids.insert(itr, guid);
+            }
+        }
+
+        void erase(uint32 guid)
+        {
+            std::vector<uint32>::iterator itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr != m_guids.end() && *itr == guid)
+            {
+                m_guids.erase(itr);
+            }
+        }
+
+        const_iterator begin() const { return m_guids.begin(); }
+        const_iterator end() const { return m_guids.end(); }
+        bool empty() const { return m_guids.empty(); }
+        size_t size() const { return m_guids.size(); }
+
+    private:
+        std::vector<uint32> m_guids;
+};
 
 struct MapCellObjectGuids
 {
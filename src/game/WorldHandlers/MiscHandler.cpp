@@ -45,6 +45,7 @@
 #include "OutdoorPvP/OutdoorPvP.h"
 #include "Pet.h"
 #include "SocialMgr.h"
+#include "WhoListIndex.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -126,30 +127,31 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
 
     DEBUG_LOG("Minlvl %u, maxlvl %u, name %s, guild %s, racemask %u, classmask %u, zones %u, strings %u", level_min, level_max, player_name.c_str(), guild_name.c_str(), racemask, classmask, zones_count, str_count);
 
-    std::wstring str[4];                                    // 4 is client limit
+    WhoListQuery query;
+    query.zoneIds.assign(zoneids, zoneids + zones_count);
     for (uint32 i = 0; i < str_count; ++i)
     {
         std::string temp;
         recv_data >> temp;                                  // user entered string, it used as universal search pattern(guild+player name)?
 
-        if (!Utf8toWStr(temp, str[i]))
+        std::wstring wtemp;
+        if (!Utf8toWStr(temp, wtemp))
         {
             continue;
         }
 
-        wstrToLower(str[i]);
+        wstrToLower(wtemp);
+        query.strings.push_back(wtemp);
 
         DEBUG_LOG("String %u: %s", i, temp.c_str());
     }
 
-    std::wstring wplayer_name;
-    std::wstring wguild_name;
-    if (!(Utf8toWStr(player_name, wplayer_name) && Utf8toWStr(guild_name, wguild_name)))
+    if (!(Utf8toWStr(player_name, query.playerName) && Utf8toWStr(guild_name, query.guildName)))
     {
         return;
     }
-    wstrToLower(wplayer_name);
-    wstrToLower(wguild_name);
+    wstrToLower(query.playerName);
+    wstrToLower(query.guildName);
 
     // client send in case not set max level value 100 but mangos support 255 max level,
     // update it to show GMs with characters after 100 level
@@ -158,166 +160,13 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
         level_max = STRONG_MAX_LEVEL;
     }
 
-    Team team = _player->GetTeam();
-    AccountTypes security = GetSecurity();
-    bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
-    AccountTypes gmLevelInWhoList = (AccountTypes)sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST);
+    query.levelMin = level_min;
+    query.levelMax = level_max;
+    query.raceMask = racemask;
+    query.classMask = classmask;
 
-    const uint32 zone = _player->GetCachedZoneId();
-    const bool notInBattleground = !((zone == 2597) || (zone == 3277) || (zone == 3358));
-
-    uint32 matchcount = 0;
-    uint32 displaycount = 0;
-
-    WorldPacket data(SMSG_WHO, 50);                         // guess size
-    data << uint32(matchcount);                             // placeholder, count of players matching criteria
-    data << uint32(displaycount);                           // placeholder, count of players displayed
-
-    sObjectAccessor.DoForAllPlayers([&](Player* pl)
-    {
-        if (security == SEC_PLAYER)
-        {
-            // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
-            if (pl->GetTeam() != team && !allowTwoSideWhoList)
-            {
-                return;
-            }
-
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if (pl->GetSession()->GetSecurity() > gmLevelInWhoList)
-            {
-                return;
-            }
-        }
-
-        // do not process players which are not in world
-        if (!pl->IsInWorld())
-        {
-            return;
-        }
-
-        // check if target is globally visible for player
-        if (!pl->IsVisibleGloballyFor(_player))
-        {
-            return;
-        }
-
-        // check if target's level is in level range
-        uint32 lvl = pl->getLevel();
-        if (lvl < level_min || lvl > level_max)
-        {
-            return;
-        }
-
-        // check if class matches classmask
-        uint32 class_ = pl->getClass();
-        if (!(classmask & (1 << class_)))
-        {
-            return;
-        }
-
-        // check if race matches racemask
-        uint32 race = pl->getRace();
-        if (!(racemask & (1 << race)))
-        {
-            return;
-        }
-
-        uint32 pzoneid = pl->GetZoneId();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                // World of Warcraft Client Patch 1.7.0 (2005-09-13)
-                // Using the / who command while in a Battleground instance will now only display players in your instance.
-                z_show = (zone != pzoneid) || notInBattleground || (_player->GetInstanceId() == pl->GetInstanceId());
-                break;
-            }
-
-            z_show = false;
-        }
-        if (!z_show)
-        {
-            return;
-        }
-
-        std::string pname = pl->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-        {
-            return;
-        }
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-        {
-            return;
-        }
-
-        std::string gname = sGuildMgr.GetGuildNameById(pl->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
-        {
-            return;
-        }
-        wstrToLower(wgname);
-
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-        {
-            return;
-        }
-
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(pzoneid))
-        {
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-        }
-
-        bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
-        {
-            if (!str[i].empty())
-            {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                    wpname.find(str[i]) != std::wstring::npos ||
-                    Utf8FitTo(aname, str[i]))
-                {
-                    s_show = true;
-                    break;
-                }
-                s_show = false;
-            }
-        }
-        if (!s_show)
-        {
-            return;
-        }
-
-        // 49 is maximum player count sent to client
-        if (++matchcount > 49)
-        {
-            return;
-        }
-
-        ++displaycount;
-
-        data << pname;                                      // player name
-        data << gname;                                      // guild name
-        data << uint32(lvl);                                // player level
-        data << uint32(class_);                             // player class
-        data << uint32(race);                               // player race
-        data << uint32(pzoneid);                            // player zone id
-    });
-
-    if (sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS) && matchcount > sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS))
-    {
-        matchcount = sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS);
-    }
-
-    data.put(0, displaycount);                              // insert right count, count displayed
-    data.put(4, matchcount);                                // insert right count, count of matches
+    WorldPacket data;
+    sWhoListIndex.BuildWhoList(_player, query, data);
 
     SendPacket(&data);
     DEBUG_LOG("WORLD: Send SMSG_WHO Message");
@@ -111,6 +111,27 @@ template<> void addUnitState(Creature* obj, CellPair const& cell_pair)
     obj->SetCurrentCell(cell);
 }
 
+template <class T>
+void AddLoadedObject(T* obj, CellPair& cell, Map* map, GridType& grid, BattleGround* bg)
+{
+    grid.AddGridObject(obj);
+
+    addUnitState(obj, cell);
+    obj->SetMap(map);
+    obj->AddToWorld();
+    if (obj->IsActiveObject())
+    {
+        map->AddToActive(obj);
+    }
+
+    obj->GetViewPoint().Event_AddedToWorld(&grid);
+
+    if (bg)
+    {
+        bg->OnObjectDBLoad(obj);
+    }
+}
+
 template <class T>
 void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>& /*m*/, uint32& count, Map* map, GridType& grid)
 {
@@ -128,23 +149,43 @@ void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>&
             continue;
         }
 
-        grid.AddGridObject(obj);
+        AddLoadedObject(obj, cell, map, grid, bg);
+        ++count;
+    }
+}
 
-        addUnitState(obj, cell);
-        obj->SetMap(map);
-        obj->AddToWorld();
-        if (obj->IsActiveObject())
+void LoadHelper(std::vector<CellSpawnTemplate::CreatureSpawn> const& spawns, CellPair& cell, CreatureMapType& /*m*/, uint32& count, Map* map, GridType& grid)
+{
+    BattleGround* bg = map->IsBattleGround() ? ((BattleGroundMap*)map)->GetBG() : nullptr;
+
+    for (std::vector<CellSpawnTemplate::CreatureSpawn>::const_iterator itr = spawns.begin(); itr != spawns.end(); ++itr)
+    {
+        Creature* obj = new Creature;
+        if (!obj->LoadFromDB(itr->guid, map, itr->data, itr->info))
         {
-            map->AddToActive(obj);
+            delete obj;
+            continue;
         }
 
-        obj->GetViewPoint().Event_AddedToWorld(&grid);
+        AddLoadedObject(obj, cell, map, grid, bg);
+        ++count;
+    }
+}
+
+void LoadHelper(std::vector<CellSpawnTemplate::GameObjectSpawn> const& spawns, CellPair& cell, GameObjectMapType& /*m*/, uint32& count, Map* map, GridType& grid)
+{
+    BattleGround* bg = map->IsBattleGround() ? ((BattleGroundMap*)map)->GetBG() : nullptr;
 
-        if (bg)
+    for (std::vector<CellSpawnTemplate::GameObjectSpawn>::const_iterator itr = spawns.begin(); itr != spawns.end(); ++itr)
+    {
+        GameObject* obj = new GameObject;
+        if (!obj->LoadFromDB(itr->guid, map, itr->data))
         {
-            bg->OnObjectDBLoad(obj);
+            delete obj;
+            continue;
         }
 
+        AddLoadedObject(obj, cell, map, grid, bg);
         ++count;
     }
 }
@@ -193,10 +234,19 @@ ObjectGridLoader::Visit(GameObjectMapType& m)
     CellPair cell_pair(x, y);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    CellObjectGuids const& cell_guids = sObjectMgr.GetCellObjectGuids(i_map->GetId(), cell_id);
-
     GridType& grid = (*i_map->getNGrid(i_cell.GridX(), i_cell.GridY()))(i_cell.CellX(), i_cell.CellY());
-    LoadHelper(cell_guids.gameobjects, cell_pair, m, i_gameObjects, i_map, grid);
+    if (i_spawns)
+    {
+        if (CellSpawnTemplate const* cell = i_spawns->GetCell(cell_id))
+        {
+            LoadHelper(cell->gameobjects, cell_pair, m, i_gameObjects, i_map, grid);
+        }
+    }
+    else
+    {
+        CellObjectGuids const& cell_guids = sObjectMgr.GetCellObjectGuids(i_map->GetId(), cell_id);
+        LoadHelper(cell_guids.gameobjects, cell_pair, m, i_gameObjects, i_map, grid);
+    }
     LoadHelper(i_map->GetPersistentState()->GetCellObjectGuids(cell_id).gameobjects, cell_pair, m, i_gameObjects, i_map, grid);
 }
 
@@ -208,10 +258,19 @@ ObjectGridLoader::Visit(CreatureMapType& m)
     CellPair cell_pair(x, y);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    CellObjectGuids const& cell_guids = sObjectMgr.GetCellObjectGuids(i_map->GetId(), cell_id);
-
     GridType& grid = (*i_map->getNGrid(i_cell.GridX(), i_cell.GridY()))(i_cell.CellX(), i_cell.CellY());
-    LoadHelper(cell_guids.creatures, cell_pair, m, i_creatures, i_map, grid);
+    if (i_spawns)
+    {
+        if (CellSpawnTemplate const* cell = i_spawns->GetCell(cell_id))
+        {
+            LoadHelper(cell->creatures, cell_pair, m, i_creatures, i_map, grid);
+        }
+    }
+    else
+    {
+        CellObjectGuids const& cell_guids = sObjectMgr.GetCellObjectGuids(i_map->GetId(), cell_id);
+        LoadHelper(cell_guids.creatures, cell_pair, m, i_creatures, i_map, grid);
+    }
     LoadHelper(i_map->GetPersistentState()->GetCellObjectGuids(cell_id).creatures, cell_pair, m, i_creatures, i_map, grid);
 }
 
@@ -249,6 +308,13 @@ void ObjectGridLoader::LoadN(void)
 {
     i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
     i_cell.data.Part.cell_y = 0;
+
+    // instances share the resolved spawns of their map, others load by guid
+    if (i_map->Instanceable())
+    {
+        i_spawns = sObjectMgr.GetMapSpawnTemplate(i_map->GetId());
+    }
+
     GridLoaderType loader;
 
     for (unsigned int x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
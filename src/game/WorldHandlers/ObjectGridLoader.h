@@ -31,7 +31,10 @@
 #include "GridDefines.h"
 #include "Cell.h"
 
+#include <memory>
+
 class ObjectWorldLoader;
+struct MapSpawnTemplate;
 
 using GridLoaderType = GridLoader<Player, WorldTypeMapContainer, GridTypeMapContainer>;
 
@@ -60,6 +63,7 @@ class ObjectGridLoader
         uint32 i_gameObjects;
         uint32 i_creatures;
         uint32 i_corpses;
+        std::shared_ptr<MapSpawnTemplate const> i_spawns;   // kept for the whole grid even if the map spawns change meanwhile
 };
 
 class ObjectGridUnloader
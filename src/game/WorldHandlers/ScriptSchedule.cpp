@@ -0,0 +1,341 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "ScriptSchedule.h"
+
+#include <algorithm>
+#include <limits>
+
+ScriptSchedule::ScriptSchedule() : m_freeHead(NO_NODE), m_farHead(NO_NODE), m_farMinTick(std::numeric_limits<uint64>::max()),
+    m_duePos(0), m_now(0), m_nextTick(0), m_nextSeq(0), m_count(0), m_peakCount(0), m_executedCount(0)
+{
+    std::fill(m_slots, m_slots + SLOT_COUNT, uint32(NO_NODE));
+}
+
+void ScriptSchedule::Add(uint32 delay, ScriptAction const& action)
+{
+    uint32 index = AllocNode(action);
+    Node& node = m_nodes[index];
+    node.due = m_now + delay;
+    node.seq = m_nextSeq++;
+
+    LinkGuid(m_bySource, action.GetSourceGuid(), m_nodes, &Node::sourceLink, index);
+    LinkGuid(m_byTarget, action.GetTargetGuid(), m_nodes, &Node::targetLink, index);
+
+    // a step due now is due no earlier than the collected ones and added after them, so m_due stays sorted
+    Place(index);
+
+    if (++m_count > m_peakCount)
+    {
+        m_peakCount = m_count;
+    }
+}
+
+void ScriptSchedule::Update(uint32 diff)
+{
+    m_now += diff;
+    uint64 nowTick = m_now / SLOT_MS;
+
+    if (empty())
+    {
+        m_nextTick = nowTick;
+        return;
+    }
+
+    // slots before the current one are drained completely, each slot at most once per call
+    uint64 lastTick = std::min<uint64>(nowTick, m_nextTick + SLOT_COUNT - 1);
+    for (uint64 tick = m_nextTick; tick <= lastTick; ++tick)
+    {
+        uint32& head = m_slots[tick % SLOT_COUNT];
+        for (uint32 index = head; index != NO_NODE;)
+        {
+            uint32 next = m_nodes[index].timeLink.next;
+            if (m_nodes[index].due <= m_now)
+            {
+                UnlinkTime(head, index);
+                Place(index);
+            }
+            index = next;
+        }
+    }
+    m_nextTick = nowTick;
+
+    // move the far steps that came within one turn into the wheel
+    if (m_farHead != NO_NODE && m_farMinTick < m_nextTick + SLOT_COUNT)
+    {
+        uint32 index = m_farHead;
+        m_farHead = NO_NODE;
+        m_farMinTick = std::numeric_limits<uint64>::max();
+
+        while (index != NO_NODE)
+        {
+            uint32 next = m_nodes[index].timeLink.next;
+            m_nodes[index].timeLink = Link();
+            Place(index);
+            index = next;
+        }
+    }
+
+    std::vector<Node> const& nodes = m_nodes;
+    std::sort(m_due.begin() + m_duePos, m_due.end(), [&nodes](DueEntry const& a, DueEntry const& b)
+    {
+        Node const& nodeA = nodes[a.index];
+        Node const& nodeB = nodes[b.index];
+        return nodeA.due != nodeB.due ? nodeA.due < nodeB.due : nodeA.seq < nodeB.seq;
+    });
+}
+
+ScriptAction const* ScriptSchedule::GetNextDue()
+{
+    for (; m_duePos < m_due.size(); ++m_duePos)
+    {
+        DueEntry const& entry = m_due[m_duePos];
+        Node const& node = m_nodes[entry.index];
+        if (node.generation == entry.generation && node.list == LIST_DUE)
+        {
+            return &node.action;
+        }
+    }
+
+    m_due.clear();
+    m_duePos = 0;
+    return NULL;
+}
+
+bool ScriptSchedule::PopDue()
+{
+    MANGOS_ASSERT(m_duePos < m_due.size());
+
+    DueEntry const& entry = m_due[m_duePos++];
+    bool pending = m_nodes[entry.index].generation == entry.generation && m_nodes[entry.index].list == LIST_DUE;
+    if (pending)
+    {
+        Remove(entry.index);
+    }
+
+    ++m_executedCount;
+    return pending;
+}
+
+bool ScriptSchedule::IsScheduled(DBScriptType type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const
+{
+    return FindScript(type, id, sourceGuid, targetGuid, ownerGuid, NULL);
+}
+
+uint32 ScriptSchedule::Cancel(DBScriptType type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid)
+{
+    std::vector<uint32> matches;
+    FindScript(type, id, sourceGuid, targetGuid, ownerGuid, &matches);
+
+    for (std::vector<uint32>::const_iterator itr = matches.begin(); itr != matches.end(); ++itr)
+    {
+        Remove(*itr);
+    }
+
+    return matches.size();
+}
+
+bool ScriptSchedule::FindScript(DBScriptType type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid, std::vector<uint32>* matches) const
+{
+    // without a guid to look up by, every pending step has to be checked
+    if (!sourceGuid && !targetGuid)
+    {
+        for (uint32 index = 0; index < m_nodes.size(); ++index)
+        {
+            Node const& node = m_nodes[index];
+            if (node.list != LIST_FREE && node.action.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
+            {
+                if (!matches)
+                {
+                    return true;
+                }
+                matches->push_back(index);
+            }
+        }
+        return matches && !matches->empty();
+    }
+
+    GuidHeads const& heads = sourceGuid ? m_bySource : m_byTarget;
+    Link Node::* link = sourceGuid ? &Node::sourceLink : &Node::targetLink;
+
+    GuidHeads::const_iterator head = heads.find(sourceGuid ? sourceGuid : targetGuid);
+    if (head == heads.end())
+    {
+        return false;
+    }
+
+    for (uint32 index = head->second; index != NO_NODE; index = (m_nodes[index].*link).next)
+    {
+        if (m_nodes[index].action.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
+        {
+            if (!matches)
+            {
+                return true;
+            }
+            matches->push_back(index);
+        }
+    }
+    return matches && !matches->empty();
+}
+
+uint32 ScriptSchedule::AllocNode(ScriptAction const& action)
+{
+    if (m_freeHead == NO_NODE)
+    {
+        m_nodes.push_back(Node(action));
+        return m_nodes.size() - 1;
+    }
+
+    uint32 index = m_freeHead;
+    Node& node = m_nodes[index];
+    m_freeHead = node.timeLink.next;
+    node.action = action;
+    node.timeLink = Link();
+    return index;
+}
+
+void ScriptSchedule::Place(uint32 index)
+{
+    Node& node = m_nodes[index];
+    uint64 tick = node.due / SLOT_MS;
+
+    if (node.due <= m_now)
+    {
+        node.list = LIST_DUE;
+        m_due.push_back(DueEntry(index, node.generation));
+    }
+    else if (tick < m_nextTick + SLOT_COUNT)
+    {
+        node.list = LIST_WHEEL;
+        LinkTime(m_slots[tick % SLOT_COUNT], index);
+    }
+    else
+    {
+        node.list = LIST_FAR;
+        LinkTime(m_farHead, index);
+        m_farMinTick = std::min(m_farMinTick, tick);
+    }
+}
+
+void ScriptSchedule::Remove(uint32 index)
+{
+    Node& node = m_nodes[index];
+    MANGOS_ASSERT(node.list != LIST_FREE);
+
+    if (node.list != LIST_DUE)                              // due steps leave a stale entry in m_due instead
+    {
+        UnlinkTime(TimeHead(node), index);
+    }
+
+    UnlinkGuid(m_bySource, node.action.GetSourceGuid(), m_nodes, &Node::sourceLink, index);
+    UnlinkGuid(m_byTarget, node.action.GetTargetGuid(), m_nodes, &Node::targetLink, index);
+
+    node.list = LIST_FREE;
+    ++node.generation;
+    node.timeLink.next = m_freeHead;
+    m_freeHead = index;
+
+    --m_count;
+}
+
+uint32& ScriptSchedule::TimeHead(Node const& node)
+{
+    return node.list == LIST_FAR ? m_farHead : m_slots[(node.due / SLOT_MS) % SLOT_COUNT];
+}
+
+void ScriptSchedule::LinkTime(uint32& head, uint32 index)
+{
+    Link& link = m_nodes[index].timeLink;
+    link.prev = NO_NODE;
+    link.next = head;
+    if (head != NO_NODE)
+    {
+        m_nodes[head].timeLink.prev = index;
+    }
+    head = index;
+}
+
+void ScriptSchedule::UnlinkTime(uint32& head, uint32 index)
+{
+    Link& link = m_nodes[index].timeLink;
+    if (link.prev != NO_NODE)
+    {
+        m_nodes[link.prev].timeLink.next = link.next;
+    }
+    else
+    {
+        head = link.next;
+    }
+
+    if (link.next != NO_NODE)
+    {
+        m_nodes[link.next].timeLink.prev = link.prev;
+    }
+    link = Link();
+}
+
+void ScriptSchedule::LinkGuid(GuidHeads& heads, ObjectGuid guid, std::vector<Node>& nodes, Link Node::* link, uint32 index)
+{
+    if (!guid)
+    {
+        return;
+    }
+
+    std::pair<GuidHeads::iterator, bool> inserted = heads.insert(GuidHeads::value_type(guid, index));
+    if (!inserted.second)
+    {
+        uint32 oldHead = inserted.first->second;
+        (nodes[index].*link).next = oldHead;
+        (nodes[oldHead].*link).prev = index;
+        inserted.first->second = index;
+    }
+}
+
+void ScriptSchedule::UnlinkGuid(GuidHeads& heads, ObjectGuid guid, std::vector<Node>& nodes, Link Node::* link, uint32 index)
+{
+    if (!guid)
+    {
+        return;
+    }
+
+    Link& nodeLink = nodes[index].*link;
+    if (nodeLink.prev != NO_NODE)
+    {
+        (nodes[nodeLink.prev].*link).next = nodeLink.next;
+    }
+    else if (nodeLink.next != NO_NODE)
+    {
+        heads[guid] = nodeLink.next;
+    }
+    else
+    {
+        heads.erase(guid);
+    }
+
+    if (nodeLink.next != NO_NODE)
+    {
+        (nodes[nodeLink.next].*link).prev = nodeLink.prev;
+    }
+    nodeLink = Link();
+}
@@ -0,0 +1,177 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_SCRIPTSCHEDULE_H
+#define MANGOS_SCRIPTSCHEDULE_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "ScriptMgr.h"
+#include "Utilities/UnorderedMapSet.h"
+
+#include <vector>
+
+/**
+ * @brief Pending DB script steps of one map, by due time in milliseconds of map time.
+ *
+ * Steps due within one turn of the timing wheel wait in its slots, later ones in a far
+ * list that is only walked when its earliest step comes within reach. Due steps are
+ * handed out in the order of their due time, steps due at the same time in the order
+ * they were added, as the sorted schedule it replaces did.
+ *
+ * Every step is also linked into the lists of its source and target guid, so looking up
+ * or cancelling the steps of a script only visits the steps of that object.
+ */
+class ScriptSchedule
+{
+    public:
+        ScriptSchedule();
+
+        /**
+         * @brief Schedules a script step.
+         * @param delay Delay in milliseconds from now.
+         * @param action The step to execute.
+         */
+        void Add(uint32 delay, ScriptAction const& action);
+
+        /**
+         * @brief Advances the map time and collects the steps that became due.
+         * @param diff Milliseconds passed since the last call.
+         */
+        void Update(uint32 diff);
+
+        /**
+         * @brief Gets the next due step, steps added meanwhile with no delay included.
+         * The step is only valid until the schedule changes.
+         * @return The step, NULL when no step is due.
+         */
+        ScriptAction const* GetNextDue();
+
+        /**
+         * @brief Removes the step returned by GetNextDue, once it was executed.
+         * @return False if the step had already been cancelled while it ran.
+         */
+        bool PopDue();
+
+        /**
+         * @brief Checks if a step of the script is pending. Empty guids match any.
+         */
+        bool IsScheduled(DBScriptType type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const;
+
+        /**
+         * @brief Removes the pending steps of the script. Empty guids match any.
+         * @return The number of removed steps.
+         */
+        uint32 Cancel(DBScriptType type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid);
+
+        bool empty() const { return m_count == 0; }
+        uint32 size() const { return m_count; }
+
+        // statistics for the GM commands
+        uint32 GetPeakSize() const { return m_peakCount; }
+        uint64 GetExecutedCount() const { return m_executedCount; }
+
+    private:
+        enum
+        {
+            SLOT_MS     = 32,                               // time span of one wheel slot
+            SLOT_COUNT  = 512,                              // one turn is about 16 seconds
+            NO_NODE     = 0xFFFFFFFF
+        };
+
+        enum NodeList
+        {
+            LIST_FREE,
+            LIST_WHEEL,
+            LIST_FAR,
+            LIST_DUE
+        };
+
+        struct Link
+        {
+            Link() : prev(NO_NODE), next(NO_NODE) {}
+
+            uint32 prev;
+            uint32 next;
+        };
+
+        struct Node
+        {
+            explicit Node(ScriptAction const& _action) : action(_action), due(0), seq(0), list(LIST_FREE), generation(0) {}
+
+            ScriptAction action;
+            uint64 due;                                     // map time in ms
+            uint64 seq;                                     // order of adding, for steps due at the same time
+            NodeList list;
+            uint32 generation;                              // tells reused nodes from stale m_due entries
+            Link timeLink;                                  // wheel slot or far list, unused while due
+            Link sourceLink;
+            Link targetLink;
+        };
+
+        struct DueEntry
+        {
+            DueEntry(uint32 _index, uint32 _generation) : index(_index), generation(_generation) {}
+
+            uint32 index;
+            uint32 generation;
+        };
+
+        typedef UNORDERED_MAP<ObjectGuid, uint32 /*first node*/> GuidHeads;
+
+        uint32 AllocNode(ScriptAction const& action);
+        void Place(uint32 index);
+        void Remove(uint32 index);
+
+        void LinkTime(uint32& head, uint32 index);
+        void UnlinkTime(uint32& head, uint32 index);
+        uint32& TimeHead(Node const& node);
+
+        static void LinkGuid(GuidHeads& heads, ObjectGuid guid, std::vector<Node>& nodes, Link Node::* link, uint32 index);
+        static void UnlinkGuid(GuidHeads& heads, ObjectGuid guid, std::vector<Node>& nodes, Link Node::* link, uint32 index);
+
+        bool FindScript(DBScriptType type, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid, std::vector<uint32>* matches) const;
+
+        std::vector<Node> m_nodes;
+        uint32 m_freeHead;                                  // free nodes, linked by timeLink.next
+
+        uint32 m_slots[SLOT_COUNT];
+        uint32 m_farHead;
+        uint64 m_farMinTick;                                // earliest due tick in the far list
+        std::vector<DueEntry> m_due;                        // sorted by due time, then seq
+        size_t m_duePos;
+
+        GuidHeads m_bySource;
+        GuidHeads m_byTarget;
+
+        uint64 m_now;
+        uint64 m_nextTick;                                  // first wheel slot not drained completely
+        uint64 m_nextSeq;
+
+        uint32 m_count;
+        uint32 m_peakCount;
+        uint64 m_executedCount;
+};
+
+#endif
@@ -312,6 +312,55 @@ void SpellCastTargets::write(ByteBuffer& data) const
     }
 }
 
+namespace
+{
+    // memory of deleted spells of the current thread, the map update threads cast most spells
+    // plain data without destructor: spells may still be deleted while the process exits
+    struct SpellMemoryPool
+    {
+        static size_t const MAX_BLOCKS = 256;
+
+        void* blocks[MAX_BLOCKS];
+        size_t count;
+    };
+
+    thread_local SpellMemoryPool spellMemoryPool;
+}
+
+ACE_Atomic_Op<ACE_Thread_Mutex, uint64> Spell::m_createdCount(0);
+ACE_Atomic_Op<ACE_Thread_Mutex, uint64> Spell::m_pooledCreatedCount(0);
+
+void* Spell::operator new(size_t size)
+{
+    ++m_createdCount;
+
+    SpellMemoryPool& pool = spellMemoryPool;
+    if (size == sizeof(Spell) && pool.count)
+    {
+        ++m_pooledCreatedCount;
+        return pool.blocks[--pool.count];
+    }
+
+    return ::operator new(size);
+}
+
+void Spell::operator delete(void* p, size_t size)
+{
+    if (!p)
+    {
+        return;
+    }
+
+    SpellMemoryPool& pool = spellMemoryPool;
+    if (size == sizeof(Spell) && pool.count < SpellMemoryPool::MAX_BLOCKS)
+    {
+        pool.blocks[pool.count++] = p;
+        return;
+    }
+
+    ::operator delete(p);
+}
+
 Spell::Spell(Unit* caster, SpellEntry const* info, bool triggered, ObjectGuid originalCasterGUID, SpellEntry const* triggeredBy)
 {
     MANGOS_ASSERT(caster != NULL && info != NULL);
@@ -4467,7 +4516,7 @@ void Spell::TakePower()
             if (m_caster->GetTypeId() == TYPEID_PLAYER)
             {
                 if (powerType == POWER_ENERGY || powerType == POWER_RAGE)
-                    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                    for (TargetList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                         {
                             if (ihit->missCondition != SPELL_MISS_NONE)
                             {
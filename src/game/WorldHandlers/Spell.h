@@ -33,6 +33,10 @@
 #include "LootMgr.h"
 #include "Unit.h"
 #include "Player.h"
+#include "Utilities/InlineVector.h"
+
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
 
 class WorldSession;
 class WorldPacket;
@@ -320,6 +324,12 @@ class Spell
         Spell(Unit* caster, SpellEntry const* info, bool triggered, ObjectGuid originalCasterGUID = ObjectGuid(), SpellEntry const* triggeredBy = NULL);
         ~Spell();
 
+        // a spell object lives for one cast only, memory of deleted ones is reused by the next cast of the thread
+        static void* operator new(size_t size);
+        static void operator delete(void* p, size_t size);
+        static uint64 GetCreatedCount() { return m_createdCount.value(); }
+        static uint64 GetPooledCreatedCount() { return m_pooledCreatedCount.value(); }
+
         SpellCastResult prepare(SpellCastTargets const* targets, Aura* triggeredByAura = NULL, uint32 chance = 0);
 
         void cancel();
@@ -562,9 +572,10 @@ class Spell
             uint8 effectMask;
         };
 
-        typedef std::list<TargetInfo>     TargetList;
-        typedef std::list<GOTargetInfo>   GOTargetList;
-        typedef std::list<ItemTargetInfo> ItemTargetList;
+        // most casts hit a few targets, those stay inside the spell object
+        typedef InlineVector<TargetInfo, 8>     TargetList;
+        typedef InlineVector<GOTargetInfo, 2>   GOTargetList;
+        typedef InlineVector<ItemTargetInfo, 2> ItemTargetList;
 
         TargetList     m_UniqueTargetInfo;
         GOTargetList   m_UniqueGOTargetInfo;
@@ -606,6 +617,10 @@ class Spell
         // we can't store original aura link to prevent access to deleted auras
         // and in same time need aura data and after aura deleting.
         SpellEntry const* m_triggeredByAuraSpell;
+
+        // spells are created on all map threads
+        static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_createdCount;
+        static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_pooledCreatedCount;
 };
 
 enum ReplenishType
@@ -0,0 +1,262 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "StartupLoader.h"
+#include "DelayExecutor.h"
+#include "Log.h"
+#include "Config/Config.h"
+#include "ProgressBar.h"
+#include "Timer.h"
+
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Method_Request.h>
+
+/**
+ * A request to run one stage on a worker thread.
+ */
+class StartupStageRequest : public ACE_Method_Request
+{
+    public:
+        StartupStageRequest(StartupLoader& loader, size_t index, ACE_Condition_Thread_Mutex& condition)
+            : m_loader(loader), m_index(index), m_condition(condition)
+        {
+        }
+
+        virtual int call()
+        {
+            m_loader.RunStage(m_loader.m_stages[m_index]);
+
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_loader.m_mutex, -1);
+            m_loader.m_finished.push_back(m_index);
+            m_condition.broadcast();
+            return 0;
+        }
+
+    private:
+        StartupLoader& m_loader;
+        size_t m_index;
+        ACE_Condition_Thread_Mutex& m_condition;
+};
+
+StartupLoader::StartupLoader() : m_lastBarrier(size_t(-1))
+{
+}
+
+size_t StartupLoader::FindStage(char const* id) const
+{
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        if (m_stages[i].id == id)
+        {
+            return i;
+        }
+    }
+
+    return size_t(-1);
+}
+
+void StartupLoader::AddStage(char const* id, char const* message, LoadFunc const& func, std::initializer_list<char const*> after)
+{
+    MANGOS_ASSERT(FindStage(id) == size_t(-1));
+
+    size_t index = m_stages.size();
+
+    Stage stage;
+    stage.id = id;
+    stage.message = message;
+    stage.func = func;
+    stage.unfinished = 0;
+    stage.duration = 0;
+
+    std::vector<size_t> dependencies;
+    for (std::initializer_list<char const*>::const_iterator itr = after.begin(); itr != after.end(); ++itr)
+    {
+        size_t dependency = FindStage(*itr);
+        if (dependency == size_t(-1))
+        {
+            sLog.outError("StartupLoader: stage '%s' depends on unknown or later declared stage '%s'", id, *itr);
+            MANGOS_ASSERT(false);
+        }
+        dependencies.push_back(dependency);
+    }
+
+    // everything declared after a barrier waits for it
+    if (m_lastBarrier != size_t(-1))
+    {
+        dependencies.push_back(m_lastBarrier);
+    }
+
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+    for (std::vector<size_t>::const_iterator itr = dependencies.begin(); itr != dependencies.end(); ++itr)
+    {
+        m_stages[*itr].dependents.push_back(index);
+    }
+    stage.unfinished = dependencies.size();
+
+    m_stages.push_back(stage);
+}
+
+void StartupLoader::AddBarrier(char const* id, char const* message, LoadFunc const& func)
+{
+    AddStage(id, message, func);
+
+    size_t index = m_stages.size() - 1;
+    size_t first = m_lastBarrier == size_t(-1) ? 0 : m_lastBarrier;
+    for (size_t i = first; i < index; ++i)
+    {
+        if (i == m_lastBarrier)
+        {
+            continue;                                       // already a dependency
+        }
+
+        m_stages[i].dependents.push_back(index);
+        ++m_stages[index].unfinished;
+    }
+
+    m_lastBarrier = index;
+}
+
+void StartupLoader::RunStage(Stage& stage)
+{
+    sLog.outString("%s", stage.message.c_str());
+
+    uint32 startTime = getMSTime();
+    stage.func();
+    stage.duration = getMSTimeDiff(startTime, getMSTime());
+}
+
+void StartupLoader::RunSequential()
+{
+    // declaration order is a valid order, dependencies must be declared earlier
+    for (std::vector<Stage>::iterator itr = m_stages.begin(); itr != m_stages.end(); ++itr)
+    {
+        RunStage(*itr);
+    }
+}
+
+void StartupLoader::RunParallel(uint32 threads)
+{
+    DelayExecutor executor;
+    if (executor._activate(threads) == -1)
+    {
+        sLog.outError("StartupLoader: can't start %u loader threads, loading sequentially", threads);
+        RunSequential();
+        return;
+    }
+
+    // progress bars of concurrent loaders would only garble each other
+    BarGoLink::SetOutputState(false);
+
+    ACE_Condition_Thread_Mutex condition(m_mutex);
+
+    size_t done = 0;
+    size_t running = 0;
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        if (!m_stages[i].unfinished)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    while (done < m_stages.size())
+    {
+        for (std::vector<size_t>::const_iterator itr = ready.begin(); itr != ready.end(); ++itr)
+        {
+            executor.execute(new StartupStageRequest(*this, *itr, condition));
+            ++running;
+        }
+        ready.clear();
+
+        MANGOS_ASSERT(running);                             // nothing running and nothing ready, would never finish
+
+        std::vector<size_t> finished;
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+            while (m_finished.empty())
+            {
+                condition.wait();
+            }
+            finished.swap(m_finished);
+        }
+
+        for (std::vector<size_t>::const_iterator itr = finished.begin(); itr != finished.end(); ++itr)
+        {
+            --running;
+            ++done;
+
+            std::vector<size_t> const& dependents = m_stages[*itr].dependents;
+            for (std::vector<size_t>::const_iterator dep = dependents.begin(); dep != dependents.end(); ++dep)
+            {
+                if (--m_stages[*dep].unfinished == 0)
+                {
+                    ready.push_back(*dep);
+                }
+            }
+        }
+    }
+
+    executor.deactivate();
+
+    BarGoLink::SetOutputState(sConfig.GetBoolDefault("ShowProgressBars", true));
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 startTime = getMSTime();
+
+    if (threads <= 1)
+    {
+        RunSequential();
+    }
+    else
+    {
+        RunParallel(threads);
+    }
+
+    ReportTimes(getMSTimeDiff(startTime, getMSTime()));
+}
+
+void StartupLoader::ReportTimes(uint32 wallTime) const
+{
+    uint32 sumTime = 0;
+    std::vector<std::pair<uint32, size_t> > byDuration;
+    for (size_t i = 0; i < m_stages.size(); ++i)
+    {
+        sumTime += m_stages[i].duration;
+        byDuration.push_back(std::make_pair(m_stages[i].duration, i));
+    }
+    std::sort(byDuration.rbegin(), byDuration.rend());
+
+    sLog.outString();
+    sLog.outString(">> Loaded %u stages in %u ms (%u ms spent in loaders)", uint32(m_stages.size()), wallTime, sumTime);
+    for (std::vector<std::pair<uint32, size_t> >::const_iterator itr = byDuration.begin(); itr != byDuration.end(); ++itr)
+    {
+        sLog.outDetail("   %6u ms  %s", itr->first, m_stages[itr->second].id.c_str());
+    }
+    sLog.outString();
+}
@@ -0,0 +1,98 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_STARTUPLOADER_H
+#define MANGOS_STARTUPLOADER_H
+
+#include "Common.h"
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * Runs the static data loaders of the world startup as a dependency graph.
+ *
+ * Every stage names the stages it needs. With one thread the stages run in declaration
+ * order, exactly like a plain list of calls. With more threads every stage whose
+ * dependencies are finished is started on a worker, so independent loaders overlap
+ * (each picks its own connection from the database pool). A barrier stage waits for
+ * all stages declared before it, and all stages declared after it wait for the barrier.
+ */
+class StartupLoader
+{
+    public:
+        typedef std::function<void()> LoadFunc;
+
+        StartupLoader();
+
+        /**
+         * Declare a stage.
+         *
+         * @param id unique name other stages refer to
+         * @param message printed when the stage starts
+         * @param func the loader
+         * @param after ids of stages which must be finished first, they must be declared earlier
+         */
+        void AddStage(char const* id, char const* message, LoadFunc const& func, std::initializer_list<char const*> after = {});
+
+        /**
+         * Declare a stage that runs alone: after every stage declared so far and before every later one.
+         */
+        void AddBarrier(char const* id, char const* message, LoadFunc const& func);
+
+        /**
+         * Run all stages, reporting the time spent in each.
+         *
+         * @param threads amount of worker threads, 1 or less runs all stages in declaration order
+         */
+        void Run(uint32 threads);
+
+    private:
+        friend class StartupStageRequest;
+
+        struct Stage
+        {
+            std::string id;
+            std::string message;
+            LoadFunc func;
+            std::vector<size_t> dependents;
+            size_t unfinished;                              // dependencies not finished yet
+            uint32 duration;                                // ms
+        };
+
+        size_t FindStage(char const* id) const;
+        void RunStage(Stage& stage);
+        void RunSequential();
+        void RunParallel(uint32 threads);
+        void ReportTimes(uint32 wallTime) const;
+
+        std::vector<Stage> m_stages;
+        size_t m_lastBarrier;                               // index of the last declared barrier
+
+        ACE_Thread_Mutex m_mutex;
+        std::vector<size_t> m_finished;                     // finished in workers, not yet processed by Run
+};
+
+#endif
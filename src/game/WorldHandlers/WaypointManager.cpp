@@ -31,6 +31,8 @@
 #include "ObjectMgr.h"
 #include "ScriptMgr.h"
 
+#include <ace/Guard_T.h>
+
 INSTANTIATE_SINGLETON_1(WaypointManager);
 
 /**
@@ -71,6 +73,74 @@ WaypointBehavior::WaypointBehavior(const WaypointBehavior& b)
     }
 }
 
+/**
+ * Copies the points of the path into one array, in point id order.
+ * @param path The path the route is built for.
+ */
+WaypointRoute::WaypointRoute(WaypointPath const& path)
+{
+    m_points.reserve(path.size());
+    for (WaypointPath::const_iterator itr = path.begin(); itr != path.end(); ++itr)
+    {
+        Point point;
+        point.pointId = itr->first;
+        point.node = itr->second;
+        m_points.push_back(point);
+    }
+
+    m_segments.resize(m_points.size());
+}
+
+/**
+ * Looks up the index of a point, the points are sorted by id.
+ * @param pointId The point ID of the waypoint.
+ * @return the index of the point, size() if it is not in the route.
+ */
+uint32 WaypointRoute::Find(uint32 pointId) const
+{
+    uint32 lo = 0;
+    uint32 hi = m_points.size();
+    while (lo < hi)
+    {
+        uint32 mid = (lo + hi) / 2;
+        if (m_points[mid].pointId < pointId)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo < m_points.size() && m_points[lo].pointId == pointId ? lo : m_points.size();
+}
+
+/**
+ * Gets the spline path a creature took to the point of the given index.
+ * @param index The index of the point.
+ * @return the stored spline path, or an empty pointer.
+ */
+WaypointSegmentPathPtr WaypointRoute::GetSegment(uint32 index) const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_segmentLock, WaypointSegmentPathPtr());
+    return m_segments[index];
+}
+
+/**
+ * Stores the spline path to the point of the given index, unless another creature was faster.
+ * @param index The index of the point.
+ * @param segment The spline path, it must not change anymore.
+ */
+void WaypointRoute::SetSegment(uint32 index, WaypointSegmentPathPtr const& segment) const
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_segmentLock);
+    if (!m_segments[index])
+    {
+        m_segments[index] = segment;
+    }
+}
+
 /**
  * It loads the waypoints from the database
  * @return a pointer to a WaypointPath object.
@@ -265,6 +335,11 @@ void WaypointManager::Load()
             }
         }
 
+        for (WaypointPathMap::iterator itr = m_pathMap.begin(); itr != m_pathMap.end(); ++itr)
+        {
+            itr->second.UpdateRoute();
+        }
+
         sLog.outString(">> Loaded %u paths, %u nodes and %u behaviors from waypoints", total_paths, total_nodes, total_behaviors);
         sLog.outString();
 
@@ -410,6 +485,11 @@ void WaypointManager::Load()
 
         delete result;
 
+        for (WaypointPathMap::iterator itr = m_pathTemplateMap.begin(); itr != m_pathTemplateMap.end(); ++itr)
+        {
+            itr->second.UpdateRoute();
+        }
+
         sLog.outString(">> Loaded %u path templates with %u nodes and %u behaviors from waypoint templates", total_paths, total_nodes, total_behaviors);
         sLog.outString();
     }
@@ -460,6 +540,7 @@ void WaypointManager::_clearPath(WaypointPath& path)
         delete itr->second.behavior;
     }
     path.clear();
+    path.UpdateRoute();
 }
 
 /**
@@ -489,7 +570,9 @@ bool WaypointManager::AddExternalNode(uint32 entry, int32 pathId, uint32 pointId
         return false;
     }
 
-    m_externalPathTemplateMap[(entry << 8) + pathId][pointId] = WaypointNode(x, y, z, o, waittime, 0, NULL);
+    WaypointPath& path = m_externalPathTemplateMap[(entry << 8) + pathId];
+    path[pointId] = WaypointNode(x, y, z, o, waittime, 0, NULL);
+    path.UpdateRoute();
     return true;
 }
 
@@ -546,6 +629,7 @@ WaypointNode const* WaypointManager::AddNode(uint32 entry, uint32 dbGuid, uint32
 
     // Insert new or remaining
     path[nextPoint] = temp;
+    path.UpdateRoute();
 
     // Update original waypoints
     for (WaypointPath::reverse_iterator rItr = path.rbegin(); rItr != path.rend() && rItr->first > pointId; ++rItr)
@@ -590,6 +674,7 @@ void WaypointManager::DeleteNode(uint32 entry, uint32 dbGuid, uint32 point, int3
     WorldDatabase.PExecuteLog("DELETE FROM `%s` WHERE `%s`=%u AND `point`=%u", table, key_field, key, point);
 
     path->erase(point);
+    path->UpdateRoute();
 }
 
 /**
@@ -648,6 +733,7 @@ void WaypointManager::SetNodePosition(uint32 entry, uint32 dbGuid, uint32 point,
         find->second.x = x;
         find->second.y = y;
         find->second.z = z;
+        path->UpdateRoute();
     }
 }
 
@@ -685,6 +771,7 @@ void WaypointManager::SetNodeWaittime(uint32 entry, uint32 dbGuid, uint32 point,
     if (find != path->end())
     {
         find->second.delay = waittime;
+        path->UpdateRoute();
     }
 }
 
@@ -721,6 +808,7 @@ void WaypointManager::SetNodeOrientation(uint32 entry, uint32 dbGuid, uint32 poi
     if (find != path->end())
     {
         find->second.orientation = orientation;
+        path->UpdateRoute();
     }
 }
 
@@ -758,6 +846,7 @@ bool WaypointManager::SetNodeScriptId(uint32 entry, uint32 dbGuid, uint32 point,
     if (find != path->end())
     {
         find->second.script_id = scriptId;
+        path->UpdateRoute();
     }
 
     ScriptChainMap const* scm = sScriptMgr.GetScriptChainMap(DBS_ON_CREATURE_MOVEMENT);
@@ -28,6 +28,10 @@
 #include "Common.h"
 #include "Utilities/UnorderedMapSet.h"
 
+#include <ace/Thread_Mutex.h>
+#include <memory>
+#include <vector>
+
 enum WaypointPathOrigin
 {
     PATH_NO_PATH            = 0,
@@ -75,7 +79,60 @@ struct WaypointNode
         : x(_x), y(_y), z(_z), orientation(_o), delay(_delay), script_id(_script_id), behavior(_behavior) {}
 };
 
-typedef std::map < uint32 /*pointId*/, WaypointNode > WaypointPath;
+class WaypointPath;
+struct WaypointSegmentPath;                                 // WaypointMovementGenerator.h
+typedef std::shared_ptr<WaypointSegmentPath const> WaypointSegmentPathPtr;
+
+/**
+ * Array form of a WaypointPath, in point id order, that the movement generator walks
+ * by index. It is rebuilt whenever its path changes.
+ *
+ * The route also keeps the spline path a creature took to each of its points, so the
+ * next creature setting out from the same spot reuses it instead of searching the
+ * navmesh and measuring the spline again. Map threads share it, hence the lock.
+ */
+class WaypointRoute
+{
+    public:
+        struct Point
+        {
+            uint32 pointId;
+            WaypointNode node;
+        };
+
+        explicit WaypointRoute(WaypointPath const& path);
+
+        uint32 size() const { return m_points.size(); }
+        Point const& operator[](uint32 index) const { return m_points[index]; }
+
+        /// index of the point, size() if the path has no such point
+        uint32 Find(uint32 pointId) const;
+
+        /// spline path ending at the point of the given index, if a creature left one
+        WaypointSegmentPathPtr GetSegment(uint32 index) const;
+        /// keeps the first spline path stored for a point
+        void SetSegment(uint32 index, WaypointSegmentPathPtr const& segment) const;
+
+    private:
+        std::vector<Point> m_points;
+
+        mutable ACE_Thread_Mutex m_segmentLock;
+        mutable std::vector<WaypointSegmentPathPtr> m_segments;
+};
+
+/**
+ * Waypoints of one path by point id, as loaded from the database and changed by the .wp commands.
+ * Whoever changes the points calls UpdateRoute() afterwards.
+ */
+class WaypointPath : public std::map < uint32 /*pointId*/, WaypointNode >
+{
+    public:
+        WaypointRoute const* GetRoute() const { return m_route.get(); }
+        void UpdateRoute() { m_route.reset(new WaypointRoute(*this)); }
+
+    private:
+        std::unique_ptr<WaypointRoute> m_route;
+};
 
 class WaypointManager
 {
@@ -0,0 +1,332 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "WhoListIndex.h"
+#include "Player.h"
+#include "World.h"
+#include "GuildMgr.h"
+#include "ObjectAccessor.h"
+#include "DBCStores.h"
+#include "Opcodes.h"
+#include "Util.h"
+
+#include <sstream>
+
+INSTANTIATE_SINGLETON_1(WhoListIndex);
+
+// World of Warcraft Client Patch 1.7.0 (2005-09-13)
+// Using the / who command while in a Battleground instance will now only display players in your instance.
+static bool IsBattleGroundZone(uint32 zoneId)
+{
+    return zoneId == 2597 || zoneId == 3277 || zoneId == 3358;
+}
+
+WhoListIndex::WhoListIndex() : m_hasSnapshot(false), m_snapshotTick(0)
+{
+}
+
+WhoListIndex::LowerName const* WhoListIndex::GetLowerName(NameCache& cache, NameCache& oldCache, uint32 id, std::string const& name)
+{
+    NameCache::iterator itr = cache.find(id);
+    if (itr != cache.end())
+    {
+        return &itr->second;
+    }
+
+    LowerName& lowerName = cache[id];
+
+    // reuse the conversion from the last snapshot as long as the name did not change
+    NameCache::const_iterator old = oldCache.find(id);
+    if (old != oldCache.end() && old->second.name == name)
+    {
+        lowerName = old->second;
+        return &lowerName;
+    }
+
+    lowerName.name = name;
+    lowerName.valid = Utf8toWStr(name, lowerName.wname);
+    if (lowerName.valid)
+    {
+        wstrToLower(lowerName.wname);
+    }
+
+    return &lowerName;
+}
+
+void WhoListIndex::Refresh()
+{
+    uint32 tick = World::m_worldLoopCounter.value();
+    if (m_hasSnapshot && m_snapshotTick == tick)
+    {
+        return;
+    }
+
+    m_hasSnapshot = true;
+    m_snapshotTick = tick;
+    m_results.clear();
+    m_entries.clear();
+
+    // names of players and guilds no longer online are dropped with the old caches
+    NameCache playerNames;
+    NameCache guildNames;
+
+    sObjectAccessor.DoForAllPlayers([&](Player* pl)
+    {
+        // do not process players which are not in world
+        if (!pl->IsInWorld())
+        {
+            return;
+        }
+
+        Entry entry;
+        entry.guid = pl->GetObjectGuid();
+        entry.name = GetLowerName(playerNames, m_playerNames, pl->GetGUIDLow(), pl->GetName());
+        entry.guildName = GetLowerName(guildNames, m_guildNames, pl->GetGuildId(), sGuildMgr.GetGuildNameById(pl->GetGuildId()));
+        entry.level = pl->getLevel();
+        entry.classId = pl->getClass();
+        entry.race = pl->getRace();
+        entry.zoneId = pl->GetZoneId();
+        entry.instanceId = pl->GetInstanceId();
+        entry.team = pl->GetTeam();
+        entry.security = pl->GetSession()->GetSecurity();
+        entry.visibility = pl->GetVisibility();
+        m_entries.push_back(entry);
+    });
+
+    m_playerNames.swap(playerNames);
+    m_guildNames.swap(guildNames);
+}
+
+// Everything the answer depends on, requester properties only where they matter
+std::string WhoListIndex::BuildResultKey(Player* requester, WhoListQuery const& query) const
+{
+    std::ostringstream key;
+    key << query.levelMin << ':' << query.levelMax << ':' << query.raceMask << ':' << query.classMask << ':';
+
+    for (std::vector<uint32>::const_iterator itr = query.zoneIds.begin(); itr != query.zoneIds.end(); ++itr)
+    {
+        key << *itr << ',';
+    }
+
+    std::string utf8;
+    WStrToUtf8(query.playerName, utf8);
+    key << ':' << utf8.size() << ':' << utf8;
+    WStrToUtf8(query.guildName, utf8);
+    key << ':' << utf8.size() << ':' << utf8;
+
+    for (std::vector<std::wstring>::const_iterator itr = query.strings.begin(); itr != query.strings.end(); ++itr)
+    {
+        WStrToUtf8(*itr, utf8);
+        key << ':' << utf8.size() << ':' << utf8;
+    }
+
+    AccountTypes security = requester->GetSession()->GetSecurity();
+    key << "|s" << uint32(security) << "|t" << uint32(requester->GetTeam());
+
+    // zone names are matched in the client locale
+    if (!query.strings.empty())
+    {
+        key << "|l" << uint32(requester->GetSession()->GetSessionDbcLocale());
+    }
+
+    if (IsBattleGroundZone(requester->GetCachedZoneId()))
+    {
+        key << "|z" << requester->GetCachedZoneId() << '/' << requester->GetInstanceId();
+    }
+
+    // players can always see themselves
+    if (requester->GetVisibility() != VISIBILITY_ON)
+    {
+        key << "|g" << requester->GetGUIDLow();
+    }
+
+    return key.str();
+}
+
+void WhoListIndex::BuildWhoList(Player* requester, WhoListQuery const& query, WorldPacket& data)
+{
+    Refresh();
+
+    std::string key = BuildResultKey(requester, query);
+    ResultCache::const_iterator cached = m_results.find(key);
+    if (cached != m_results.end())
+    {
+        data = cached->second;
+        return;
+    }
+
+    Team team = requester->GetTeam();
+    ObjectGuid requesterGuid = requester->GetObjectGuid();
+    AccountTypes security = requester->GetSession()->GetSecurity();
+    LocaleConstant locale = requester->GetSession()->GetSessionDbcLocale();
+    bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
+    AccountTypes gmLevelInWhoList = (AccountTypes)sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST);
+
+    const uint32 zone = requester->GetCachedZoneId();
+    const bool notInBattleground = !IsBattleGroundZone(zone);
+
+    // zone name matches only depend on the zone, check each zone once per request
+    std::map<uint32, bool> zoneNameMatches;
+
+    uint32 matchcount = 0;
+    uint32 displaycount = 0;
+
+    data.Initialize(SMSG_WHO, 50);                          // guess size
+    data << uint32(matchcount);                             // placeholder, count of players matching criteria
+    data << uint32(displaycount);                           // placeholder, count of players displayed
+
+    for (std::vector<Entry>::const_iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    {
+        Entry const& entry = *itr;
+
+        // cheap numeric filters first
+        if (entry.level < query.levelMin || entry.level > query.levelMax)
+        {
+            continue;
+        }
+
+        if (!(query.classMask & (1 << entry.classId)) || !(query.raceMask & (1 << entry.race)))
+        {
+            continue;
+        }
+
+        if (security == SEC_PLAYER)
+        {
+            // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
+            if (entry.team != team && !allowTwoSideWhoList)
+            {
+                continue;
+            }
+
+            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+            if (entry.security > gmLevelInWhoList)
+            {
+                continue;
+            }
+        }
+
+        // check if target is globally visible for player, see Player::IsVisibleGloballyFor
+        if (entry.guid != requesterGuid && entry.visibility != VISIBILITY_ON)
+        {
+            if (security > SEC_PLAYER ? entry.security > security : entry.visibility == VISIBILITY_OFF)
+            {
+                continue;
+            }
+        }
+
+        bool z_show = true;
+        for (uint32 i = 0; i < query.zoneIds.size(); ++i)
+        {
+            if (query.zoneIds[i] == entry.zoneId)
+            {
+                z_show = (zone != entry.zoneId) || notInBattleground || (requester->GetInstanceId() == entry.instanceId);
+                break;
+            }
+
+            z_show = false;
+        }
+        if (!z_show)
+        {
+            continue;
+        }
+
+        if (!entry.name->valid || !(query.playerName.empty() || entry.name->wname.find(query.playerName) != std::wstring::npos))
+        {
+            continue;
+        }
+
+        if (!entry.guildName->valid || !(query.guildName.empty() || entry.guildName->wname.find(query.guildName) != std::wstring::npos))
+        {
+            continue;
+        }
+
+        bool s_show = true;
+        for (uint32 i = 0; i < query.strings.size(); ++i)
+        {
+            if (!query.strings[i].empty())
+            {
+                if (entry.guildName->wname.find(query.strings[i]) != std::wstring::npos ||
+                    entry.name->wname.find(query.strings[i]) != std::wstring::npos)
+                {
+                    s_show = true;
+                    break;
+                }
+
+                std::map<uint32, bool>::iterator zoneMatch = zoneNameMatches.find(entry.zoneId);
+                if (zoneMatch == zoneNameMatches.end())
+                {
+                    std::string aname;
+                    if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry.zoneId))
+                    {
+                        aname = areaEntry->area_name[locale];
+                    }
+
+                    // all search strings at once, a zone matches if any of them fits
+                    bool fits = false;
+                    for (uint32 j = 0; j < query.strings.size() && !fits; ++j)
+                    {
+                        fits = !query.strings[j].empty() && Utf8FitTo(aname, query.strings[j]);
+                    }
+                    zoneMatch = zoneNameMatches.insert(std::make_pair(entry.zoneId, fits)).first;
+                }
+
+                if (zoneMatch->second)
+                {
+                    s_show = true;
+                    break;
+                }
+                s_show = false;
+            }
+        }
+        if (!s_show)
+        {
+            continue;
+        }
+
+        // 49 is maximum player count sent to client
+        if (++matchcount > 49)
+        {
+            continue;
+        }
+
+        ++displaycount;
+
+        data << entry.name->name;                           // player name
+        data << entry.guildName->name;                      // guild name
+        data << uint32(entry.level);                        // player level
+        data << uint32(entry.classId);                      // player class
+        data << uint32(entry.race);                         // player race
+        data << uint32(entry.zoneId);                       // player zone id
+    }
+
+    if (sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS) && matchcount > sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS))
+    {
+        matchcount = sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS);
+    }
+
+    data.put(0, displaycount);                              // insert right count, count displayed
+    data.put(4, matchcount);                                // insert right count, count of matches
+
+    m_results[key] = data;
+}
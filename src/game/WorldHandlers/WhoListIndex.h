@@ -0,0 +1,105 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_WHOLISTINDEX
+#define MANGOS_H_WHOLISTINDEX
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "SharedDefines.h"
+#include "WorldPacket.h"
+#include "Policies/Singleton.h"
+
+class Player;
+
+// Search criteria of a CMSG_WHO request, names and strings already lower case
+struct WhoListQuery
+{
+    uint32 levelMin;
+    uint32 levelMax;
+    uint32 raceMask;
+    uint32 classMask;
+    std::vector<uint32> zoneIds;
+    std::wstring playerName;
+    std::wstring guildName;
+    std::vector<std::wstring> strings;
+};
+
+/**
+ * Snapshot of the online players for /who.
+ *
+ * The snapshot is taken at the first request of a world tick. Lower case player and
+ * guild names are kept between snapshots, so names are converted once per login
+ * instead of once per request. Answers are kept until the next tick and reused for
+ * identical requests of players that see the same list.
+ */
+class WhoListIndex
+{
+    public:
+        WhoListIndex();
+
+        void BuildWhoList(Player* requester, WhoListQuery const& query, WorldPacket& data);
+
+    private:
+        // name as stored and in lower case, invalid if it is no valid utf8
+        struct LowerName
+        {
+            std::string name;
+            std::wstring wname;
+            bool valid;
+        };
+
+        struct Entry
+        {
+            ObjectGuid guid;
+            LowerName const* name;
+            LowerName const* guildName;
+            uint32 level;
+            uint32 classId;
+            uint32 race;
+            uint32 zoneId;
+            uint32 instanceId;
+            Team team;
+            AccountTypes security;
+            uint8 visibility;
+        };
+
+        typedef UNORDERED_MAP<uint32, LowerName> NameCache;
+        typedef std::map<std::string, WorldPacket> ResultCache;
+
+        void Refresh();
+        static LowerName const* GetLowerName(NameCache& cache, NameCache& oldCache, uint32 id, std::string const& name);
+        std::string BuildResultKey(Player* requester, WhoListQuery const& query) const;
+
+        bool m_hasSnapshot;
+        uint32 m_snapshotTick;                              // World::m_worldLoopCounter at last refresh
+        std::vector<Entry> m_entries;
+        NameCache m_playerNames;
+        NameCache m_guildNames;
+        ResultCache m_results;
+};
+
+#define sWhoListIndex MaNGOS::Singleton<WhoListIndex>::Instance()
+
+#endif
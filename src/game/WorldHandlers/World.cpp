@@ -76,6 +76,8 @@
 #include "GitRevision.h"
 #include "UpdateTime.h"
 #include "GameTime.h"
+#include "StartupLoader.h"
+#include "Database/SQLStorageSnapshot.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -114,6 +116,7 @@ float World::m_VisibleObjectGreyDistance      = 0;
 
 float  World::m_relocation_lower_limit_sq     = 10.f * 10.f;
 uint32 World::m_relocation_ai_notify_delay    = 1000u;
+uint32 World::m_relocation_notify_budget      = 0;
 
 /// World constructor
 World::World()
@@ -193,6 +196,9 @@ void World::CleanupsBeforeStop()
 {
     KickAll();                                       // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
+#ifdef ENABLE_PLAYERBOTS
+    sRandomPlayerbotMgr.SaveEventValues();           // write back the bot values changed since the last batch
+#endif
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
 }
 
@@ -561,6 +567,11 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUMTHREADS, "MapUpdateThreads", 2);
+    setConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS, "GridPreload.Threads", 0);
+    setConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD, "GridPreload.LookAhead", 10);
+    setConfigMin(CONFIG_UINT32_GRID_PRELOAD_GRIDS_PER_UPDATE, "GridPreload.GridsPerUpdate", 1, 1);
+    setConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS, "StartupLoadThreads", 1);
+    SQLStorageSnapshot::SetDirectory(sConfig.GetStringDefault("StartupSnapshotDir", ""));
 
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
@@ -763,6 +774,8 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_FLOAT_THREAT_RADIUS, "ThreatRadius", 100.0f);
     setConfigMin(CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY, "CreatureRespawnAggroDelay", 5000, 0);
+    setConfigMin(CONFIG_FLOAT_CREATURE_REDUCED_UPDATE_DISTANCE, "CreatureUpdate.ReducedRate.Distance", 0.0f, 0.0f);
+    setConfigMinMax(CONFIG_UINT32_CREATURE_REDUCED_UPDATE_INTERVAL, "CreatureUpdate.ReducedRate.Interval", 1000, 0, 10000);
 
     setConfig(CONFIG_BOOL_BATTLEGROUND_CAST_DESERTER,                  "Battleground.CastDeserter", true);
     setConfigMinMax(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN,   "Battleground.QueueAnnouncer.Join", 0, 0, 2);
@@ -834,6 +847,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW, "Realm.RecommendedOrNew", false);
 
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
+    m_relocation_notify_budget   = sConfig.GetIntDefault("Visibility.RelocationNotifyBudget", 0);
     m_relocation_lower_limit_sq  = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit", 10), 2);
 
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
@@ -1073,269 +1087,132 @@ void World::SetInitialWorldSettings()
     }
 #endif /* ENABLE_ELUNA */
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Facing Flags...");
-    sSpellMgr.LoadFacingCasterFlags();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Linked definitions...");
-    sSpellMgr.LoadSpellLinked();                            // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Disables...");                  // must be before loading quests and items
-    DisableMgr::LoadDisables();
-
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Creature Items...");
-    sObjectMgr.LoadCreatureItemTemplates();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
-
-    sLog.outString("Loading Creature spells...");
-    sObjectMgr.LoadCreatureSpells();
-
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString("Loading Pet Create Spells...");
-    sObjectMgr.LoadPetCreateSpells();
-
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
-
-    sLog.outString("Loading Creature Addon Data...");
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString(">>> Creature Addon Data loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
-
-    sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
-    sCreatureLinkingMgr.LoadFromDB();
-
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
-
-    sLog.outString("Loading Weather Data...");
-    sWeatherMgr.LoadWeatherZoneChances();
-
-    sLog.outString("Loading Quests...");
-    sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog.outString("Loading Quests Relations...");
-    sObjectMgr.LoadQuestRelations();                        // must be after quest load
-    sLog.outString(">>> Quests Relations loaded");
-    sLog.outString();
-
-    sLog.outString("Checking Quest Disables...");
-    DisableMgr::CheckQuestDisables();                       // must be after loading quests
-
-    sLog.outString("Loading Game Event Data...");           // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events
-    sGameEventMgr.LoadFromDB();
-    sLog.outString(">>> Game Event Data loaded");
-    sLog.outString();
-
-    // Load Conditions
-    sLog.outString("Loading Conditions...");
-    sObjectMgr.LoadConditions();
-
-    sLog.outString("Creating map persistent states for non-instanceable maps...");     // must be after PackInstances(), LoadCreatures(), sPoolMgr.LoadFromDB(), sGameEventMgr.LoadFromDB();
-    sMapPersistentStateMgr.InitWorldMaps();
-    sLog.outString();
-
-    sLog.outString("Loading Creature Respawn Data...");     // must be after LoadCreatures(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadCreatureRespawnTimes();
-
-    sLog.outString("Loading Gameobject Respawn Data...");   // must be after LoadGameObjects(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
-
-    sLog.outString("Loading SpellArea Data...");            // must be after quest load
-    sSpellMgr.LoadSpellAreas();
-
-    sLog.outString("Loading AreaTrigger definitions...");
-    sObjectMgr.LoadAreaTriggerTeleports();                  // must be after item template load
-
-    sLog.outString("Loading Quest Area Triggers...");
-    sObjectMgr.LoadQuestAreaTriggers();                     // must be after LoadQuests
-
-    sLog.outString("Loading Tavern Area Triggers...");
-    sObjectMgr.LoadTavernAreaTriggers();
-
-    //sLog.outString("Loading AreaTrigger script names...");
-    //sScriptMgr.LoadAreaTriggerScripts();
-
-    //sLog.outString("Loading event id script names...");
-    //sScriptMgr.LoadEventIdScripts();
-
-    //sLog.outString("Loading spell script names...");
-    //sScriptMgr.LoadSpellIdScripts();
+    ///- Load static world data, the dependencies between loaders are declared per stage
+    StartupLoader loader;
+
+    loader.AddStage("PageTexts", "Loading Page Texts...", [] { sObjectMgr.LoadPageTexts(); });
+    loader.AddStage("GameObjectTemplates", "Loading Game Object Templates...", [] { sObjectMgr.LoadGameobjectInfo(); }, { "PageTexts" });
+    loader.AddStage("GameObjectModels", "Loading GameObject models...", [] { LoadGameObjectModelList(); });
+
+    loader.AddStage("SpellChains", "Loading Spell Chain Data...", [] { sSpellMgr.LoadSpellChains(); });
+    loader.AddStage("SpellElixirs", "Loading Spell Elixir types...", [] { sSpellMgr.LoadSpellElixirs(); });
+    loader.AddStage("SpellFacingFlags", "Loading Spell Facing Flags...", [] { sSpellMgr.LoadFacingCasterFlags(); });
+    loader.AddStage("SpellLearnSkills", "Loading Spell Learn Skills...", [] { sSpellMgr.LoadSpellLearnSkills(); }, { "SpellChains" });
+    loader.AddStage("SpellLearnSpells", "Loading Spell Learn Spells...", [] { sSpellMgr.LoadSpellLearnSpells(); }, { "SpellChains" });
+    loader.AddStage("SpellProcEvents", "Loading Spell Proc Event conditions...", [] { sSpellMgr.LoadSpellProcEvents(); }, { "SpellChains" });
+    loader.AddStage("SpellBonuses", "Loading Spell Bonus Data...", [] { sSpellMgr.LoadSpellBonuses(); }, { "SpellChains" });
+    loader.AddStage("SpellProcItemEnchant", "Loading Spell Proc Item Enchant...", [] { sSpellMgr.LoadSpellProcItemEnchant(); }, { "SpellChains" });
+    loader.AddStage("SpellLinked", "Loading Spell Linked definitions...", [] { sSpellMgr.LoadSpellLinked(); }, { "SpellChains" });
+    loader.AddStage("SpellThreats", "Loading Aggro Spells Definitions...", [] { sSpellMgr.LoadSpellThreats(); }, { "SpellChains" });
+
+    loader.AddStage("GossipText", "Loading NPC Texts...", [] { sObjectMgr.LoadGossipText(); });
+    loader.AddStage("RandomEnchantments", "Loading Item Random Enchantments Table...", [] { LoadRandomEnchantmentsTable(); });
+    loader.AddStage("Disables", "Loading Disables...", [] { DisableMgr::LoadDisables(); });
+    loader.AddStage("ItemPrototypes", "Loading Item Templates...", [] { sObjectMgr.LoadItemPrototypes(); }, { "RandomEnchantments", "PageTexts", "Disables" });
+
+    loader.AddStage("CreatureModelInfo", "Loading Creature Model Based Info Data...", [] { sObjectMgr.LoadCreatureModelInfo(); });
+    loader.AddStage("CreatureItems", "Loading Creature Items...", [] { sObjectMgr.LoadCreatureItemTemplates(); }, { "ItemPrototypes" });
+    loader.AddStage("EquipmentTemplates", "Loading Equipment templates...", [] { sObjectMgr.LoadEquipmentTemplates(); }, { "ItemPrototypes" });
+    loader.AddStage("CreatureStats", "Loading Creature Stats...", [] { sObjectMgr.LoadCreatureClassLvlStats(); });
+    loader.AddStage("CreatureTemplates", "Loading Creature templates...", [] { sObjectMgr.LoadCreatureTemplates(); },
+                    { "CreatureModelInfo", "CreatureItems", "EquipmentTemplates", "CreatureStats" });
+    loader.AddStage("CreatureTemplateSpells", "Loading Creature template spells...", [] { sObjectMgr.LoadCreatureTemplateSpells(); }, { "CreatureTemplates" });
+    loader.AddStage("CreatureSpells", "Loading Creature spells...", [] { sObjectMgr.LoadCreatureSpells(); }, { "CreatureTemplates" });
+    loader.AddStage("SpellScriptTarget", "Loading SpellsScriptTarget...", [] { sSpellMgr.LoadSpellScriptTarget(); }, { "CreatureTemplates", "GameObjectTemplates" });
+    loader.AddStage("ItemRequiredTarget", "Loading ItemRequiredTarget...", [] { sObjectMgr.LoadItemRequiredTarget(); }, { "ItemPrototypes", "CreatureTemplates" });
+
+    loader.AddStage("ReputationRewardRate", "Loading Reputation Reward Rates...", [] { sObjectMgr.LoadReputationRewardRate(); });
+    loader.AddStage("ReputationOnKill", "Loading Creature Reputation OnKill Data...", [] { sObjectMgr.LoadReputationOnKill(); }, { "CreatureTemplates" });
+    loader.AddStage("ReputationSpillover", "Loading Reputation Spillover Data...", [] { sObjectMgr.LoadReputationSpilloverTemplate(); });
+    loader.AddStage("PointsOfInterest", "Loading Points Of Interest Data...", [] { sObjectMgr.LoadPointsOfInterest(); });
+    loader.AddStage("PetCreateSpells", "Loading Pet Create Spells...", [] { sObjectMgr.LoadPetCreateSpells(); }, { "CreatureTemplates" });
+
+    loader.AddStage("Creatures", "Loading Creature Data...", [] { sObjectMgr.LoadCreatures(); }, { "CreatureTemplates", "Disables" });
+    loader.AddStage("CreatureAddons", "Loading Creature Addon Data...", [] { sObjectMgr.LoadCreatureAddons(); }, { "CreatureTemplates", "Creatures" });
+    // after Creatures: both fill the shared per cell guid sets of ObjectMgr
+    loader.AddStage("GameObjects", "Loading Gameobject Data...", [] { sObjectMgr.LoadGameObjects(); }, { "GameObjectTemplates", "Disables", "Creatures" });
+    loader.AddStage("CreatureLinking", "Loading CreatureLinking Data...", [] { sCreatureLinkingMgr.LoadFromDB(); }, { "Creatures" });
+    loader.AddStage("Pools", "Loading Objects Pooling Data...", [] { sPoolMgr.LoadFromDB(); }, { "Creatures", "GameObjects" });
+    loader.AddStage("Weather", "Loading Weather Data...", [] { sWeatherMgr.LoadWeatherZoneChances(); });
+
+    loader.AddStage("Quests", "Loading Quests...", [] { sObjectMgr.LoadQuests(); },
+                    { "ItemPrototypes", "CreatureTemplates", "GameObjectTemplates", "Creatures", "GameObjects", "SpellChains", "Disables" });
+    loader.AddStage("QuestRelations", "Loading Quests Relations...", [] { sObjectMgr.LoadQuestRelations(); }, { "Quests" });
+    loader.AddStage("QuestDisables", "Checking Quest Disables...", [] { DisableMgr::CheckQuestDisables(); }, { "Quests" });
+    loader.AddStage("GameEvents", "Loading Game Event Data...", [] { sGameEventMgr.LoadFromDB(); }, { "Pools", "Quests", "QuestRelations" });
+    loader.AddStage("Conditions", "Loading Conditions...", [] { sObjectMgr.LoadConditions(); }, { "Quests", "GameEvents" });
+
+    loader.AddStage("WorldMaps", "Creating map persistent states for non-instanceable maps...", [] { sMapPersistentStateMgr.InitWorldMaps(); }, { "Creatures", "Pools", "GameEvents" });
+    loader.AddStage("CreatureRespawns", "Loading Creature Respawn Data...", [] { sMapPersistentStateMgr.LoadCreatureRespawnTimes(); }, { "Creatures", "WorldMaps" });
+    loader.AddStage("GameObjectRespawns", "Loading Gameobject Respawn Data...", [] { sMapPersistentStateMgr.LoadGameobjectRespawnTimes(); }, { "GameObjects", "WorldMaps", "CreatureRespawns" });
+
+    loader.AddStage("SpellAreas", "Loading SpellArea Data...", [] { sSpellMgr.LoadSpellAreas(); }, { "Quests" });
+    loader.AddStage("AreaTriggerTeleports", "Loading AreaTrigger definitions...", [] { sObjectMgr.LoadAreaTriggerTeleports(); }, { "ItemPrototypes", "Quests" });
+    loader.AddStage("QuestAreaTriggers", "Loading Quest Area Triggers...", [] { sObjectMgr.LoadQuestAreaTriggers(); }, { "Quests" });
+    loader.AddStage("TavernAreaTriggers", "Loading Tavern Area Triggers...", [] { sObjectMgr.LoadTavernAreaTriggers(); });
 
 #ifdef ENABLE_SD3
-    sLog.outString("Loading all script bindings...");
-    sScriptMgr.LoadScriptBinding();
+    loader.AddStage("ScriptBindings", "Loading all script bindings...", [] { sScriptMgr.LoadScriptBinding(); },
+                    { "CreatureTemplates", "GameObjectTemplates", "Creatures", "GameObjects", "Conditions", "AreaTriggerTeleports" });
 #endif /* ENABLE_SD3 */
 
-    sLog.outString("Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
-
-    sLog.outString("Loading spell target destination coordinates...");
-    sSpellMgr.LoadSpellTargetPositions();
-
-    sLog.outString("Loading SpellAffect definitions...");
-    sSpellMgr.LoadSpellAffects();
-
-    sLog.outString("Loading spell pet auras...");
-    sSpellMgr.LoadSpellPetAuras();
-
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-    sLog.outString();
-
-    sLog.outString("Loading the max pet number...");
-    sObjectMgr.LoadPetNumber();
-
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
-
-    sLog.outString("Loading Player Corpses...");
-    sObjectMgr.LoadCorpses();
-
-    sLog.outString("Loading Loot Tables...");
-    LoadLootTables();
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString("Loading Gossip scripts...");
-    sScriptMgr.LoadDbScripts(DBS_ON_GOSSIP);                 // must be before gossip menu options
-
-    sObjectMgr.LoadGossipMenus();
-
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
-
-    sLog.outString("Loading Waypoint scripts...");          // before loading from creature_movement
-    sScriptMgr.LoadDbScripts(DBS_ON_CREATURE_MOVEMENT);
-
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
-
-    sLog.outString("Modifying in-memory dbc spell attributes...");
-    sSpellMgr.ModDBCSpellAttributes();
-
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
-
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
-
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry();
-
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes();
-
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+    loader.AddStage("GraveyardZones", "Loading Graveyard-zone links...", [] { sObjectMgr.LoadGraveyardZones(); });
+    loader.AddStage("SpellTargetPositions", "Loading spell target destination coordinates...", [] { sSpellMgr.LoadSpellTargetPositions(); });
+    loader.AddStage("SpellAffects", "Loading SpellAffect definitions...", [] { sSpellMgr.LoadSpellAffects(); });
+    loader.AddStage("SpellPetAuras", "Loading spell pet auras...", [] { sSpellMgr.LoadSpellPetAuras(); }, { "CreatureTemplates" });
+    loader.AddStage("PlayerInfo", "Loading Player Create Info & Level Stats...", [] { sObjectMgr.LoadPlayerInfo(); }, { "ItemPrototypes", "SpellChains" });
+    loader.AddStage("ExplorationBaseXP", "Loading Exploration BaseXP Data...", [] { sObjectMgr.LoadExplorationBaseXP(); });
+    loader.AddStage("PetNames", "Loading Pet Name Parts...", [] { sObjectMgr.LoadPetNames(); });
+    loader.AddStage("CharacterCleanup", "Cleaning up character database...", [] { CharacterDatabaseCleaner::CleanDatabase(); });
+    loader.AddStage("PetNumber", "Loading the max pet number...", [] { sObjectMgr.LoadPetNumber(); });
+    loader.AddStage("PetLevelInfo", "Loading pet level stats...", [] { sObjectMgr.LoadPetLevelInfo(); }, { "CreatureTemplates" });
+    loader.AddStage("Corpses", "Loading Player Corpses...", [] { sObjectMgr.LoadCorpses(); }, { "WorldMaps" });
+
+    loader.AddStage("LootTables", "Loading Loot Tables...", [] { LoadLootTables(); },
+                    { "ItemPrototypes", "CreatureTemplates", "GameObjectTemplates", "Quests", "Conditions", "Disables" });
+    loader.AddStage("FishingSkill", "Loading Skill Fishing base level requirements...", [] { sObjectMgr.LoadFishingBaseSkillLevel(); });
+
+    // db scripts of all kinds share the ScriptMgr storages, keep their loads in a chain
+    loader.AddStage("GossipScripts", "Loading Gossip scripts...", [] { sScriptMgr.LoadDbScripts(DBS_ON_GOSSIP); },
+                    { "Creatures", "GameObjects", "Quests", "SpellChains" });
+    loader.AddStage("GossipMenus", "Loading Gossip menus...", [] { sObjectMgr.LoadGossipMenus(); }, { "GossipScripts", "GossipText", "Conditions", "PointsOfInterest" });
+    loader.AddStage("Vendors", "Loading Vendors...", []
+    {
+        sObjectMgr.LoadVendorTemplates();
+        sObjectMgr.LoadVendors();
+    }, { "ItemPrototypes", "CreatureTemplates", "Conditions" });
+    loader.AddStage("Trainers", "Loading Trainers...", []
+    {
+        sObjectMgr.LoadTrainerTemplates();
+        sObjectMgr.LoadTrainers();
+    }, { "CreatureTemplates", "SpellChains" });
+    loader.AddStage("WaypointScripts", "Loading Waypoint scripts...", [] { sScriptMgr.LoadDbScripts(DBS_ON_CREATURE_MOVEMENT); }, { "GossipScripts" });
+    loader.AddStage("Waypoints", "Loading Waypoints...", [] { sWaypointMgr.Load(); }, { "WaypointScripts", "Creatures" });
+
+    // changes spell dbc data every other loader may be reading
+    loader.AddBarrier("SpellAttributes", "Modifying in-memory dbc spell attributes...", [] { sSpellMgr.ModDBCSpellAttributes(); });
+
+    loader.AddStage("ReservedNames", "Loading ReservedNames...", [] { sObjectMgr.LoadReservedPlayersNames(); });
+    loader.AddStage("GameObjectsForQuests", "Loading GameObjects for quests...", [] { sObjectMgr.LoadGameObjectForQuests(); });
+    loader.AddStage("BattleMasters", "Loading BattleMasters...", [] { sBattleGroundMgr.LoadBattleMastersEntry(); });
+    loader.AddStage("BattleGroundEvents", "Loading BattleGround event indexes...", [] { sBattleGroundMgr.LoadBattleEventIndexes(); });
+    loader.AddStage("GameTele", "Loading GameTeleports...", [] { sObjectMgr.LoadGameTele(); });
 
     ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sCommandMgr.LoadCommandHelpLocale();
-    sLog.outString(">>> Localization strings loaded");
-    sLog.outString();
+    loader.AddStage("Locales", "Loading Localization strings...", []
+    {
+        sObjectMgr.LoadCreatureLocales();                   // must be after CreatureInfo loading
+        sObjectMgr.LoadGameObjectLocales();                 // must be after GameobjectInfo loading
+        sObjectMgr.LoadItemLocales();                       // must be after ItemPrototypes loading
+        sObjectMgr.LoadQuestLocales();                      // must be after QuestTemplates loading
+        sObjectMgr.LoadGossipTextLocales();                 // must be after LoadGossipText
+        sObjectMgr.LoadPageTextLocales();                   // must be after PageText loading
+        sObjectMgr.LoadGossipMenuItemsLocales();            // must be after gossip menu items loading
+        sObjectMgr.LoadPointOfInterestLocales();            // must be after POI loading
+        sCommandMgr.LoadCommandHelpLocale();
+    });
+
+    loader.Run(getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
 
     ///- Load dynamic data tables from the database
     sLog.outString("Loading Auctions...");
@@ -192,9 +192,14 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CHARDELETE_METHOD,
     CONFIG_UINT32_CHARDELETE_MIN_LEVEL,
     CONFIG_UINT32_NUMTHREADS,
+    CONFIG_UINT32_GRID_PRELOAD_THREADS,
+    CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_UINT32_GRID_PRELOAD_GRIDS_PER_UPDATE,
+    CONFIG_UINT32_STARTUP_LOAD_THREADS,
     CONFIG_UINT32_GUID_RESERVE_SIZE_CREATURE,
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY,
+    CONFIG_UINT32_CREATURE_REDUCED_UPDATE_INTERVAL,
     CONFIG_UINT32_MAX_WHOLIST_RETURNS,
     CONFIG_UINT32_LOG_WHISPERS,
     // Warden
@@ -286,6 +291,7 @@ enum eConfigFloatValues
     CONFIG_FLOAT_RATE_DURABILITY_LOSS_BLOCK,
     CONFIG_FLOAT_SIGHT_GUARDER,
     CONFIG_FLOAT_SIGHT_MONSTER,
+    CONFIG_FLOAT_CREATURE_REDUCED_UPDATE_DISTANCE,
     CONFIG_FLOAT_LISTEN_RANGE_SAY,
     CONFIG_FLOAT_LISTEN_RANGE_YELL,
     CONFIG_FLOAT_LISTEN_RANGE_TEXTEMOTE,
@@ -600,6 +606,7 @@ class World
 
         static float GetRelocationLowerLimitSq()            { return m_relocation_lower_limit_sq; }
         static uint32 GetRelocationAINotifyDelay()          { return m_relocation_ai_notify_delay; }
+        static uint32 GetRelocationNotifyBudget()           { return m_relocation_notify_budget; }
 
         void InitServerMaintenanceCheck();
         void ServerMaintenanceStart();
@@ -712,6 +719,7 @@ class World
 
         static float  m_relocation_lower_limit_sq;
         static uint32 m_relocation_ai_notify_delay;
+        static uint32 m_relocation_notify_budget;
 
         // CLI command holder to be thread safe
         ACE_Based::LockedQueue<CliCommandHolder*, ACE_Thread_Mutex> cliCmdQueue;
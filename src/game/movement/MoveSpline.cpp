@@ -139,6 +139,44 @@ namespace Movement
         }
     };
 
+    /**
+     * @brief Struct for initializing timestamps from segment lengths measured before.
+     * Segments before measure_until use control points that differ from the measured path.
+     */
+    struct PrecomputedInitializer
+    {
+        PrecomputedInitializer(float _velocity, const std::vector<float>& _lengths, int32 _first, int32 _measure_until) :
+            velocityInv(1000.f / _velocity), time(minimal_duration), lengths(_lengths), first(_first), measure_until(_measure_until) {}
+        float velocityInv;
+        int32 time;
+        const std::vector<float>& lengths;
+        int32 first;
+        int32 measure_until;
+        inline int32 operator()(Spline<int32>& s, int32 i)
+        {
+            time += ((i < measure_until ? s.SegLength(i) : lengths[i - first]) * velocityInv);
+            return time;
+        }
+    };
+
+    /**
+     * @brief Measures the segments of a path the way init_spline does, for reuse by MoveSplineInitArgs::segLengths.
+     * @param path The path points.
+     * @param smooth Whether the path is interpolated in CatmullRom mode.
+     * @param lengths Receives the segment lengths.
+     */
+    void MoveSpline::MeasureSegments(const PointsArray& path, bool smooth, std::vector<float>& lengths)
+    {
+        SplineBase measured;
+        measured.init_spline(&path[0], path.size(), smooth ? SplineBase::ModeCatmullrom : SplineBase::ModeLinear);
+
+        lengths.resize(measured.last() - measured.first());
+        for (int32 i = measured.first(); i < measured.last(); ++i)
+        {
+            lengths[i - measured.first()] = measured.SegLength(i);
+        }
+    }
+
     /**
      * @brief Initializes the spline with the given arguments.
      * @param args The initialization arguments.
@@ -165,6 +203,12 @@ namespace Movement
             FallInitializer init(spline.getPoint(spline.first()).z);
             spline.initLengths(init);
         }
+        else if (args.segLengths && !spline.isCyclic() && args.segLengths->size() == size_t(spline.last() - spline.first()))
+        {
+            // the first point is the unit's own position, so the segments using it as control point are measured again
+            PrecomputedInitializer init(args.velocity, *args.segLengths, spline.first(), spline.first() + (args.flags.isSmooth() ? 2 : 1));
+            spline.initLengths(init);
+        }
         else
         {
             CommonInitializer init(args.velocity);
@@ -193,6 +193,14 @@ namespace Movement
              */
             void Initialize(const MoveSplineInitArgs& args);
 
+            /**
+             * @brief Measures the segments of a path once, so several splines along it can share the lengths.
+             * @param path The path points.
+             * @param smooth Whether the path is interpolated in CatmullRom mode.
+             * @param lengths Receives the segment lengths.
+             */
+            static void MeasureSegments(const PointsArray& path, bool smooth, std::vector<float>& lengths);
+
             /**
              * @brief Checks if the spline is initialized.
              * @return bool True if the spline is initialized, false otherwise.
@@ -84,6 +84,13 @@ namespace Movement
              */
             void MovebyPath(const PointsArray& path, int32 pointId = 0);
 
+            /**
+             * @brief Reuses segment lengths measured by MoveSpline::MeasureSegments for the same path.
+             * Segments touching the first point are measured again, as Launch moves it to the unit's position.
+             * @param lengths The segment lengths, must stay valid until Launch.
+             */
+            void SetSegmentLengths(std::vector<float> const& lengths) { args.segLengths = &lengths; }
+
             /**
              * @brief Initializes simple A to B motion, A is the current unit's position, B is the destination.
              * @param destination The destination point.
@@ -118,6 +125,12 @@ namespace Movement
              */
             void SetFly();
 
+            /**
+             * @brief Checks if the spline will use CatmullRom interpolation mode.
+             * @return bool True if CatmullRom interpolation is enabled, false otherwise.
+             */
+            bool IsSmooth() const { return args.flags.isSmooth(); }
+
             /**
              * @brief Enables walk mode. Disabled by default.
              * @param enable Whether to enable walk mode.
@@ -78,7 +78,7 @@ namespace Movement
              * @param path_capacity The initial capacity of the path vector.
              */
             MoveSplineInitArgs(size_t path_capacity = 16) : path_Idx_offset(0),
-                velocity(0.f), splineId(0), facing(), flags()
+                velocity(0.f), splineId(0), segLengths(NULL), facing(), flags()
             {
                 path.reserve(path_capacity);
             }
@@ -89,6 +89,7 @@ namespace Movement
             int32 path_Idx_offset; /**< The path index offset. */
             float velocity; /**< The velocity of the spline movement. */
             uint32 splineId; /**< The ID of the spline. */
+            std::vector<float> const* segLengths; /**< Segment lengths of the path measured before, NULL to measure them at init. */
 
             /**
              * @brief Validates the MoveSplineInitArgs.
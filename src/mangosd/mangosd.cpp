@@ -132,10 +132,11 @@ static bool start_db()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    int nHolderConnections = sConfig.GetIntDefault("CharacterDatabaseHolderConnections", 0);
+    sLog.outString("Character Database total connections: %i", nConnections + nHolderConnections + 1);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nHolderConnections))
     {
         sLog.outError("Can not connect to Character database %s", dbstring.c_str());
 
@@ -235,6 +236,15 @@ static void on_signal(int s)
     signal(s, on_signal);
 }
 
+/// Write out queued log lines before the process dies
+static void on_crash_signal(int s)
+{
+    sLog.FlushOnCrash();
+
+    signal(s, SIG_DFL);
+    raise(s);
+}
+
 /// Define hook for all termination signals
 static void hook_signals()
 {
@@ -243,6 +253,11 @@ static void hook_signals()
 #ifdef _WIN32
     signal(SIGBREAK, on_signal);
 #endif
+
+    signal(SIGSEGV, on_crash_signal);
+    signal(SIGABRT, on_crash_signal);
+    signal(SIGFPE,  on_crash_signal);
+    signal(SIGILL,  on_crash_signal);
 }
 
 /// Unhook the signals before leaving
@@ -253,6 +268,11 @@ static void unhook_signals()
 #ifdef _WIN32
     signal(SIGBREAK, 0);
 #endif
+
+    signal(SIGSEGV, 0);
+    signal(SIGABRT, 0);
+    signal(SIGFPE,  0);
+    signal(SIGILL,  0);
 }
 
 
@@ -596,6 +616,9 @@ int main(int argc, char** argv)
     WorldDatabase.HaltDelayThread();
     LoginDatabase.HaltDelayThread();
 
+    ///- Write out all queued log lines
+    sLog.StopAsyncWriter();
+
     // This is done to make sure that we cleanup our so file before it's
     // unloaded automatically, since the ~ScriptMgr() is called to late
     // as it's allocated with static storage.
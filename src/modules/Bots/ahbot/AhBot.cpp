@@ -1,4 +1,3 @@
-#include "ace/Task.h"
 #include "Category.h"
 #include "ItemBag.h"
 #include "AhBot.h"
@@ -13,7 +12,6 @@
 #include "ObjectGuid.h"
 #include "ObjectMgr.h"
 #include "playerbot/PlayerbotAIConfig.h"
-#include "AccountMgr.h"
 #include "playerbot/playerbot.h"
 
 
@@ -99,6 +97,7 @@ void AhBot::Init()
     factions[7] = 3;
 
     availableItems.Init();
+    market.Load();
 
     sLog.outString("AhBot configuration loaded");
 }
@@ -112,15 +111,6 @@ ObjectGuid AhBot::GetAHBplayerGUID()
     return ObjectGuid(sAhBotConfig.guid);
 }
 
-class AhbotThread: public ACE_Task <ACE_MT_SYNCH>
-{
-private:
-    AhBot* bot;
-public:
-    AhbotThread(AhBot* bot) : bot(bot) {}
-    int svc(void) { bot->ForceUpdate(); return 0; }
-};
-
 void AhBot::Update()
 {
     time_t now = time(0);
@@ -137,8 +127,7 @@ void AhBot::Update()
 
     nextAICheckTime = time(0) + sAhBotConfig.updateInterval;
 
-    AhbotThread *thread = new AhbotThread(this);
-    thread->activate();
+    ForceUpdate();
 }
 
 void AhBot::ForceUpdate()
@@ -164,6 +153,7 @@ void AhBot::ForceUpdate()
     if (!allBidders.size())
     {
         sLog.outError("Ahbot is disabled but there is no bidders available");
+        updating = false;
         return;
     }
 
@@ -172,18 +162,25 @@ void AhBot::ForceUpdate()
     int answered = 0, added = 0;
     for (int i = 0; i < MAX_AUCTIONS; i++)
     {
+        AuctionSnapshot snapshot;
+        if (!TakeSnapshot(auctionIds[i], snapshot))
+        {
+            continue;
+        }
+
         InAuctionItemsBag inAuctionItems(auctionIds[i]);
         inAuctionItems.Init(true);
 
         for (int j = 0; j < CategoryList::instance.size(); j++)
         {
             Category* category = CategoryList::instance[j];
-            answered += Answer(i, category, &inAuctionItems);
+            answered += Answer(i, category, &inAuctionItems, snapshot);
             added += AddAuctions(i, category, &inAuctionItems);
         }
     }
 
     CleanupHistory();
+    market.Save();
 
     sLog.outString("AhBot auction check finished. %d auctions answered, %d new auctions added. Next check in %d seconds",
             answered, added, sAhBotConfig.updateInterval);
@@ -192,73 +189,110 @@ void AhBot::ForceUpdate()
 
 struct SortByPricePredicate
 {
-    bool operator()(AuctionEntry* const & a, AuctionEntry* const & b) const
+    bool operator()(AuctionSnapshotEntry* const & a, AuctionSnapshotEntry* const & b) const
     {
-        if (a->startbid == b->startbid)
+        if (a->entry->startbid == b->entry->startbid)
         {
-            return a->buyout < b->buyout;
+            return a->entry->buyout < b->entry->buyout;
         }
 
-        return a->startbid < b->startbid;
+        return a->entry->startbid < b->entry->startbid;
     }
 };
 
-vector<AuctionEntry*> AhBot::LoadAuctions(const AuctionHouseObject::AuctionEntryMap& auctionEntryMap,
-        Category*& category, int& auction)
+/**
+ * Collects the auctions of the auction house once per pass. The pass runs on the world
+ * thread, so the only changes to the auctions until it ends are the ones it makes itself.
+ */
+bool AhBot::TakeSnapshot(uint32 auctionHouse, AuctionSnapshot& snapshot)
 {
-    vector<AuctionEntry*> entries;
+    const AuctionHouseEntry* ahEntry = sAuctionHouseStore.LookupEntry(auctionHouse);
+    if (!ahEntry)
+    {
+        return false;
+    }
+
+    AuctionHouseObject::AuctionEntryMap const& auctionEntryMap = sAuctionMgr.GetAuctionsMap(ahEntry)->GetAuctions();
+    snapshot.auctions.reserve(auctionEntryMap.size());
     for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = auctionEntryMap.begin(); itr != auctionEntryMap.end(); ++itr)
     {
         AuctionEntry *entry = itr->second;
-        if (IsBotAuction(entry->owner) || IsBotAuction(entry->bidder))
+        if (IsBotAuction(entry->bidder))
         {
-            continue;
+            snapshot.botBids += entry->bid;
         }
 
         Item *item = sAuctionMgr.GetAItem(entry->itemGuidLow);
-        if (!item)
+        if (!item || !item->GetCount())
+        {
+            continue;
+        }
+
+        AuctionSnapshotEntry auction;
+        auction.entry = entry;
+        auction.item = item;
+        auction.proto = item->GetProto();
+        auction.sold = false;
+
+        snapshot.itemAuctions[auction.proto->ItemId].push_back(snapshot.auctions.size());
+        snapshot.auctions.push_back(auction);
+    }
+
+    return true;
+}
+
+vector<AuctionSnapshotEntry*> AhBot::LoadAuctions(AuctionSnapshot& snapshot, Category*& category, int& auction)
+{
+    vector<AuctionSnapshotEntry*> entries;
+    for (vector<AuctionSnapshotEntry>::iterator itr = snapshot.auctions.begin(); itr != snapshot.auctions.end(); ++itr)
+    {
+        AuctionEntry *entry = itr->entry;
+        if (itr->sold || IsBotAuction(entry->owner) || IsBotAuction(entry->bidder))
         {
             continue;
         }
 
-        if (!category->Contains(item->GetProto()))
+        if (!category->Contains(itr->proto))
         {
             continue;
         }
 
-        uint32 price = category->GetPricingStrategy()->GetBuyPrice(item->GetProto(), auctionIds[auction]);
-        if (!price || !item->GetCount())
+        uint32 price = category->GetPricingStrategy()->GetBuyPrice(itr->proto, auctionIds[auction]);
+        if (!price)
         {
             sLog.outDetail("%s (x%d) in auction %d: price cannot be determined",
-                    item->GetProto()->Name1, item->GetCount(), auctionIds[auction]);
+                    itr->proto->Name1, itr->item->GetCount(), auctionIds[auction]);
             continue;
         }
 
-        entries.push_back(entry);
+        entries.push_back(&*itr);
     }
     sort(entries.begin(), entries.end(), SortByPricePredicate());
     return entries;
 }
 
-void AhBot::FindMinPrice(const AuctionHouseObject::AuctionEntryMap& auctionEntryMap, AuctionEntry*& entry, Item*& item, uint32* minBid,
-        uint32* minBuyout)
+void AhBot::FindMinPrice(AuctionSnapshot const& snapshot, AuctionSnapshotEntry const& auction, uint32* minBid, uint32* minBuyout)
 {
     *minBid = 0;
     *minBuyout = 0;
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = auctionEntryMap.begin(); itr != auctionEntryMap.end(); ++itr)
+
+    map<uint32, vector<uint32> >::const_iterator sameItem = snapshot.itemAuctions.find(auction.proto->ItemId);
+    if (sameItem == snapshot.itemAuctions.end())
     {
-        AuctionEntry *other = itr->second;
-        if (other->owner == entry->owner)
-        {
-            continue;
-        }
+        return;
+    }
 
-        Item *otherItem = sAuctionMgr.GetAItem(other->itemGuidLow);
-        if (!otherItem || !otherItem->GetCount() || otherItem->GetProto()->ItemId != item->GetProto()->ItemId)
+    Item* item = auction.item;
+    for (vector<uint32>::const_iterator itr = sameItem->second.begin(); itr != sameItem->second.end(); ++itr)
+    {
+        AuctionSnapshotEntry const& otherAuction = snapshot.auctions[*itr];
+        AuctionEntry *other = otherAuction.entry;
+        if (otherAuction.sold || other->owner == auction.entry->owner)
         {
             continue;
         }
 
+        Item *otherItem = otherAuction.item;
         uint32 startbid = other->startbid / otherItem->GetCount() * item->GetCount();
         uint32 bid = other->bid / otherItem->GetCount() * item->GetCount();
         uint32 buyout = other->buyout / otherItem->GetCount() * item->GetCount();
@@ -280,32 +314,18 @@ void AhBot::FindMinPrice(const AuctionHouseObject::AuctionEntryMap& auctionEntry
     }
 }
 
-int AhBot::Answer(int auction, Category* category, ItemBag* inAuctionItems)
+int AhBot::Answer(int auction, Category* category, ItemBag* inAuctionItems, AuctionSnapshot& snapshot)
 {
-    const AuctionHouseEntry* ahEntry = sAuctionHouseStore.LookupEntry(auctionIds[auction]);
-    if (!ahEntry)
-    {
-        return 0;
-    }
-
     int answered = 0;
-    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(ahEntry);
-    const AuctionHouseObject::AuctionEntryMap& auctionEntryMap = auctionHouse->GetAuctions();
-    int64 availableMoney = GetAvailableMoney(auctionIds[auction]);
+    int64 availableMoney = GetAvailableMoney(auctionIds[auction], snapshot);
 
-    vector<AuctionEntry*> entries = LoadAuctions(auctionEntryMap, category, auction);
-    for (vector<AuctionEntry*>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    vector<uint32> items = availableItems.Get(category);
+    vector<AuctionSnapshotEntry*> entries = LoadAuctions(snapshot, category, auction);
+    for (vector<AuctionSnapshotEntry*>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
     {
-        AuctionEntry *entry = *itr;
-
-        Item *item = sAuctionMgr.GetAItem(entry->itemGuidLow);
-        if (!item || !item->GetCount())
-        {
-            continue;
-        }
-
-        const ItemPrototype* proto = item->GetProto();
-        vector<uint32> items = availableItems.Get(category);
+        AuctionEntry *entry = (*itr)->entry;
+        Item *item = (*itr)->item;
+        const ItemPrototype* proto = (*itr)->proto;
         if (find(items.begin(), items.end(), proto->ItemId) == items.end())
         {
             sLog.outDetail("%s (x%d) in auction %d: unavailable item",
@@ -365,7 +385,7 @@ int AhBot::Answer(int auction, Category* category, ItemBag* inAuctionItems)
         }
 
         uint32 minBid = 0, minBuyout = 0;
-        FindMinPrice(auctionEntryMap, entry, item, &minBid, &minBuyout);
+        FindMinPrice(snapshot, **itr, &minBid, &minBuyout);
 
         if (minBid && entry->bid && minBid < entry->bid)
         {
@@ -401,31 +421,31 @@ int AhBot::Answer(int auction, Category* category, ItemBag* inAuctionItems)
         entry->bid = curPrice + urand(1, 1 + bidPrice / 10);
         availableMoney -= curPrice;
 
-        updateMarketPrice(item->GetProto()->ItemId, entry->buyout / item->GetCount(), auctionIds[auction]);
+        updateMarketPrice(proto->ItemId, entry->buyout / item->GetCount(), auctionIds[auction]);
+        market.ClearTimes(proto->ItemId, factions[auctionIds[auction]], AHBOT_WON_DELAY);
+        answered++;
 
         if ((entry->buyout && (entry->bid >= entry->buyout || 100 * (entry->buyout - entry->bid) / price < 25)) &&
                 !(minBuyout && entry->buyout && minBuyout < entry->buyout))
         {
             sLog.outDetail("AhBot %d won %s (x%d) in auction %d for %d",
-                    bidder, item->GetProto()->Name1, item->GetCount(), auctionIds[auction], entry->buyout);
+                    bidder, proto->Name1, item->GetCount(), auctionIds[auction], entry->buyout);
 
+            // deletes both the entry and the item
+            (*itr)->sold = true;
             entry->bid = entry->buyout;
             entry->AuctionBidWinning(NULL);
         }
         else
         {
             sLog.outDetail("AhBot %d placed bid %d for %s (x%d) in auction %d",
-                    bidder, entry->bid, item->GetProto()->Name1, item->GetCount(), auctionIds[auction]);
+                    bidder, entry->bid, proto->Name1, item->GetCount(), auctionIds[auction]);
 
             CharacterDatabase.PExecute("UPDATE `auction` SET `buyguid` = '%u',`lastbid` = '%u' WHERE `id` = '%u'",
                 entry->bidder, entry->bid, entry->Id);
             AddToHistory(entry, AHBOT_WON_BID);
+            snapshot.botBids += entry->bid;
         }
-
-        CharacterDatabase.PExecute("DELETE FROM `ahbot_history` WHERE `item` = '%u' AND `won` = 4 AND `auction_house` = '%u' ",
-                proto->ItemId, factions[auctionIds[auction]]);
-
-        answered++;
     }
 
     return answered;
@@ -433,30 +453,12 @@ int AhBot::Answer(int auction, Category* category, ItemBag* inAuctionItems)
 
 uint32 AhBot::GetTime(string category, uint32 id, uint32 auctionHouse, uint32 type)
 {
-    QueryResult* results = CharacterDatabase.PQuery("SELECT MAX(`buytime`) FROM `ahbot_history` WHERE `item` = '%u' AND `won` = '%u' AND `auction_house` = '%u' AND `category` = '%s'",
-        id, type, factions[auctionHouse], category.c_str());
-
-    if (!results)
-    {
-        return 0;
-    }
-
-    Field* fields = results->Fetch();
-    uint32 result = fields[0].GetUInt32();
-    delete results;
-
-    return result;
+    return market.GetTime(category, id, factions[auctionHouse], type);
 }
 
 void AhBot::SetTime(string category, uint32 id, uint32 auctionHouse, uint32 type, uint32 value)
 {
-    CharacterDatabase.PExecute("DELETE FROM `ahbot_history` WHERE `item` = '%u' AND `won` = '%u' AND `auction_house` = '%u' AND `category` = '%s'",
-        id, type, factions[auctionHouse], category.c_str());
-
-    CharacterDatabase.PExecute("INSERT INTO `ahbot_history` (`buytime`, `item`, `bid`, `buyout`, `category`, `won`, `auction_house`) "
-        "VALUES ('%u', '%u', '%u', '%u', '%s', '%u', '%u')",
-        value, id, 0, 0,
-        category.c_str(), type, factions[auctionHouse]);
+    market.SetTime(category, id, factions[auctionHouse], type, value);
 }
 
 uint32 AhBot::GetBuyTime(uint32 entry, uint32 itemId, uint32 auctionHouse, Category*& category, double priceLevel)
@@ -536,7 +538,7 @@ int AhBot::AddAuctions(int auction, Category* category, ItemBag* inAuctionItems)
 {
     vector<uint32>& inAuction = inAuctionItems->Get(category);
 
-    int32 maxAllowedAuctionCount = categoryMaxAuctionCount[category->GetName()];
+    int32 maxAllowedAuctionCount = market.GetCategory(category->GetName()).maxAuctionCount;
     if (inAuctionItems->GetCount(category) >= maxAllowedAuctionCount)
     {
         return 0;
@@ -687,8 +689,7 @@ void AhBot::HandleCommand(string command)
 
     if (command == "update")
     {
-        AhbotThread *thread = new AhbotThread(this);
-        thread->activate();
+        ForceUpdate();
         return;
     }
 
@@ -726,9 +727,10 @@ void AhBot::HandleCommand(string command)
                     << "\n";
             for (int auction = 0; auction < MAX_AUCTIONS; auction++)
             {
-                const AuctionHouseEntry* ahEntry = sAuctionHouseStore.LookupEntry(auctionIds[auction]);
+                AuctionSnapshot snapshot;
+                TakeSnapshot(auctionIds[auction], snapshot);
                 out << "--- auction house " << auctionIds[auction] << "(faction: " << factions[auctionIds[auction]] << ", money: "
-                    << GetAvailableMoney(auctionIds[auction])
+                    << GetAvailableMoney(auctionIds[auction], snapshot)
                     << ") ---\n";
 
                 out << "sell: " << category->GetPricingStrategy()->GetSellPrice(proto, auctionIds[auction])
@@ -775,7 +777,7 @@ void AhBot::Expire(int auction)
         ++itr;
     }
 
-    CharacterDatabase.PExecute("DELETE FROM `ahbot_category`");
+    market.ClearCategories();
     sLog.outString("%d auctions marked as expired in auction %d", count, auctionIds[auction]);
 }
 
@@ -840,154 +842,60 @@ void AhBot::AddToHistory(AuctionEntry* entry, uint32 won)
     updateMarketPrice(proto->ItemId, entry->buyout / count, entry->auctionHouseEntry->houseId);
 
     uint32 now = time(0);
-    CharacterDatabase.PExecute("INSERT INTO `ahbot_history` (`buytime`, `item`, `bid`, `buyout`, `category`, `won`, `auction_house`) "
-        "VALUES ('%u', '%u', '%u', '%u', '%s', '%u', '%u')",
-        now, entry->itemTemplate, entry->bid ? entry->bid : entry->startbid, entry->buyout,
-        category.c_str(), won, factions[entry->auctionHouseEntry->houseId]);
+    market.AddHistory(now, entry->itemTemplate, entry->bid ? entry->bid : entry->startbid, entry->buyout,
+        category, won, factions[entry->auctionHouseEntry->houseId]);
 }
 
 uint32 AhBot::GetAnswerCount(uint32 itemId, uint32 auctionHouse, uint32 withinTime)
 {
-    uint32 count = 0;
-
-    QueryResult* results = CharacterDatabase.PQuery("SELECT COUNT(*) FROM `ahbot_history` WHERE "
-        "`item` = '%u' AND `won` in (2, 3) AND `auction_house` = '%u' AND `buytime` > '%u'",
-        itemId, factions[auctionHouse], time(0) - withinTime);
-    if (results)
-    {
-        do
-        {
-            Field* fields = results->Fetch();
-            count = fields[0].GetUInt32();
-        } while (results->NextRow());
-
-        delete results;
-    }
-
-    return count;
+    return market.GetAnswerCount(itemId, factions[auctionHouse], time(0) - withinTime);
 }
 
 void AhBot::CleanupHistory()
 {
     uint32 when = time(0) - 3600 * 24 * sAhBotConfig.historyDays;
-    CharacterDatabase.PExecute("DELETE FROM `ahbot_history` WHERE `buytime` < '%u'", when);
+    market.CleanupHistory(when);
 }
 
-uint32 AhBot::GetAvailableMoney(uint32 auctionHouse)
+uint32 AhBot::GetAvailableMoney(uint32 auctionHouse, AuctionSnapshot const& snapshot)
 {
     int64 result = sAhBotConfig.alwaysAvailableMoney;
 
-    map<uint32, uint32> data;
-    data[AHBOT_WON_PLAYER] = 0;
-    data[AHBOT_WON_SELF] = 0;
-
-    const AuctionHouseEntry* ahEntry = sAuctionHouseStore.LookupEntry(auctionHouse);
-    QueryResult* results = CharacterDatabase.PQuery(
-        "SELECT `won`, SUM(`bid`) FROM `ahbot_history` WHERE `auction_house` = '%u' GROUP BY `won` HAVING `won` > 0 ORDER BY `won`",
-        factions[auctionHouse]);
-    if (results)
+    uint32 faction = factions[auctionHouse];
+    uint32 lastBuyTime = market.GetLastBuyTime(faction, AHBOT_WON_SELF);
+    uint32 now = time(0);
+    if (lastBuyTime && now > lastBuyTime)
     {
-        do
-        {
-            Field* fields = results->Fetch();
-            data[fields[0].GetUInt32()] = fields[1].GetUInt32();
-
-        } while (results->NextRow());
-
-        delete results;
+        result += (now - lastBuyTime) / 3600 / 24 * sAhBotConfig.alwaysAvailableMoney;
     }
 
-    results = CharacterDatabase.PQuery(
-        "SELECT max(`buytime`) FROM `ahbot_history` WHERE `auction_house` = '%u' AND `won` = '2'",
-        factions[auctionHouse]);
-    if (results)
-    {
-        Field* fields = results->Fetch();
-        uint32 lastBuyTime = fields[0].GetUInt32();
-        uint32 now = time(0);
-        if (lastBuyTime && now > lastBuyTime)
-        {
-            result += (now - lastBuyTime) / 3600 / 24 * sAhBotConfig.alwaysAvailableMoney;
-        }
-
-        delete results;
-    }
+    result -= snapshot.botBids;
 
-    AuctionHouseObject::AuctionEntryMap const& auctionEntryMap = sAuctionMgr.GetAuctionsMap(ahEntry)->GetAuctions();
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = auctionEntryMap.begin(); itr != auctionEntryMap.end(); ++itr)
-    {
-        AuctionEntry *entry = itr->second;
-        if (!IsBotAuction(entry->bidder))
-        {
-            continue;
-        }
-
-        result -= entry->bid;
-    }
-
-    result += (data[AHBOT_WON_PLAYER] - data[AHBOT_WON_SELF]);
+    result += int64(market.GetWonBidSum(faction, AHBOT_WON_PLAYER)) - int64(market.GetWonBidSum(faction, AHBOT_WON_SELF));
     return result < 0 ? 0 : (uint32)result;
 }
 
 void AhBot::CheckCategoryMultipliers()
 {
-    QueryResult* results = CharacterDatabase.PQuery("SELECT `category`, `multiplier`, `max_auction_count`, `expire_time` FROM `ahbot_category`");
-    if (results)
-    {
-        do
-        {
-            Field* fields = results->Fetch();
-            categoryMultipliers[fields[0].GetCppString()] = fields[1].GetFloat();
-            categoryMaxAuctionCount[fields[0].GetCppString()] = fields[2].GetInt32();
-            categoryMultiplierExpireTimes[fields[0].GetCppString()] = fields[3].GetUInt64();
-
-        } while (results->NextRow());
-
-        delete results;
-    }
-
-    CharacterDatabase.PExecute("DELETE FROM `ahbot_category`");
-
     for (int i = 0; i < CategoryList::instance.size(); i++)
     {
         string name = CategoryList::instance[i]->GetName();
-        if (categoryMultiplierExpireTimes[name] <= time(0) || categoryMultipliers[name] <= 0)
+        CategoryState state = market.GetCategory(name);
+        if (state.expireTime <= time(0) || state.multiplier <= 0)
         {
-            categoryMultipliers[name] = (double)urand(20, 100) / 20.0;
+            state.multiplier = (double)urand(20, 100) / 20.0;
             uint32 maxAllowedAuctionCount = CategoryList::instance[i]->GetMaxAllowedAuctionCount();
-            categoryMaxAuctionCount[name] = urand(maxAllowedAuctionCount / 2, maxAllowedAuctionCount);
-            categoryMultiplierExpireTimes[name] = time(0) + urand(4, 7) * 3600 * 24;
+            state.maxAuctionCount = urand(maxAllowedAuctionCount / 2, maxAllowedAuctionCount);
+            state.expireTime = time(0) + urand(4, 7) * 3600 * 24;
+            market.SetCategory(name, state);
         }
-
-        CharacterDatabase.PExecute("INSERT INTO `ahbot_category` (`category`, `multiplier`, `max_auction_count`, `expire_time`) "
-                "VALUES ('%s', '%f', '%u', '%u')",
-                name.c_str(), categoryMultipliers[name], categoryMaxAuctionCount[name], categoryMultiplierExpireTimes[name]);
     }
 }
 
 
 void AhBot::updateMarketPrice(uint32 itemId, double price, uint32 auctionHouse)
 {
-    double marketPrice = 0;
-
-    QueryResult* results = CharacterDatabase.PQuery("SELECT `price` FROM `ahbot_price` WHERE `item` = '%u' AND `auction_house` = '%u'", itemId, auctionHouse);
-    if (results)
-    {
-        marketPrice = results->Fetch()[0].GetFloat();
-        delete results;
-    }
-
-    if (marketPrice > 0)
-    {
-        marketPrice = (marketPrice + price) / 2;
-    }
-    else
-    {
-        marketPrice = price;
-    }
-
-    CharacterDatabase.PExecute("DELETE FROM `ahbot_price` WHERE `item` = '%u' AND `auction_house` = '%u'", itemId, auctionHouse);
-    CharacterDatabase.PExecute("INSERT INTO `ahbot_price` (`item`, `price`, `auction_house`) VALUES ('%u', '%lf', '%u')", itemId, marketPrice, auctionHouse);
+    market.UpdateMarketPrice(itemId, price, auctionHouse);
 }
 
 bool AhBot::IsBotAuction(uint32 bidder)
@@ -1009,31 +917,29 @@ uint32 AhBot::GetRandomBidder(uint32 auctionHouse)
 
 void AhBot::LoadRandomBots()
 {
-    for (list<uint32>::iterator i = sPlayerbotAIConfig.randomBotAccounts.begin(); i != sPlayerbotAIConfig.randomBotAccounts.end(); i++)
+    if (!sPlayerbotAIConfig.randomBotAccounts.empty())
     {
-        uint32 accountId = *i;
-        if (!sAccountMgr.GetCharactersCount(accountId))
+        ostringstream accounts;
+        for (list<uint32>::iterator i = sPlayerbotAIConfig.randomBotAccounts.begin(); i != sPlayerbotAIConfig.randomBotAccounts.end(); i++)
         {
-            continue;
+            accounts << (i == sPlayerbotAIConfig.randomBotAccounts.begin() ? "" : ",") << *i;
         }
 
-        QueryResult *result = CharacterDatabase.PQuery("SELECT `guid`, `race` FROM `characters` WHERE `account` = '%u'", accountId);
-        if (!result)
+        QueryResult *result = CharacterDatabase.PQuery("SELECT `guid`, `race` FROM `characters` WHERE `account` IN (%s)", accounts.str().c_str());
+        if (result)
         {
-            continue;
+            do
+            {
+                Field* fields = result->Fetch();
+                uint32 guid = fields[0].GetUInt32();
+                uint32 race = fields[1].GetUInt32();
+                uint32 auctionHouse = PlayerbotAI::IsOpposing(race, RACE_HUMAN) ? 2 : 1;
+                bidders[auctionHouse].push_back(guid);
+                bidders[3].push_back(guid);
+                allBidders.insert(guid);
+            } while (result->NextRow());
+            delete result;
         }
-
-        do
-        {
-            Field* fields = result->Fetch();
-            uint32 guid = fields[0].GetUInt32();
-            uint32 race = fields[1].GetUInt32();
-            uint32 auctionHouse = PlayerbotAI::IsOpposing(race, RACE_HUMAN) ? 2 : 1;
-            bidders[auctionHouse].push_back(guid);
-            bidders[3].push_back(guid);
-            allBidders.insert(guid);
-        } while (result->NextRow());
-        delete result;
     }
 
     if (allBidders.empty() && sAhBotConfig.guid)
@@ -2,6 +2,7 @@
 
 #include "Category.h"
 #include "ItemBag.h"
+#include "Market.h"
 #include "PlayerbotAIBase.h"
 #include "AuctionHouseMgr.h"
 #include "ObjectGuid.h"
@@ -19,6 +20,27 @@ namespace ahbot
 {
     using namespace std;
 
+    struct AuctionSnapshotEntry
+    {
+        AuctionEntry* entry;
+        Item* item;
+        ItemPrototype const* proto;
+        bool sold;                                  // entry and item are deleted, skip
+    };
+
+    /**
+     * Auctions of one auction house as seen at the start of a market pass, with items
+     * and prototypes resolved once and indexed by item id.
+     */
+    struct AuctionSnapshot
+    {
+        AuctionSnapshot() : botBids(0) {}
+
+        vector<AuctionSnapshotEntry> auctions;
+        map<uint32, vector<uint32> > itemAuctions;  // item id -> indexes in auctions
+        int64 botBids;
+    };
+
     class AhBot
     {
     public:
@@ -36,32 +58,33 @@ namespace ahbot
 
         double GetCategoryMultiplier(string category)
         {
-            return categoryMultipliers[category];
+            return market.GetCategory(category).multiplier;
         }
 
+        Market& GetMarket() { return market; }
+
         int32 GetSellPrice(const ItemPrototype* proto);
         int32 GetBuyPrice(const ItemPrototype* proto);
         double GetRarityPriceMultiplier(const ItemPrototype* proto);
 
     private:
-        int Answer(int auction, Category* category, ItemBag* inAuctionItems);
+        int Answer(int auction, Category* category, ItemBag* inAuctionItems, AuctionSnapshot& snapshot);
         int AddAuctions(int auction, Category* category, ItemBag* inAuctionItems);
         int AddAuction(int auction, Category* category, const ItemPrototype* proto);
         void Expire(int auction);
         void PrintStats(int auction);
         void AddToHistory(AuctionEntry* entry, uint32 won = 0);
         void CleanupHistory();
-        uint32 GetAvailableMoney(uint32 auctionHouse);
+        uint32 GetAvailableMoney(uint32 auctionHouse, AuctionSnapshot const& snapshot);
         void CheckCategoryMultipliers();
         void updateMarketPrice(uint32 itemId, double price, uint32 auctionHouse);
         bool IsBotAuction(uint32 bidder);
         uint32 GetRandomBidder(uint32 auctionHouse);
         void LoadRandomBots();
         uint32 GetAnswerCount(uint32 itemId, uint32 auctionHouse, uint32 withinTime);
-        vector<AuctionEntry*> LoadAuctions(const AuctionHouseObject::AuctionEntryMap& auctionEntryMap, Category*& category,
-                int& auction);
-        void FindMinPrice(const AuctionHouseObject::AuctionEntryMap& auctionEntryMap, AuctionEntry*& entry, Item*& item, uint32* minBid,
-                uint32* minBuyout);
+        bool TakeSnapshot(uint32 auctionHouse, AuctionSnapshot& snapshot);
+        vector<AuctionSnapshotEntry*> LoadAuctions(AuctionSnapshot& snapshot, Category*& category, int& auction);
+        void FindMinPrice(AuctionSnapshot const& snapshot, AuctionSnapshotEntry const& auction, uint32* minBid, uint32* minBuyout);
         uint32 GetBuyTime(uint32 entry, uint32 itemId, uint32 auctionHouse, Category*& category, double priceLevel);
         uint32 GetTime(string category, uint32 id, uint32 auctionHouse, uint32 type);
         void SetTime(string category, uint32 id, uint32 auctionHouse, uint32 type, uint32 value);
@@ -75,9 +98,7 @@ namespace ahbot
     private:
         AvailableItemsBag availableItems;
         time_t nextAICheckTime;
-        map<string, double> categoryMultipliers;
-        map<string, uint32> categoryMaxAuctionCount;
-        map<string, uint64> categoryMultiplierExpireTimes;
+        Market market;
         map<uint32, vector<uint32> > bidders;
         set<uint32> allBidders;
         bool updating;
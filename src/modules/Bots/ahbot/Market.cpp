@@ -0,0 +1,522 @@
+#include "Market.h"
+#include "AhBot.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include "DatabaseEnv.h"
+#include "ObjectMgr.h"
+#include "QuestDef.h"
+
+using namespace ahbot;
+
+#define MARKET_SAVE_CHUNK_SIZE 500                  // rows per DELETE / INSERT statement of a Save()
+
+void Market::Load()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    QueryResult* results = CharacterDatabase.Query("SELECT `buytime`, `item`, `bid`, `buyout`, `category`, `won`, `auction_house` FROM `ahbot_history`");
+    if (results)
+    {
+        do
+        {
+            Field* fields = results->Fetch();
+            uint32 buyTime = fields[0].GetUInt32();
+            uint32 won = fields[5].GetUInt32();
+            if (won == AHBOT_WON_DELAY || won == AHBOT_SELL_DELAY)
+            {
+                TimeKey key;
+                key.category = fields[4].GetCppString();
+                key.id = fields[1].GetUInt32();
+                key.faction = fields[6].GetUInt32();
+                key.type = won;
+                times[key] = max(times[key], buyTime);
+                continue;
+            }
+
+            HistoryRecord record;
+            record.itemId = fields[1].GetUInt32();
+            record.bid = fields[2].GetUInt32();
+            record.buyout = fields[3].GetUInt32();
+            record.category = fields[4].GetCppString();
+            record.won = won;
+            record.faction = fields[6].GetUInt32();
+            history.insert(make_pair(buyTime, record));
+            IndexHistory(buyTime, record, true);
+        } while (results->NextRow());
+        delete results;
+    }
+
+    results = CharacterDatabase.Query("SELECT `item`, `price`, `auction_house` FROM `ahbot_price`");
+    if (results)
+    {
+        do
+        {
+            Field* fields = results->Fetch();
+            prices[make_pair(fields[0].GetUInt32(), fields[2].GetUInt32())] = fields[1].GetDouble();
+        } while (results->NextRow());
+        delete results;
+    }
+
+    results = CharacterDatabase.Query("SELECT `category`, `multiplier`, `max_auction_count`, `expire_time` FROM `ahbot_category`");
+    if (results)
+    {
+        do
+        {
+            Field* fields = results->Fetch();
+            CategoryState& state = categories[fields[0].GetCppString()];
+            state.multiplier = fields[1].GetFloat();
+            state.maxAuctionCount = fields[2].GetInt32();
+            state.expireTime = fields[3].GetUInt64();
+        } while (results->NextRow());
+        delete results;
+    }
+
+    LoadWorldData();
+
+    sLog.outString("AhBot market loaded: %u history records, %u delays, %u prices",
+            uint32(history.size()), uint32(times.size()), uint32(prices.size()));
+}
+
+void Market::LoadWorldData()
+{
+    QueryResult* results = WorldDatabase.Query(
+        "SELECT `item`, MAX(`ChanceOrQuestChance`) FROM ( "
+        "SELECT `item`, `ChanceOrQuestChance` FROM `gameobject_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `disenchant_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `fishing_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `item_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `pickpocketing_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `reference_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `skinning_loot_template` "
+        "UNION ALL SELECT `item`, `ChanceOrQuestChance` FROM `creature_loot_template` "
+        ") a GROUP BY `item`");
+    if (results)
+    {
+        do
+        {
+            Field* fields = results->Fetch();
+            float chance = fields[1].GetFloat();
+            if (chance > 0 && chance <= 90.0)
+            {
+                double multiplier = sqrt((100.0 - chance) / 10.0);
+                if (multiplier > 1.0)
+                {
+                    rarityMultipliers[fields[0].GetUInt32()] = multiplier;
+                }
+            }
+        } while (results->NextRow());
+        delete results;
+    }
+
+    ObjectMgr::QuestMap const& quests = sObjectMgr.GetQuestTemplates();
+    for (ObjectMgr::QuestMap::const_iterator i = quests.begin(); i != quests.end(); ++i)
+    {
+        Quest const* quest = i->second;
+        uint32 level = max(uint32(quest->GetQuestLevel()), quest->GetMinLevel());
+        for (int j = 0; j < QUEST_ITEM_OBJECTIVES_COUNT; ++j)
+        {
+            if (uint32 itemId = quest->ReqItemId[j])
+            {
+                questItemLevels[itemId] = max(questItemLevels[itemId], level);
+            }
+        }
+    }
+}
+
+/**
+ * Writes everything changed since the last call in one transaction.
+ */
+void Market::Save()
+{
+    vector<string> statements;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+        if (cleanupBefore)
+        {
+            ostringstream sql;
+            sql << "DELETE FROM `ahbot_history` WHERE `buytime` < '" << cleanupBefore << "'";
+            statements.push_back(sql.str());
+            cleanupBefore = 0;
+        }
+
+        vector<string> timeKeys, historyRows;
+        for (set<TimeKey>::const_iterator i = changedTimes.begin(); i != changedTimes.end(); ++i)
+        {
+            ostringstream key;
+            key << "('" << i->id << "', '" << i->type << "', '" << i->faction << "', '" << i->category << "')";
+            timeKeys.push_back(key.str());
+
+            map<TimeKey, uint32>::const_iterator time = times.find(*i);
+            if (time != times.end())
+            {
+                ostringstream row;
+                row << "('" << time->second << "', '" << i->id << "', '0', '0', '" << i->category << "', '" << i->type << "', '" << i->faction << "')";
+                historyRows.push_back(row.str());
+            }
+        }
+        changedTimes.clear();
+
+        for (size_t first = 0; first < timeKeys.size(); first += MARKET_SAVE_CHUNK_SIZE)
+        {
+            ostringstream sql;
+            sql << "DELETE FROM `ahbot_history` WHERE (`item`, `won`, `auction_house`, `category`) IN (";
+            for (size_t j = first; j < timeKeys.size() && j < first + MARKET_SAVE_CHUNK_SIZE; ++j)
+            {
+                sql << (j == first ? "" : ", ") << timeKeys[j];
+            }
+            sql << ")";
+            statements.push_back(sql.str());
+        }
+
+        for (vector<pair<uint32, HistoryRecord> >::const_iterator i = newHistory.begin(); i != newHistory.end(); ++i)
+        {
+            ostringstream row;
+            row << "('" << i->first << "', '" << i->second.itemId << "', '" << i->second.bid << "', '" << i->second.buyout << "', '"
+                << i->second.category << "', '" << i->second.won << "', '" << i->second.faction << "')";
+            historyRows.push_back(row.str());
+        }
+        newHistory.clear();
+
+        for (size_t first = 0; first < historyRows.size(); first += MARKET_SAVE_CHUNK_SIZE)
+        {
+            ostringstream sql;
+            sql << "INSERT INTO `ahbot_history` (`buytime`, `item`, `bid`, `buyout`, `category`, `won`, `auction_house`) VALUES ";
+            for (size_t j = first; j < historyRows.size() && j < first + MARKET_SAVE_CHUNK_SIZE; ++j)
+            {
+                sql << (j == first ? "" : ", ") << historyRows[j];
+            }
+            statements.push_back(sql.str());
+        }
+
+        vector<pair<uint32, uint32> > priceKeys(changedPrices.begin(), changedPrices.end());
+        changedPrices.clear();
+        for (size_t first = 0; first < priceKeys.size(); first += MARKET_SAVE_CHUNK_SIZE)
+        {
+            ostringstream keys, rows;
+            rows << fixed;
+            for (size_t j = first; j < priceKeys.size() && j < first + MARKET_SAVE_CHUNK_SIZE; ++j)
+            {
+                keys << (j == first ? "" : ", ") << "('" << priceKeys[j].first << "', '" << priceKeys[j].second << "')";
+                rows << (j == first ? "" : ", ") << "('" << priceKeys[j].first << "', '" << prices[priceKeys[j]] << "', '" << priceKeys[j].second << "')";
+            }
+            statements.push_back("DELETE FROM `ahbot_price` WHERE (`item`, `auction_house`) IN (" + keys.str() + ")");
+            statements.push_back("INSERT INTO `ahbot_price` (`item`, `price`, `auction_house`) VALUES " + rows.str());
+        }
+
+        if (categoriesChanged)
+        {
+            statements.push_back("DELETE FROM `ahbot_category`");
+            ostringstream rows;
+            rows << fixed;
+            for (map<string, CategoryState>::const_iterator i = categories.begin(); i != categories.end(); ++i)
+            {
+                rows << (i == categories.begin() ? "" : ", ") << "('" << i->first << "', '" << i->second.multiplier << "', '"
+                    << i->second.maxAuctionCount << "', '" << i->second.expireTime << "')";
+            }
+            if (!categories.empty())
+            {
+                statements.push_back("INSERT INTO `ahbot_category` (`category`, `multiplier`, `max_auction_count`, `expire_time`) VALUES " + rows.str());
+            }
+            categoriesChanged = false;
+        }
+    }
+
+    if (statements.empty())
+    {
+        return;
+    }
+
+    // statements are built as plain strings: a batch easily exceeds the PExecute buffer
+    CharacterDatabase.BeginTransaction();
+    for (vector<string>::const_iterator i = statements.begin(); i != statements.end(); ++i)
+    {
+        CharacterDatabase.Execute(i->c_str());
+    }
+    CharacterDatabase.CommitTransaction();
+}
+
+void Market::AddHistory(uint32 buyTime, uint32 itemId, uint32 bid, uint32 buyout, string const& category, uint32 won, uint32 faction)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    HistoryRecord record;
+    record.itemId = itemId;
+    record.bid = bid;
+    record.buyout = buyout;
+    record.category = category;
+    record.won = won;
+    record.faction = faction;
+
+    history.insert(make_pair(buyTime, record));
+    IndexHistory(buyTime, record, true);
+    newHistory.push_back(make_pair(buyTime, record));
+}
+
+void Market::CleanupHistory(uint32 before)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    multimap<uint32, HistoryRecord>::iterator end = history.lower_bound(before);
+    for (multimap<uint32, HistoryRecord>::iterator i = history.begin(); i != end; ++i)
+    {
+        IndexHistory(i->first, i->second, false);
+    }
+    history.erase(history.begin(), end);
+
+    // unsaved records this old would be inserted again right after the cleanup
+    vector<pair<uint32, HistoryRecord> >::iterator unsaved = newHistory.begin();
+    for (vector<pair<uint32, HistoryRecord> >::const_iterator i = newHistory.begin(); i != newHistory.end(); ++i)
+    {
+        if (i->first >= before)
+        {
+            *unsaved++ = *i;
+        }
+    }
+    newHistory.erase(unsaved, newHistory.end());
+
+    for (map<TimeKey, uint32>::iterator i = times.begin(); i != times.end();)
+    {
+        if (i->second < before)
+        {
+            times.erase(i++);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    cleanupBefore = max(cleanupBefore, before);
+}
+
+void Market::IndexHistory(uint32 buyTime, HistoryRecord const& record, bool add)
+{
+    if (record.won == AHBOT_WON_SELF || record.won == AHBOT_WON_BID)
+    {
+        multiset<uint32>& answerTimes = answers[make_pair(record.faction, record.itemId)];
+        if (add)
+        {
+            answerTimes.insert(buyTime);
+        }
+        else
+        {
+            answerTimes.erase(answerTimes.find(buyTime));
+        }
+    }
+
+    if (record.won)
+    {
+        pair<uint32, uint32> key = make_pair(record.faction, record.won);
+        if (add)
+        {
+            wonBidSums[key] += record.bid;
+            wonBuyTimes[key].insert(buyTime);
+        }
+        else
+        {
+            wonBidSums[key] -= record.bid;
+            wonBuyTimes[key].erase(wonBuyTimes[key].find(buyTime));
+        }
+    }
+
+    if (record.won == AHBOT_WON_PLAYER)
+    {
+        uint32 period = GetSalePeriod(buyTime);
+        multiset<uint32>& categoryTimes = categorySales[make_pair(record.faction, record.category)][period];
+        multiset<uint32>& itemTimes = itemSales[make_pair(record.faction, record.itemId)][period];
+        if (add)
+        {
+            categoryTimes.insert(buyTime);
+            itemTimes.insert(buyTime);
+        }
+        else
+        {
+            categoryTimes.erase(categoryTimes.find(buyTime));
+            itemTimes.erase(itemTimes.find(buyTime));
+            if (categoryTimes.empty())
+            {
+                categorySales[make_pair(record.faction, record.category)].erase(period);
+            }
+            if (itemTimes.empty())
+            {
+                itemSales[make_pair(record.faction, record.itemId)].erase(period);
+            }
+        }
+    }
+}
+
+/**
+ * Same rounding as the former ROUND(`buytime`/3600/24/5) of the pricing queries.
+ */
+uint32 Market::GetSalePeriod(uint32 buyTime)
+{
+    return uint32(floor(buyTime / (3600.0 * 24 * 5) + 0.5));
+}
+
+uint32 Market::CountSalePeriods(SalePeriods const& periods, uint32 untilTime)
+{
+    uint32 count = 0;
+    for (SalePeriods::const_iterator i = periods.begin(); i != periods.end(); ++i)
+    {
+        if (!i->second.empty() && *i->second.begin() <= untilTime)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+uint32 Market::GetAnswerCount(uint32 itemId, uint32 faction, uint32 since)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    map<pair<uint32, uint32>, multiset<uint32> >::const_iterator i = answers.find(make_pair(faction, itemId));
+    if (i == answers.end())
+    {
+        return 0;
+    }
+
+    return distance(i->second.upper_bound(since), i->second.end());
+}
+
+uint64 Market::GetWonBidSum(uint32 faction, uint32 won)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    map<pair<uint32, uint32>, uint64>::const_iterator i = wonBidSums.find(make_pair(faction, won));
+    return i != wonBidSums.end() ? i->second : 0;
+}
+
+uint32 Market::GetLastBuyTime(uint32 faction, uint32 won)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    map<pair<uint32, uint32>, multiset<uint32> >::const_iterator i = wonBuyTimes.find(make_pair(faction, won));
+    return i != wonBuyTimes.end() && !i->second.empty() ? *i->second.rbegin() : 0;
+}
+
+uint32 Market::GetCategorySaleDays(string const& category, uint32 untilTime, uint32 faction)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    map<pair<uint32, string>, SalePeriods>::const_iterator i = categorySales.find(make_pair(faction, category));
+    return i != categorySales.end() ? CountSalePeriods(i->second, untilTime) : 0;
+}
+
+uint32 Market::GetItemSaleDays(uint32 itemId, uint32 untilTime, uint32 faction)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    map<pair<uint32, uint32>, SalePeriods>::const_iterator i = itemSales.find(make_pair(faction, itemId));
+    return i != itemSales.end() ? CountSalePeriods(i->second, untilTime) : 0;
+}
+
+uint32 Market::GetTime(string const& category, uint32 id, uint32 faction, uint32 type)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    TimeKey key;
+    key.category = category;
+    key.id = id;
+    key.faction = faction;
+    key.type = type;
+
+    map<TimeKey, uint32>::const_iterator i = times.find(key);
+    return i != times.end() ? i->second : 0;
+}
+
+void Market::SetTime(string const& category, uint32 id, uint32 faction, uint32 type, uint32 value)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    TimeKey key;
+    key.category = category;
+    key.id = id;
+    key.faction = faction;
+    key.type = type;
+
+    times[key] = value;
+    changedTimes.insert(key);
+}
+
+/**
+ * Drops the delays of the given type stored for an id, whatever their category.
+ */
+void Market::ClearTimes(uint32 id, uint32 faction, uint32 type)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    // keys are ordered by id, faction and type first
+    TimeKey first;
+    first.id = id;
+    first.faction = faction;
+    first.type = type;
+    for (map<TimeKey, uint32>::iterator i = times.lower_bound(first); i != times.end() && i->first.id == id;)
+    {
+        if (i->first.faction == faction && i->first.type == type)
+        {
+            changedTimes.insert(i->first);
+            times.erase(i++);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+double Market::GetMarketPrice(uint32 itemId, uint32 auctionHouse)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, 0);
+
+    map<pair<uint32, uint32>, double>::const_iterator i = prices.find(make_pair(itemId, auctionHouse));
+    return i != prices.end() ? i->second : 0;
+}
+
+void Market::UpdateMarketPrice(uint32 itemId, double price, uint32 auctionHouse)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    pair<uint32, uint32> key = make_pair(itemId, auctionHouse);
+    double& marketPrice = prices[key];
+    marketPrice = marketPrice > 0 ? (marketPrice + price) / 2 : price;
+    changedPrices.insert(key);
+}
+
+CategoryState Market::GetCategory(string const& name)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock, CategoryState());
+
+    map<string, CategoryState>::const_iterator i = categories.find(name);
+    return i != categories.end() ? i->second : CategoryState();
+}
+
+void Market::SetCategory(string const& name, CategoryState const& state)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    categories[name] = state;
+    categoriesChanged = true;
+}
+
+void Market::ClearCategories()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, lock);
+
+    categories.clear();
+    categoriesChanged = true;
+}
+
+double Market::GetRarityPriceMultiplier(uint32 itemId) const
+{
+    map<uint32, double>::const_iterator i = rarityMultipliers.find(itemId);
+    return i != rarityMultipliers.end() ? i->second : 1.0;
+}
+
+uint32 Market::GetQuestItemLevel(uint32 itemId) const
+{
+    map<uint32, uint32>::const_iterator i = questItemLevels.find(itemId);
+    return i != questItemLevels.end() ? i->second : 0;
+}
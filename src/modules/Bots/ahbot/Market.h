@@ -0,0 +1,124 @@
+#pragma once
+#include "Common.h"
+#include <ace/Thread_Mutex.h>
+
+using namespace std;
+
+namespace ahbot
+{
+    /**
+     * Random multiplier and auction count of one category, as kept in `ahbot_category`.
+     */
+    struct CategoryState
+    {
+        CategoryState() : multiplier(0), maxAuctionCount(0), expireTime(0) {}
+
+        double multiplier;
+        uint32 maxAuctionCount;
+        uint64 expireTime;
+    };
+
+    /**
+     * In-memory copy of the AhBot market tables (`ahbot_history`, `ahbot_price`,
+     * `ahbot_category`) plus the static item data the pricing needs.
+     *
+     * Everything is loaded once by Load(). Changes are applied in memory and written
+     * back by Save() in one transaction, so a market pass does not wait for the database.
+     * Bot actions ask for prices from the map threads, so every accessor takes the lock.
+     */
+    class Market
+    {
+    public:
+        Market() : cleanupBefore(0), categoriesChanged(false) {}
+
+    public:
+        void Load();
+        void Save();
+
+        // `ahbot_history` rows of won types AHBOT_WON_EXPIRE .. AHBOT_WON_BID
+        void AddHistory(uint32 buyTime, uint32 itemId, uint32 bid, uint32 buyout, string const& category, uint32 won, uint32 faction);
+        void CleanupHistory(uint32 before);
+        uint32 GetAnswerCount(uint32 itemId, uint32 faction, uint32 since);
+        uint64 GetWonBidSum(uint32 faction, uint32 won);
+        uint32 GetLastBuyTime(uint32 faction, uint32 won);
+        uint32 GetCategorySaleDays(string const& category, uint32 untilTime, uint32 faction);
+        uint32 GetItemSaleDays(uint32 itemId, uint32 untilTime, uint32 faction);
+
+        // `ahbot_history` rows of won types AHBOT_WON_DELAY and AHBOT_SELL_DELAY
+        uint32 GetTime(string const& category, uint32 id, uint32 faction, uint32 type);
+        void SetTime(string const& category, uint32 id, uint32 faction, uint32 type, uint32 value);
+        void ClearTimes(uint32 id, uint32 faction, uint32 type);
+
+        // `ahbot_price`
+        double GetMarketPrice(uint32 itemId, uint32 auctionHouse);
+        void UpdateMarketPrice(uint32 itemId, double price, uint32 auctionHouse);
+
+        // `ahbot_category`
+        CategoryState GetCategory(string const& name);
+        void SetCategory(string const& name, CategoryState const& state);
+        void ClearCategories();
+
+        // world data, read only after Load()
+        double GetRarityPriceMultiplier(uint32 itemId) const;
+        uint32 GetQuestItemLevel(uint32 itemId) const;
+
+    private:
+        struct HistoryRecord
+        {
+            uint32 itemId;
+            uint32 bid;
+            uint32 buyout;
+            string category;
+            uint32 won;
+            uint32 faction;
+        };
+
+        struct TimeKey
+        {
+            string category;
+            uint32 id;
+            uint32 faction;
+            uint32 type;
+
+            bool operator<(TimeKey const& other) const
+            {
+                if (id != other.id) return id < other.id;
+                if (faction != other.faction) return faction < other.faction;
+                if (type != other.type) return type < other.type;
+                return category < other.category;
+            }
+        };
+
+        // sale times of won-by-player rows, by 5 day period as the pricing counts them
+        typedef map<uint32 /*period*/, multiset<uint32> > SalePeriods;
+
+        void LoadWorldData();
+        void IndexHistory(uint32 buyTime, HistoryRecord const& record, bool add);
+        static uint32 GetSalePeriod(uint32 buyTime);
+        static uint32 CountSalePeriods(SalePeriods const& periods, uint32 untilTime);
+
+    private:
+        ACE_Thread_Mutex lock;
+
+        multimap<uint32 /*buytime*/, HistoryRecord> history;
+        map<pair<uint32, uint32> /*faction, item*/, multiset<uint32> > answers;
+        map<pair<uint32, uint32> /*faction, won*/, uint64> wonBidSums;
+        map<pair<uint32, uint32> /*faction, won*/, multiset<uint32> > wonBuyTimes;
+        map<pair<uint32, string> /*faction, category*/, SalePeriods> categorySales;
+        map<pair<uint32, uint32> /*faction, item*/, SalePeriods> itemSales;
+
+        map<TimeKey, uint32> times;
+        map<pair<uint32, uint32> /*item, auction house*/, double> prices;
+        map<string, CategoryState> categories;
+
+        map<uint32, double> rarityMultipliers;
+        map<uint32, uint32> questItemLevels;
+
+        // pending writes
+        vector<pair<uint32, HistoryRecord> > newHistory;
+        uint32 cleanupBefore;
+        set<TimeKey> changedTimes;
+        set<pair<uint32, uint32> > changedPrices;
+        bool categoriesChanged;
+    };
+};
@@ -2,7 +2,6 @@
 #include "Category.h"
 #include "ItemBag.h"
 #include "AhBotConfig.h"
-#include "../../shared/Database/DatabaseEnv.h"
 #include "AhBot.h"
 
 using namespace ahbot;
@@ -22,16 +21,7 @@ uint32 PricingStrategy::GetSellPrice(ItemPrototype const* proto, uint32 auctionH
 
 double PricingStrategy::GetMarketPrice(uint32 itemId, uint32 auctionHouse)
 {
-    double marketPrice = 0;
-
-    QueryResult* results = CharacterDatabase.PQuery("SELECT `price` FROM `ahbot_price` WHERE `item` = '%u' AND `auction_house` = '%u'", itemId, auctionHouse);
-    if (results)
-    {
-        marketPrice = results->Fetch()[0].GetFloat();
-        delete results;
-    }
-
-    return marketPrice;
+    return auctionbot.GetMarket().GetMarketPrice(itemId, auctionHouse);
 }
 
 uint32 PricingStrategy::GetBuyPrice(ItemPrototype const* proto, uint32 auctionHouse)
@@ -93,63 +83,13 @@ string PricingStrategy::ExplainBuyPrice(ItemPrototype const* proto, uint32 aucti
 
 double PricingStrategy::GetRarityPriceMultiplier(uint32 itemId)
 {
-    double result = 1.0;
-
-    QueryResult* results = WorldDatabase.PQuery(
-        "SELECT MAX(`ChanceOrQuestChance`) FROM ( "
-        "SELECT `ChanceOrQuestChance` FROM `gameobject_loot_template` WHERE `item` = '%u' "
-        //"union select ChanceOrQuestChance from spell_loot_template where item = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `disenchant_loot_template` WHERE `item` = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `fishing_loot_template` WHERE `item` = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `item_loot_template` WHERE `item` = '%u' "
-        //"union select ChanceOrQuestChance from milling_loot_template where `item` = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `pickpocketing_loot_template` WHERE `item` = '%u' "
-        //"union select ChanceOrQuestChance from prospecting_loot_template where `item` = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `reference_loot_template` WHERE `item` = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `skinning_loot_template` WHERE `item` = '%u' "
-        "UNION SELECT `ChanceOrQuestChance` FROM `creature_loot_template` WHERE `item` = '%u' "
-        "UNION SELECT 0 "
-        ") a",
-        itemId,itemId,itemId,itemId,itemId,itemId,itemId,itemId,itemId,itemId,itemId);
-
-    if (results)
-    {
-        Field* fields = results->Fetch();
-        float chance = fields[0].GetFloat();
-
-        if (chance > 0 && chance <= 90.0)
-        {
-            result = sqrt((100.0 - chance) / 10.0);
-        }
-
-        delete results;
-    }
-
-    return result >= 1.0 ? result : 1.0;
+    return auctionbot.GetMarket().GetRarityPriceMultiplier(itemId);
 }
 
 
 double PricingStrategy::GetCategoryPriceMultiplier(uint32 untilTime, uint32 auctionHouse)
 {
-    double result = 1.0;
-
-    QueryResult* results = CharacterDatabase.PQuery(
-        "SELECT COUNT(*) FROM (SELECT ROUND(`buytime`/3600/24/5) AS days FROM `ahbot_history` WHERE `category` = '%s' AND `won` = '1' AND `buytime` <= '%u' AND `auction_house` = '%u' GROUP BY `days`) q",
-        category->GetName().c_str(), untilTime, AhBot::factions[auctionHouse]);
-    if (results)
-    {
-        Field* fields = results->Fetch();
-        uint32 count = fields[0].GetUInt32();
-
-        if (count)
-        {
-            result += count;
-        }
-
-        delete results;
-    }
-
-    return result;
+    return 1.0 + auctionbot.GetMarket().GetCategorySaleDays(category->GetName(), untilTime, AhBot::factions[auctionHouse]);
 }
 
 double PricingStrategy::GetMultiplier(double count, double firstBuyTime, double lastBuyTime)
@@ -161,25 +101,7 @@ double PricingStrategy::GetMultiplier(double count, double firstBuyTime, double
 
 double PricingStrategy::GetItemPriceMultiplier(ItemPrototype const* proto, uint32 untilTime, uint32 auctionHouse)
 {
-    double result = 1.0;
-
-    QueryResult* results = CharacterDatabase.PQuery(
-        "SELECT count(*) FROM (SELECT ROUND(`buytime`/3600/24/5) AS `days` FROM `ahbot_history` WHERE `won` = '1' AND `item` = '%u' AND `buytime` <= '%u' AND `auction_house` = '%u' GROUP BY `days`) q",
-        proto->ItemId, untilTime, AhBot::factions[auctionHouse]);
-    if (results)
-    {
-        Field* fields = results->Fetch();
-        uint32 count = fields[0].GetUInt32();
-
-        if (count)
-        {
-            result += count;
-        }
-
-        delete results;
-    }
-
-    return result;
+    return 1.0 + auctionbot.GetMarket().GetItemSaleDays(proto->ItemId, untilTime, AhBot::factions[auctionHouse]);
 }
 
 uint32 PricingStrategy::ApplyQualityMultiplier(ItemPrototype const* proto, uint32 price)
@@ -208,17 +130,7 @@ uint32 PricingStrategy::GetDefaultBuyPrice(ItemPrototype const* proto)
     uint32 level = max(proto->ItemLevel, proto->RequiredLevel);
     if (proto->Class == ITEM_CLASS_QUEST)
     {
-        double result = 1.0;
-
-        QueryResult* results = WorldDatabase.PQuery(
-            "SELECT MAX(`QuestLevel`), MAX(`MinLevel`) FROM `quest_template` WHERE `ReqItemId1` = %u OR `ReqItemId2` = %u OR `ReqItemId3` = %u OR `ReqItemId4` = %u",
-            proto->ItemId, proto->ItemId, proto->ItemId, proto->ItemId);
-        if (results)
-        {
-            Field* fields = results->Fetch();
-            level = max(fields[0].GetUInt32(), fields[1].GetUInt32());
-            delete results;
-        }
+        level = auctionbot.GetMarket().GetQuestItemLevel(proto->ItemId);
     }
     price = max(price, sAhBotConfig.defaultMinPrice * level * level / 10);
     price = max(price, (uint32)100);
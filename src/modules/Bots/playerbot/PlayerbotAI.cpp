@@ -54,10 +54,17 @@ void PacketHandlingHelper::AddHandler(uint16 opcode, string handler)
  */
 void PacketHandlingHelper::Handle(ExternalEventHelper &helper)
 {
-    while (!queue.empty())
+    // take the pending packets out under the lock; handlers may send packets that end up queued here again
+    stack<WorldPacket> pending;
     {
-        helper.HandlePacket(handlers, queue.top());
-        queue.pop();
+        ACE_GUARD(ACE_Thread_Mutex, guard, queueLock);
+        pending.swap(queue);
+    }
+
+    while (!pending.empty())
+    {
+        helper.HandlePacket(handlers, pending.top());
+        pending.pop();
     }
 }
 
@@ -69,6 +76,7 @@ void PacketHandlingHelper::AddPacket(const WorldPacket& packet)
 {
     if (handlers.find(packet.GetOpcode()) != handlers.end())
     {
+        ACE_GUARD(ACE_Thread_Mutex, guard, queueLock);
         queue.push(WorldPacket(packet));
     }
 }
@@ -190,18 +198,33 @@ void PlayerbotAI::UpdateAI(uint32 elapsed)
 void PlayerbotAI::UpdateAIInternal(uint32 elapsed)
 {
     ExternalEventHelper helper(aiObjectContext);
-    while (!chatCommands.empty())
+
+    stack<ChatCommandHolder> commands;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, chatCommandsLock);
+        commands.swap(chatCommands);
+    }
+
+    while (!commands.empty())
     {
-        ChatCommandHolder holder = chatCommands.top();
+        ChatCommandHolder holder = commands.top();
         string command = holder.GetCommand();
         Player* owner = holder.GetOwner();
-        if (!helper.ParseChatCommand(command, owner) && holder.GetType() == CHAT_MSG_WHISPER)
+        if (command.size() > 2 && command.substr(0, 2) == "d " || command.size() > 3 && command.substr(0, 3) == "do ")
+        {
+            DoSpecificAction(command.substr(command.find(" ") + 1));
+        }
+        else if (command == "reset")
+        {
+            Reset();
+        }
+        else if (!helper.ParseChatCommand(command, owner) && holder.GetType() == CHAT_MSG_WHISPER)
         {
             ostringstream out; out << "Unknown command " << command;
             TellMaster(out);
             helper.ParseChatCommand("help");
         }
-        chatCommands.pop();
+        commands.pop();
     }
 
     botOutgoingPacketHandlers.Handle(helper);
@@ -299,6 +322,8 @@ void PlayerbotAI::HandleCommand(uint32 type, const string& text, Player& fromPla
         return;
     }
 
+    // commands are queued and executed by the bot's own AI update, which runs on the bot's map thread
+    ACE_GUARD(ACE_Thread_Mutex, guard, chatCommandsLock);
     if (type == CHAT_MSG_RAID_WARNING && filtered.find(bot->GetName()) != string::npos && filtered.find("award") == string::npos)
     {
         ChatCommandHolder cmd("warning", &fromPlayer, type);
@@ -306,20 +331,8 @@ void PlayerbotAI::HandleCommand(uint32 type, const string& text, Player& fromPla
         return;
     }
 
-    if (filtered.size() > 2 && filtered.substr(0, 2) == "d " || filtered.size() > 3 && filtered.substr(0, 3) == "do ")
-    {
-        std::string action = filtered.substr(filtered.find(" ") + 1);
-        DoSpecificAction(action);
-    }
-    else if (filtered == "reset")
-    {
-        Reset();
-    }
-    else
-    {
-        ChatCommandHolder cmd(filtered, &fromPlayer, type);
-        chatCommands.push(cmd);
-    }
+    ChatCommandHolder cmd(filtered, &fromPlayer, type);
+    chatCommands.push(cmd);
 }
 
 /**
@@ -437,6 +450,20 @@ uint32 PlayerbotAI::CalculateGlobalCooldown(uint32 spellid)
     return sPlayerbotAIConfig.reactDelay;
 }
 
+/**
+ * Returns the delay between two AI ticks of this bot.
+ * Bots nobody is playing with think slower while the server is overloaded.
+ */
+uint32 PlayerbotAI::GetReactDelay() const
+{
+    if (master && !master->GetPlayerbotAI())
+    {
+        return sPlayerbotAIConfig.reactDelay;
+    }
+
+    return sRandomPlayerbotMgr.GetBotReactDelay();
+}
+
 /**
  * Handles incoming packets from the master.
  * @param packet The packet to handle.
@@ -86,6 +86,7 @@ public:
 private:
     map<uint16, string> handlers;
     stack<WorldPacket> queue;
+    ACE_Thread_Mutex queueLock; ///< Packets are added from other sessions' threads while the bot thinks on its map thread.
 };
 
 /**
@@ -140,6 +141,7 @@ public:
     void ResetStrategies();
     void ReInitCurrentEngine();
     void Reset();
+    virtual uint32 GetReactDelay() const;
     bool IsTank(Player* player);
     bool IsHeal(Player* player);
     bool IsRanged(Player* player);
@@ -189,6 +191,7 @@ protected:
     BotState currentState;
     ChatHelper chatHelper;
     stack<ChatCommandHolder> chatCommands;
+    ACE_Thread_Mutex chatCommandsLock;
     PacketHandlingHelper botOutgoingPacketHandlers;
     PacketHandlingHelper masterIncomingPacketHandlers;
     PacketHandlingHelper masterOutgoingPacketHandlers;
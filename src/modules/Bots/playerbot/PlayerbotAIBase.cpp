@@ -86,8 +86,18 @@ bool PlayerbotAIBase::CanUpdateAI() const
  */
 void PlayerbotAIBase::YieldThread()
 {
-    if (nextAICheckDelay < sPlayerbotAIConfig.reactDelay)
+    uint32 reactDelay = GetReactDelay();
+    if (nextAICheckDelay < reactDelay)
     {
-        nextAICheckDelay = sPlayerbotAIConfig.reactDelay;
+        nextAICheckDelay = reactDelay;
     }
 }
+
+/**
+ * @brief Gets the minimum delay between two AI updates.
+ * @return The configured react delay in milliseconds.
+ */
+uint32 PlayerbotAIBase::GetReactDelay() const
+{
+    return sPlayerbotAIConfig.reactDelay;
+}
@@ -44,6 +44,12 @@ public:
      */
     void YieldThread();
 
+    /**
+     * @brief Gets the minimum delay between two AI updates.
+     * @return The delay in milliseconds.
+     */
+    virtual uint32 GetReactDelay() const;
+
     /**
      * @brief Updates the AI.
      * @param elapsed The time elapsed since the last update.
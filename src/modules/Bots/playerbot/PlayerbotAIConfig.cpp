@@ -19,6 +19,8 @@ PlayerbotAIConfig::PlayerbotAIConfig()
       globalCoolDown(0),
       reactDelay(0),
       maxWaitForMove(0),
+      overloadUpdateTime(0),
+      maxOverloadReactDelay(0),
       sightDistance(0.0f),
       spellDistance(0.0f),
       reactDistance(0.0f),
@@ -117,6 +119,8 @@ bool PlayerbotAIConfig::Initialize()
     globalCoolDown = (uint32) config.GetIntDefault("AiPlayerbot.GlobalCooldown", 500);
     maxWaitForMove = config.GetIntDefault("AiPlayerbot.MaxWaitForMove", 3000);
     reactDelay = (uint32) config.GetIntDefault("AiPlayerbot.ReactDelay", 100);
+    overloadUpdateTime = (uint32) config.GetIntDefault("AiPlayerbot.OverloadUpdateTime", 150);
+    maxOverloadReactDelay = (uint32) config.GetIntDefault("AiPlayerbot.MaxOverloadReactDelay", 1000);
 
     sightDistance = config.GetFloatDefault("AiPlayerbot.SightDistance", 50.0f);
     spellDistance = config.GetFloatDefault("AiPlayerbot.SpellDistance", 30.0f);
@@ -196,6 +200,7 @@ bool PlayerbotAIConfig::Initialize()
     }
 
     CreateRandomBots();
+    sRandomPlayerbotMgr.Init();
     sLog.outString("AI Playerbot configuration loaded");
 
     return true;
@@ -384,7 +389,7 @@ void PlayerbotAIConfig::CreateRandomBots()
             delete results;
         }
 
-        CharacterDatabase.Execute("DELETE FROM `ai_playerbot_random_bots`");
+        CharacterDatabase.DirectExecute("DELETE FROM `ai_playerbot_random_bots`");
         sLog.outBasic("Random bot accounts deleted");
     }
 
@@ -37,7 +37,9 @@ void PlayerbotHolder::UpdateAIInternal(uint32 elapsed)
 }
 
 /**
- * @brief Updates the sessions for all player bots.
+ * @brief Updates the sessions for all player bots on the world thread.
+ * Only packets that are not thread-safe are handled here, the others are
+ * handled by the bot's Player::Update on its map thread.
  * @param elapsed Time elapsed since the last update.
  */
 void PlayerbotHolder::UpdateSessions(uint32 elapsed)
@@ -51,7 +53,8 @@ void PlayerbotHolder::UpdateSessions(uint32 elapsed)
         }
         else if (bot->IsInWorld())
         {
-            bot->GetSession()->HandleBotPackets();
+            WorldSessionFilter updater(bot->GetSession());
+            bot->GetSession()->HandleBotPackets(updater);
         }
     }
 }
@@ -9,15 +9,20 @@
 #include "PlayerbotAI.h"
 #include "Player.h"
 #include "AiFactory.h"
+#include "UpdateTime.h"
 
 INSTANTIATE_SINGLETON_1(RandomPlayerbotMgr);
 
+#define RANDOM_BOT_EVENT_SAVE_INTERVAL 5000         // ms between two batched writes of changed bot event values
+#define RANDOM_BOT_EVENT_SAVE_CHUNK_SIZE 500        // rows per DELETE / INSERT statement of such a batch
+
 /**
  * RandomPlayerbotMgr is responsible for managing random player bots in the game.
  * It handles the creation, updating, and processing of these bots, ensuring they
  * behave in a way that simulates real player activity.
  */
-RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0)
+RandomPlayerbotMgr::RandomPlayerbotMgr() : PlayerbotHolder(), processTicks(0), reactDelay(sPlayerbotAIConfig.reactDelay),
+    saveEventValuesTimer(0), botCharactersLoaded(false)
 {
 }
 
@@ -25,6 +30,270 @@ RandomPlayerbotMgr::~RandomPlayerbotMgr()
 {
 }
 
+/**
+ * Runs on the world thread every tick. Bot AI itself is updated by Player::Update
+ * on the map threads; here only the think interval of bots nobody plays with is
+ * stretched in proportion to the world load, so an overloaded server sheds bot work first.
+ */
+void RandomPlayerbotMgr::UpdateAI(uint32 elapsed)
+{
+    uint32 delay = sPlayerbotAIConfig.reactDelay;
+    uint32 updateTime = sWorldUpdateTime.GetAverageUpdateTime();
+    if (sPlayerbotAIConfig.overloadUpdateTime && updateTime > sPlayerbotAIConfig.overloadUpdateTime)
+    {
+        delay = std::min(sPlayerbotAIConfig.maxOverloadReactDelay,
+            delay * updateTime / sPlayerbotAIConfig.overloadUpdateTime);
+        delay = std::max(delay, sPlayerbotAIConfig.reactDelay);
+    }
+    reactDelay = delay;
+
+    saveEventValuesTimer += elapsed;
+    if (saveEventValuesTimer >= RANDOM_BOT_EVENT_SAVE_INTERVAL)
+    {
+        saveEventValuesTimer = 0;
+        SaveEventValues();
+    }
+
+    PlayerbotHolder::UpdateAI(elapsed);
+}
+
+/**
+ * Loads everything the bot tick needs from the database once at startup,
+ * so that no blocking query is left in the update loop.
+ */
+void RandomPlayerbotMgr::Init()
+{
+    LoadEventValues();
+    LoadSpawnPoints();
+    LoadBotCharacters();
+}
+
+void RandomPlayerbotMgr::LoadEventValues()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, eventValuesLock);
+
+    eventValues.clear();
+    dirtyEventValues.clear();
+
+    QueryResult* results = CharacterDatabase.Query(
+            "SELECT `bot`, `event`, `value`, `time`, `validIn` FROM `ai_playerbot_random_bots` WHERE `owner` = 0");
+    if (!results)
+    {
+        return;
+    }
+
+    do
+    {
+        Field* fields = results->Fetch();
+        eventValues[fields[0].GetUInt32()][fields[1].GetCppString()] =
+            RandomBotEvent(fields[2].GetUInt32(), fields[3].GetUInt32(), fields[4].GetUInt32());
+    } while (results->NextRow());
+    delete results;
+
+    sLog.outString("Loaded random bot values for %u bots", uint32(eventValues.size()));
+}
+
+/**
+ * Writes the event values changed since the last call in one transaction:
+ * one DELETE per event name and multi-row INSERTs for the values still set.
+ */
+void RandomPlayerbotMgr::SaveEventValues()
+{
+    map<string, vector<uint32> > deletes;
+    vector<string> inserts;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, eventValuesLock);
+        if (dirtyEventValues.empty())
+        {
+            return;
+        }
+
+        for (set<pair<uint32, string> >::const_iterator i = dirtyEventValues.begin(); i != dirtyEventValues.end(); ++i)
+        {
+            deletes[i->second].push_back(i->first);
+
+            BotEventMap::const_iterator bot = eventValues.find(i->first);
+            if (bot == eventValues.end())
+            {
+                continue;
+            }
+
+            map<string, RandomBotEvent>::const_iterator event = bot->second.find(i->second);
+            if (event == bot->second.end())
+            {
+                continue;
+            }
+
+            ostringstream row;
+            row << "('0', '" << i->first << "', '" << event->second.lastChangeTime << "', '" << event->second.validIn
+                << "', '" << i->second << "', '" << event->second.value << "')";
+            inserts.push_back(row.str());
+        }
+        dirtyEventValues.clear();
+    }
+
+    // statements are built as plain strings: a batch easily exceeds the PExecute buffer
+    CharacterDatabase.BeginTransaction();
+    for (map<string, vector<uint32> >::const_iterator i = deletes.begin(); i != deletes.end(); ++i)
+    {
+        for (size_t first = 0; first < i->second.size(); first += RANDOM_BOT_EVENT_SAVE_CHUNK_SIZE)
+        {
+            ostringstream sql;
+            sql << "DELETE FROM `ai_playerbot_random_bots` WHERE `owner` = 0 AND `event` = '" << i->first << "' AND `bot` IN (";
+            for (size_t j = first; j < i->second.size() && j < first + RANDOM_BOT_EVENT_SAVE_CHUNK_SIZE; ++j)
+            {
+                sql << (j == first ? "" : ",") << i->second[j];
+            }
+            sql << ")";
+            CharacterDatabase.Execute(sql.str().c_str());
+        }
+    }
+
+    for (size_t first = 0; first < inserts.size(); first += RANDOM_BOT_EVENT_SAVE_CHUNK_SIZE)
+    {
+        ostringstream sql;
+        sql << "INSERT INTO `ai_playerbot_random_bots` (`owner`, `bot`, `time`, `validIn`, `event`, `value`) VALUES ";
+        for (size_t j = first; j < inserts.size() && j < first + RANDOM_BOT_EVENT_SAVE_CHUNK_SIZE; ++j)
+        {
+            sql << (j == first ? "" : ", ") << inserts[j];
+        }
+        CharacterDatabase.Execute(sql.str().c_str());
+    }
+    CharacterDatabase.CommitTransaction();
+}
+
+/**
+ * Queues a reload of the random bot characters. The query runs behind the
+ * character saves queued before it, so bots created at startup are seen.
+ */
+void RandomPlayerbotMgr::LoadBotCharacters()
+{
+    if (sPlayerbotAIConfig.randomBotAccounts.empty())
+    {
+        botCharactersLoaded = true;
+        return;
+    }
+
+    ostringstream accounts;
+    for (list<uint32>::iterator i = sPlayerbotAIConfig.randomBotAccounts.begin(); i != sPlayerbotAIConfig.randomBotAccounts.end(); ++i)
+    {
+        if (i != sPlayerbotAIConfig.randomBotAccounts.begin())
+        {
+            accounts << ",";
+        }
+        accounts << *i;
+    }
+
+    // bots added by other owners are left out here, the ones of owner 0 are known from the event values
+    CharacterDatabase.AsyncPQuery(this, &RandomPlayerbotMgr::LoadBotCharactersCallback,
+            "SELECT `c`.`guid`, `c`.`race` FROM `characters` `c` WHERE `c`.`account` IN (%s) AND NOT EXISTS "
+            "(SELECT 1 FROM `ai_playerbot_random_bots` `r` WHERE `r`.`bot` = `c`.`guid` AND `r`.`owner` <> 0 AND `r`.`event` = 'add')",
+            accounts.str().c_str());
+}
+
+void RandomPlayerbotMgr::LoadBotCharactersCallback(QueryResult* result)
+{
+    botCharacters.clear();
+    botCharactersLoaded = true;
+    if (!result)
+    {
+        return;
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+        botCharacters.push_back(make_pair(fields[0].GetUInt32(), fields[1].GetUInt8()));
+    } while (result->NextRow());
+    delete result;
+}
+
+static int32 SpawnPointCell(float coord)
+{
+    return int32(floor(coord / sPlayerbotAIConfig.randomBotTeleportDistance));
+}
+
+static uint64 MakeSpawnPointCellKey(uint32 mapId, int32 cellX, int32 cellY)
+{
+    return (uint64(mapId) << 32) | (uint64(uint16(cellX)) << 16) | uint64(uint16(cellY));
+}
+
+/**
+ * Indexes the creature spawns of ObjectMgr for random teleports: all spawns by
+ * map and grid cell, and one spawn per creature entry by average creature level.
+ */
+void RandomPlayerbotMgr::LoadSpawnPoints()
+{
+    spawnPoints.clear();
+    levelLocations.clear();
+
+    if (!sPlayerbotAIConfig.randomBotTeleportDistance)
+    {
+        return;
+    }
+
+    set<uint32> randomBotMaps(sPlayerbotAIConfig.randomBotMaps.begin(), sPlayerbotAIConfig.randomBotMaps.end());
+    set<uint32> indexedEntries;
+
+    CreatureDataMap const* creatures = sObjectMgr.GetCreatureDataMap();
+    for (CreatureDataMap::const_iterator i = creatures->begin(); i != creatures->end(); ++i)
+    {
+        CreatureData const& data = i->second;
+        CreatureInfo const* cinfo = ObjectMgr::GetCreatureTemplate(data.id);
+        if (!cinfo)
+        {
+            continue;
+        }
+
+        RandomBotSpawnPoint point;
+        point.x = data.posX;
+        point.y = data.posY;
+        point.z = data.posZ;
+        point.minLevel = cinfo->MinLevel;
+        point.maxLevel = cinfo->MaxLevel;
+        spawnPoints[MakeSpawnPointCellKey(data.mapid, SpawnPointCell(data.posX), SpawnPointCell(data.posY))].push_back(point);
+
+        if (randomBotMaps.find(data.mapid) != randomBotMaps.end() && indexedEntries.insert(data.id).second)
+        {
+            uint32 level = (cinfo->MinLevel + cinfo->MaxLevel + 1) / 2;
+            levelLocations[level].push_back(WorldLocation(data.mapid, data.posX, data.posY, data.posZ, 0));
+        }
+    }
+
+    sLog.outString("Indexed %u creature spawns for random bot teleports", uint32(creatures->size()));
+}
+
+void RandomPlayerbotMgr::GetSpawnPointsNear(uint32 mapId, float x, float y, vector<RandomBotSpawnPoint const*>& points)
+{
+    if (spawnPoints.empty())
+    {
+        return;
+    }
+
+    float range = sPlayerbotAIConfig.randomBotTeleportDistance / 2;
+    int32 centerX = SpawnPointCell(x);
+    int32 centerY = SpawnPointCell(y);
+    for (int32 dx = -1; dx <= 1; ++dx)
+    {
+        for (int32 dy = -1; dy <= 1; ++dy)
+        {
+            SpawnPointCellMap::const_iterator cell = spawnPoints.find(MakeSpawnPointCellKey(mapId, centerX + dx, centerY + dy));
+            if (cell == spawnPoints.end())
+            {
+                continue;
+            }
+
+            for (vector<RandomBotSpawnPoint>::const_iterator i = cell->second.begin(); i != cell->second.end(); ++i)
+            {
+                if (fabs(i->x - x) < range && fabs(i->y - y) < range)
+                {
+                    points.push_back(&*i);
+                }
+            }
+        }
+    }
+}
+
 void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
 {
     SetNextCheckDelay(sPlayerbotAIConfig.randomBotUpdateInterval * 1000);
@@ -34,6 +303,13 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
         return;
     }
 
+    // nothing to add from before the first load of the bot characters
+    if (!botCharactersLoaded)
+    {
+        SetNextCheckDelay(1000);
+        return;
+    }
+
     sLog.outBasic("Processing random bots...");
 
     int maxAllowedBotCount = GetEventValue(0, "bot_count");
@@ -97,6 +373,8 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
     sLog.outString("%d bots processed. %d alliance and %d horde bots added. %d bots online. Next check in %d seconds",
             botProcessed, allianceNewBots, hordeNewBots, playerBots.size(), sPlayerbotAIConfig.randomBotUpdateInterval);
 
+    LoadBotCharacters();
+
     if (processTicks++ == 1)
     {
         PrintStats();
@@ -292,27 +570,11 @@ void RandomPlayerbotMgr::RandomTeleport(Player* bot, vector<WorldLocation> &locs
 void RandomPlayerbotMgr::RandomTeleportForLevel(Player* bot)
 {
     vector<WorldLocation> locs;
-    QueryResult* results = WorldDatabase.PQuery("SELECT `map`, `position_x`, `position_y`, `position_z` FROM ("
-        "SELECT MIN(`c`.`map`) `map`, MIN(`c`.`position_x`) `position_x`, MIN(`c`.`position_y`) `position_y`, "
-    "MIN(`c`.`position_z`) `position_z`, AVG(`t`.`maxlevel`), AVG(`t`.`minlevel`), "
-        "%u - (AVG(`t`.`maxlevel`) + AVG(`t`.`minlevel`)) / 2 `delta` FROM `creature` `c` "
-    "INNER JOIN `creature_template` `t` ON `c`.`id` = `t`.`entry` GROUP BY `t`.`entry`) `q` "
-        "WHERE `delta` >= 0 AND `delta` <= %u AND `map` IN (%s)",
-
-        bot->getLevel(), sPlayerbotAIConfig.randomBotTeleLevel, sPlayerbotAIConfig.randomBotMapsAsString.c_str());
-    if (results)
+    uint32 level = bot->getLevel();
+    map<uint32, vector<WorldLocation> >::const_iterator i = levelLocations.lower_bound(level > sPlayerbotAIConfig.randomBotTeleLevel ? level - sPlayerbotAIConfig.randomBotTeleLevel : 0);
+    for (; i != levelLocations.end() && i->first <= level; ++i)
     {
-        do
-        {
-            Field* fields = results->Fetch();
-            uint32 mapId = fields[0].GetUInt32();
-            float x = fields[1].GetFloat();
-            float y = fields[2].GetFloat();
-            float z = fields[3].GetFloat();
-            WorldLocation loc(mapId, x, y, z, 0);
-            locs.push_back(loc);
-        } while (results->NextRow());
-        delete results;
+        locs.insert(locs.end(), i->second.begin(), i->second.end());
     }
 
     RandomTeleport(bot, locs);
@@ -320,21 +582,13 @@ void RandomPlayerbotMgr::RandomTeleportForLevel(Player* bot)
 
 void RandomPlayerbotMgr::RandomTeleport(Player* bot, uint32 mapId, float teleX, float teleY, float teleZ)
 {
+    vector<RandomBotSpawnPoint const*> points;
+    GetSpawnPointsNear(mapId, teleX, teleY, points);
+
     vector<WorldLocation> locs;
-    QueryResult* results = WorldDatabase.PQuery("SELECT `position_x`, `position_y`, `position_z` FROM `creature` WHERE `map` = '%u' AND ABS(`position_x` - '%f') < '%u' AND ABS(`position_y` - '%f') < '%u'",
-            mapId, teleX, sPlayerbotAIConfig.randomBotTeleportDistance / 2, teleY, sPlayerbotAIConfig.randomBotTeleportDistance / 2);
-    if (results)
+    for (vector<RandomBotSpawnPoint const*>::const_iterator i = points.begin(); i != points.end(); ++i)
     {
-        do
-        {
-            Field* fields = results->Fetch();
-            float x = fields[0].GetFloat();
-            float y = fields[1].GetFloat();
-            float z = fields[2].GetFloat();
-            WorldLocation loc(mapId, x, y, z, 0);
-            locs.push_back(loc);
-        } while (results->NextRow());
-        delete results;
+        locs.push_back(WorldLocation(mapId, (*i)->x, (*i)->y, (*i)->z, 0));
     }
 
     RandomTeleport(bot, locs);
@@ -427,29 +681,31 @@ void RandomPlayerbotMgr::RandomizeFirst(Player* bot)
 
 uint32 RandomPlayerbotMgr::GetZoneLevel(uint32 mapId, float teleX, float teleY, float teleZ)
 {
-    uint32 maxLevel = sWorld.getConfig(CONFIG_UINT32_MAX_PLAYER_LEVEL);
+    vector<RandomBotSpawnPoint const*> points;
+    GetSpawnPointsNear(mapId, teleX, teleY, points);
 
-    uint32 level;
-    QueryResult *results = WorldDatabase.PQuery("SELECT AVG(`t`.`minlevel`) `minlevel`, AVG(`t`.`maxlevel`) `maxlevel` FROM `creature` `c` "
-            "INNER JOIN `creature_template` `t` ON `c`.`id` = `t`.`entry` "
-            "WHERE `map` = '%u' AND `minlevel` > 1 AND ABS(`position_x` - '%f') < '%u' AND ABS(`position_y` - '%f') < '%u'",
-            mapId, teleX, sPlayerbotAIConfig.randomBotTeleportDistance / 2, teleY, sPlayerbotAIConfig.randomBotTeleportDistance / 2);
-
-    if (results)
+    uint32 count = 0, minLevelSum = 0, maxLevelSum = 0;
+    for (vector<RandomBotSpawnPoint const*>::const_iterator i = points.begin(); i != points.end(); ++i)
     {
-        Field* fields = results->Fetch();
-        uint32 minLevel = fields[0].GetUInt32();
-        uint32 maxLevel = fields[1].GetUInt32();
-        level = urand(minLevel, maxLevel);
-        if (level > maxLevel)
+        if ((*i)->minLevel > 1)
         {
-            level = maxLevel;
+            ++count;
+            minLevelSum += (*i)->minLevel;
+            maxLevelSum += (*i)->maxLevel;
         }
-        delete results;
     }
-    else
+
+    if (!count)
+    {
+        return 0;
+    }
+
+    uint32 minLevel = minLevelSum / count;
+    uint32 maxLevel = maxLevelSum / count;
+    uint32 level = urand(minLevel, maxLevel);
+    if (level > maxLevel)
     {
-        level = urand(1, maxLevel);
+        level = maxLevel;
     }
 
     return level;
@@ -513,19 +769,13 @@ list<uint32> RandomPlayerbotMgr::GetBots()
 {
     list<uint32> bots;
 
-    // Query the database to get the list of random bots
-    QueryResult* results = CharacterDatabase.Query(
-            "SELECT `bot` FROM `ai_playerbot_random_bots` WHERE `owner` = 0 AND `event` = 'add'");
-
-    if (results)
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, eventValuesLock, bots);
+    for (BotEventMap::const_iterator i = eventValues.begin(); i != eventValues.end(); ++i)
     {
-        do
+        if (i->second.find("add") != i->second.end())
         {
-            Field* fields = results->Fetch();
-            uint32 bot = fields[0].GetUInt32();
-            bots.push_back(bot);
-        } while (results->NextRow());
-        delete results;
+            bots.push_back(i->first);
+        }
     }
 
     return bots;
@@ -533,94 +783,99 @@ list<uint32> RandomPlayerbotMgr::GetBots()
 
 vector<uint32> RandomPlayerbotMgr::GetFreeBots(bool alliance)
 {
-    set<uint32> bots;
-
-    QueryResult* results = CharacterDatabase.PQuery(
-        "SELECT `bot` FROM `ai_playerbot_random_bots` WHERE `event` = 'add'"
-    );
+    list<uint32> botList = GetBots();
+    set<uint32> bots(botList.begin(), botList.end());
 
-    if (results)
+    vector<uint32> guids;
+    for (vector<pair<uint32, uint8> >::const_iterator i = botCharacters.begin(); i != botCharacters.end(); ++i)
     {
-        do
-        {
-            Field* fields = results->Fetch();
-            uint32 bot = fields[0].GetUInt32();
-            bots.insert(bot);
-        } while (results->NextRow());
-        delete results;
+        uint32 guid = i->first;
+        uint32 race = i->second;
+        if (bots.find(guid) == bots.end() &&
+                ((alliance && IsAlliance(race)) || ((!alliance && !IsAlliance(race))
+        )))
+            guids.push_back(guid);
     }
 
-    vector<uint32> guids;
-    for (list<uint32>::iterator i = sPlayerbotAIConfig.randomBotAccounts.begin(); i != sPlayerbotAIConfig.randomBotAccounts.end(); i++)
-    {
-        uint32 accountId = *i;
-        if (!sAccountMgr.GetCharactersCount(accountId))
-        {
-            continue;
-        }
+    return guids;
+}
 
-        QueryResult *result = CharacterDatabase.PQuery("SELECT `guid`, `race` FROM `characters` WHERE `account` = '%u'", accountId);
-        if (!result)
-        {
-            continue;
-        }
+uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, string event)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, eventValuesLock, 0);
 
-        do
-        {
-            Field* fields = result->Fetch();
-            uint32 guid = fields[0].GetUInt32();
-            uint32 race = fields[1].GetUInt32();
-            if (bots.find(guid) == bots.end() &&
-                    ((alliance && IsAlliance(race)) || ((!alliance && !IsAlliance(race))
-            )))
-                guids.push_back(guid);
-        } while (result->NextRow());
-        delete result;
+    BotEventMap::const_iterator i = eventValues.find(bot);
+    if (i == eventValues.end())
+    {
+        return 0;
     }
 
+    map<string, RandomBotEvent>::const_iterator j = i->second.find(event);
+    if (j == i->second.end())
+    {
+        return 0;
+    }
 
-    return guids;
+    if ((time(0) - j->second.lastChangeTime) >= j->second.validIn)
+    {
+        return 0;
+    }
+
+    return j->second.value;
 }
 
-uint32 RandomPlayerbotMgr::GetEventValue(uint32 bot, string event)
+uint32 RandomPlayerbotMgr::SetEventValue(uint32 bot, string event, uint32 value, uint32 validIn)
 {
-    uint32 value = 0;
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, eventValuesLock, value);
 
-    // Query the database to get the event value for the specified bot
-    QueryResult* results = CharacterDatabase.PQuery(
-            "SELECT `value`, `time`, `validIn` FROM `ai_playerbot_random_bots` WHERE `owner` = 0 AND `bot` = '%u' AND `event` = '%s'",
-            bot, event.c_str());
-
-    if (results)
+    if (value)
     {
-        Field* fields = results->Fetch();
-        value = fields[0].GetUInt32();
-        uint32 lastChangeTime = fields[1].GetUInt32();
-        uint32 validIn = fields[2].GetUInt32();
-        if ((time(0) - lastChangeTime) >= validIn)
+        eventValues[bot][event] = RandomBotEvent(value, (uint32)time(0), validIn);
+    }
+    else
+    {
+        BotEventMap::iterator i = eventValues.find(bot);
+        if (i != eventValues.end())
         {
-            value = 0;
+            i->second.erase(event);
+            if (i->second.empty())
+            {
+                eventValues.erase(i);
+            }
         }
-        delete results;
     }
 
+    // written to the database by the next SaveEventValues()
+    dirtyEventValues.insert(make_pair(bot, event));
     return value;
 }
 
-uint32 RandomPlayerbotMgr::SetEventValue(uint32 bot, string event, uint32 value, uint32 validIn)
+void RandomPlayerbotMgr::SetEventValidIn(uint32 bot, string event, uint32 validIn)
 {
-    // Delete the existing event value for the specified bot
-    CharacterDatabase.PExecute("DELETE FROM `ai_playerbot_random_bots` WHERE `owner` = 0 and `bot` = '%u' and `event` = '%s'",
-            bot, event.c_str());
-    if (value)
+    ACE_GUARD(ACE_Thread_Mutex, guard, eventValuesLock);
+
+    BotEventMap::iterator i = eventValues.find(bot);
+    if (i == eventValues.end())
     {
-        // Insert the new event value for the specified bot
-        CharacterDatabase.PExecute(
-                "INSERT INTO `ai_playerbot_random_bots` (`owner`, `bot`, `time`, `validIn`, `event`, `value`) VALUES ('%u', '%u', '%u', '%u', '%s', '%u')",
-                0, bot, (uint32)time(0), validIn, event.c_str(), value);
+        return;
     }
 
-    return value;
+    map<string, RandomBotEvent>::iterator j = i->second.find(event);
+    if (j == i->second.end())
+    {
+        return;
+    }
+
+    j->second.validIn = validIn;
+    dirtyEventValues.insert(make_pair(bot, event));
+}
+
+void RandomPlayerbotMgr::ResetEventValues()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, eventValuesLock);
+
+    eventValues.clear();
+    dirtyEventValues.clear();
 }
 
 bool ChatHandler::HandlePlayerbotConsoleCommand(char* args)
@@ -643,6 +898,7 @@ bool ChatHandler::HandlePlayerbotConsoleCommand(char* args)
     if (cmd == "reset")
     {
         // Reset all random bots
+        sRandomPlayerbotMgr.ResetEventValues();
         CharacterDatabase.PExecute("DELETE FROM `ai_playerbot_random_bots`");
         sLog.outBasic("Random bots were reset for all players");
         return true;
@@ -691,10 +947,8 @@ bool ChatHandler::HandlePlayerbotConsoleCommand(char* args)
                         sRandomPlayerbotMgr.IncreaseLevel(bot);
                     }
                     uint32 randomTime = urand(sPlayerbotAIConfig.minRandomBotRandomizeTime, sPlayerbotAIConfig.maxRandomBotRandomizeTime);
-                    CharacterDatabase.PExecute("UPDATE `ai_playerbot_random_bots` SET `validIn` = '%u' WHERE `event` = 'randomize' AND `bot` = '%u'",
-                            randomTime, bot->GetGUIDLow());
-                    CharacterDatabase.PExecute("UPDATE `ai_playerbot_random_bots` SET `validIn` = '%u' WHERE `event` = 'logout' AND `bot` = '%u'",
-                            sPlayerbotAIConfig.maxRandomBotInWorldTime, bot->GetGUIDLow());
+                    sRandomPlayerbotMgr.SetEventValidIn(bot->GetGUIDLow(), "randomize", randomTime);
+                    sRandomPlayerbotMgr.SetEventValidIn(bot->GetGUIDLow(), "logout", sPlayerbotAIConfig.maxRandomBotInWorldTime);
                 } while (results->NextRow());
 
                 delete results;
@@ -5,14 +5,39 @@
 #include "PlayerbotAIBase.h"
 #include "PlayerbotMgr.h"
 
+#include <atomic>
+
 class WorldPacket;
 class Player;
 class Unit;
 class Object;
 class Item;
+class QueryResult;
 
 using namespace std;
 
+/**
+ * @brief In-memory copy of one `ai_playerbot_random_bots` row.
+ */
+struct RandomBotEvent
+{
+    RandomBotEvent() : value(0), lastChangeTime(0), validIn(0) {}
+    RandomBotEvent(uint32 value, uint32 lastChangeTime, uint32 validIn) : value(value), lastChangeTime(lastChangeTime), validIn(validIn) {}
+
+    uint32 value;
+    uint32 lastChangeTime;
+    uint32 validIn;
+};
+
+/**
+ * @brief A creature spawn point used to pick random teleport destinations.
+ */
+struct RandomBotSpawnPoint
+{
+    float x, y, z;
+    uint32 minLevel, maxLevel;
+};
+
 class MANGOS_DLL_SPEC RandomPlayerbotMgr : public PlayerbotHolder
 {
     public:
@@ -24,6 +49,11 @@ class MANGOS_DLL_SPEC RandomPlayerbotMgr : public PlayerbotHolder
     virtual ~RandomPlayerbotMgr();
 
     public:
+        void Init();
+        void SaveEventValues();
+        void ResetEventValues();
+        void SetEventValidIn(uint32 bot, string event, uint32 validIn);
+        void LoadBotCharactersCallback(QueryResult* result);
         bool IsRandomBot(Player* bot);
         bool IsRandomBot(uint32 bot);
         void Randomize(Player* bot);
@@ -41,7 +71,9 @@ class MANGOS_DLL_SPEC RandomPlayerbotMgr : public PlayerbotHolder
         void SetLootAmount(Player* bot, uint32 value);
         uint32 GetTradeDiscount(Player* bot);
         void Refresh(Player* bot);
+        virtual void UpdateAI(uint32 elapsed) override;
         virtual void UpdateAIInternal(uint32 elapsed);
+        uint32 GetBotReactDelay() const { return reactDelay; }
 
     protected:
         virtual void OnBotLoginInternal(Player * const bot) {}
@@ -58,10 +90,28 @@ class MANGOS_DLL_SPEC RandomPlayerbotMgr : public PlayerbotHolder
         void RandomTeleportForLevel(Player* bot);
         void RandomTeleport(Player* bot, vector<WorldLocation> &locs);
         uint32 GetZoneLevel(uint32 mapId, float teleX, float teleY, float teleZ);
+        void LoadEventValues();
+        void LoadBotCharacters();
+        void LoadSpawnPoints();
+        void GetSpawnPointsNear(uint32 mapId, float x, float y, vector<RandomBotSpawnPoint const*>& points);
 
     private:
+        typedef map<uint32 /*bot*/, map<string, RandomBotEvent> > BotEventMap;
+        typedef UNORDERED_MAP<uint64 /*map and cell*/, vector<RandomBotSpawnPoint> > SpawnPointCellMap;
+
         vector<Player*> players;
         int processTicks;
+        std::atomic<uint32> reactDelay;                 ///< think interval of unattended bots, read from the map threads
+
+        BotEventMap eventValues;                        ///< all `ai_playerbot_random_bots` rows of owner 0
+        set<pair<uint32, string> > dirtyEventValues;    ///< rows changed since the last SaveEventValues()
+        ACE_Thread_Mutex eventValuesLock;               ///< bot actions read and write event values from the map threads
+        uint32 saveEventValuesTimer;
+
+        vector<pair<uint32, uint8> > botCharacters;     ///< guid and race of the characters on random bot accounts not added by other owners
+        bool botCharactersLoaded;                       ///< the first LoadBotCharacters() query has returned
+        SpawnPointCellMap spawnPoints;                  ///< creature spawns by map and grid cell, for random teleports
+        map<uint32, vector<WorldLocation> > levelLocations; ///< one spawn per creature entry, by average creature level
 };
 
 #define sRandomPlayerbotMgr MaNGOS::Singleton<RandomPlayerbotMgr>::Instance()
@@ -2,9 +2,12 @@
 #include "Event.h"
 #include "Value.h"
 #include "AiObject.h"
+#include "NamedObjectIds.h"
 
 namespace ai
 {
+    class Action;
+
     class NextAction
     {
     public:
@@ -12,15 +15,26 @@ namespace ai
         {
             this->name = name;
             this->relevance = relevance;
+            this->id = NAMED_OBJECT_NO_ID;
         }
         NextAction(const NextAction& o)
         {
             this->name = o.name;
             this->relevance = o.relevance;
+            this->id = o.id;
         }
 
     public:
         string getName() { return name; }
+        const string& getNameRef() const { return name; }
+        uint32 getId()
+        {
+            if (id == NAMED_OBJECT_NO_ID)
+            {
+                id = NamedObjectIds<Action>::Intern(name);
+            }
+            return id;
+        }
         float getRelevance() {return relevance;}
 
     public:
@@ -33,6 +47,7 @@ namespace ai
     private:
         float relevance;
         std::string name;
+        uint32 id;
     };
 
     //---------------------------------------------------------------------------------------------------------------------
@@ -78,6 +93,7 @@ namespace ai
         {
             this->action = NULL;
             this->name = name;
+            this->id = NAMED_OBJECT_NO_ID;
             this->prerequisites = prerequisites;
             this->alternatives = alternatives;
             this->continuers = continuers;
@@ -93,6 +109,15 @@ namespace ai
         Action* getAction() { return action; }
         void setAction(Action* action) { this->action = action; }
         string getName() { return name; }
+        void setId(uint32 id) { this->id = id; }
+        uint32 getId()
+        {
+            if (id == NAMED_OBJECT_NO_ID)
+            {
+                id = NamedObjectIds<Action>::Intern(name);
+            }
+            return id;
+        }
 
     public:
         NextAction** getContinuers() { return NextAction::merge(NextAction::clone(continuers), action->getContinuers()); }
@@ -101,6 +126,7 @@ namespace ai
 
     private:
         string name;
+        uint32 id;
         Action* action;
         NextAction** continuers;
         NextAction** alternatives;
@@ -134,5 +160,5 @@ namespace ai
 
 }
 
-#define AI_VALUE(type, name) context->GetValue<type>(name)->Get()
+#define AI_VALUE(type, name) AI_NAMED_VALUE(type, name)->Get()
 #define AI_VALUE2(type, name, param) context->GetValue<type>(name, param)->Get()
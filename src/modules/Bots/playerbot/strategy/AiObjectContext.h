@@ -21,12 +21,23 @@ namespace ai
         virtual Action* GetAction(string name) { return actionContexts.GetObject(name, ai); }
         virtual UntypedValue* GetUntypedValue(string name) { return valueContexts.GetObject(name, ai); }
 
+        // lookups by interned name id, by name for names without id (see NamedObjectIds)
+        Trigger* GetTrigger(uint32 id, const string& name) { return id != NAMED_OBJECT_NO_ID ? triggerContexts.GetObject(id, ai) : GetTrigger(name); }
+        Action* GetAction(uint32 id, const string& name) { return id != NAMED_OBJECT_NO_ID ? actionContexts.GetObject(id, ai) : GetAction(name); }
+        UntypedValue* GetUntypedValue(uint32 id, char const* name) { return id != NAMED_OBJECT_NO_ID ? valueContexts.GetObject(id, ai) : GetUntypedValue(string(name)); }
+
         template<class T>
         Value<T>* GetValue(string name)
         {
             return dynamic_cast<Value<T>*>(GetUntypedValue(name));
         }
 
+        template<class T>
+        Value<T>* GetValue(uint32 id, char const* name)
+        {
+            return dynamic_cast<Value<T>*>(GetUntypedValue(id, name));
+        }
+
         template<class T>
         Value<T>* GetValue(string name, string param)
         {
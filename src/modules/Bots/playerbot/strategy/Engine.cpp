@@ -230,6 +230,11 @@ bool Engine::DoNextAction(Unit* unit, int depth)
 }
 
 ActionNode* Engine::CreateActionNode(string name)
+{
+    return CreateActionNode(NamedObjectIds<Action>::Intern(name), name);
+}
+
+ActionNode* Engine::CreateActionNode(uint32 id, const string& name)
 {
     for (map<string, Strategy*>::iterator i = strategies.begin(); i != strategies.end(); i++)
     {
@@ -237,13 +242,16 @@ ActionNode* Engine::CreateActionNode(string name)
         ActionNode* node = strategy->GetAction(name);
         if (node)
         {
+            node->setId(id);
             return node;
         }
     }
-    return new ActionNode (name,
+    ActionNode* node = new ActionNode (name,
         /*P*/ NULL,
         /*A*/ NULL,
         /*C*/ NULL);
+    node->setId(id);
+    return node;
 }
 
 bool Engine::MultiplyAndPush(NextAction** actions, float forceRelevance, bool skipPrerequisites, Event event)
@@ -256,7 +264,7 @@ bool Engine::MultiplyAndPush(NextAction** actions, float forceRelevance, bool sk
             NextAction* nextAction = actions[j];
             if (nextAction)
             {
-                ActionNode* action = CreateActionNode(nextAction->getName());
+                ActionNode* action = CreateActionNode(nextAction->getId(), nextAction->getNameRef());
                 InitializeAction(action);
 
                 float k = nextAction->getRelevance();
@@ -406,7 +414,7 @@ void Engine::ProcessTriggers()
         Trigger* trigger = node->getTrigger();
         if (!trigger)
         {
-            trigger = aiObjectContext->GetTrigger(node->getName());
+            trigger = aiObjectContext->GetTrigger(node->getId(), node->getName());
             node->setTrigger(trigger);
         }
 
@@ -489,7 +497,7 @@ Action* Engine::InitializeAction(ActionNode* actionNode)
     Action* action = actionNode->getAction();
     if (!action)
     {
-        action = aiObjectContext->GetAction(actionNode->getName());
+        action = aiObjectContext->GetAction(actionNode->getId(), actionNode->getName());
         actionNode->setAction(action);
     }
     return action;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "NamedObjectIds.h"
+
 namespace ai
 {
     using namespace std;
@@ -159,9 +161,38 @@ namespace ai
         void Add(NamedObjectContext<T>* context)
         {
             contexts.push_back(context);
+
+            // names resolved to nothing so far may be provided by the new context
+            objectsById.clear();
+            resolvedIds.clear();
         }
 
         T* GetObject(string name, PlayerbotAI* ai)
+        {
+            uint32 id = NamedObjectIds<T>::Intern(name);
+            return id != NAMED_OBJECT_NO_ID ? GetObject(id, ai) : FindObject(name, ai);
+        }
+
+        T* GetObject(uint32 id, PlayerbotAI* ai)
+        {
+            if (id < resolvedIds.size() && resolvedIds[id])
+            {
+                return objectsById[id];
+            }
+
+            if (id >= resolvedIds.size())
+            {
+                objectsById.resize(id + 1, NULL);
+                resolvedIds.resize(id + 1, false);
+            }
+
+            objectsById[id] = FindObject(NamedObjectIds<T>::GetName(id), ai);
+            resolvedIds[id] = true;
+            return objectsById[id];
+        }
+
+        // lookup by name through the contexts, without the id cache
+        T* FindObject(string name, PlayerbotAI* ai)
         {
             for (typename list<NamedObjectContext<T>*>::iterator i = contexts.begin(); i != contexts.end(); i++)
             {
@@ -247,6 +278,8 @@ namespace ai
 
     private:
         list<NamedObjectContext<T>*> contexts;
+        vector<T*> objectsById;
+        vector<bool> resolvedIds;
     };
 
     template <class T> class NamedObjectFactoryList
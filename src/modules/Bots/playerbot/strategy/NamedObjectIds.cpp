@@ -0,0 +1,56 @@
+#include "../../botpch.h"
+#include "../playerbot.h"
+#include "NamedObjectIds.h"
+
+#include <ace/RW_Thread_Mutex.h>
+#include <unordered_map>
+
+using namespace ai;
+
+struct NamedObjectRegistry::Data
+{
+    ACE_RW_Thread_Mutex lock;
+    unordered_map<string, uint32> idsByName;
+    vector<string> namesById;
+};
+
+NamedObjectRegistry::NamedObjectRegistry() : data(new Data())
+{
+}
+
+NamedObjectRegistry::~NamedObjectRegistry()
+{
+    delete data;
+}
+
+uint32 NamedObjectRegistry::Intern(const string& name)
+{
+    {
+        ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, data->lock, 0);
+        unordered_map<string, uint32>::const_iterator found = data->idsByName.find(name);
+        if (found != data->idsByName.end())
+        {
+            return found->second;
+        }
+    }
+
+    ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, data->lock, 0);
+
+    // another thread may have added it meanwhile
+    unordered_map<string, uint32>::const_iterator found = data->idsByName.find(name);
+    if (found != data->idsByName.end())
+    {
+        return found->second;
+    }
+
+    uint32 id = data->namesById.size();
+    data->namesById.push_back(name);
+    data->idsByName[name] = id;
+    return id;
+}
+
+string NamedObjectRegistry::GetName(uint32 id)
+{
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, data->lock, string());
+    return id < data->namesById.size() ? data->namesById[id] : string();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <type_traits>
+#include <unordered_map>
+
+#define NAMED_OBJECT_NO_ID 0xFFFFFFFF
+
+namespace ai
+{
+    using namespace std;
+
+    // Name to dense id table of one kind of named object
+    class NamedObjectRegistry
+    {
+    public:
+        NamedObjectRegistry();
+        ~NamedObjectRegistry();
+
+    public:
+        uint32 Intern(const string& name);
+        string GetName(uint32 id);
+
+    private:
+        struct Data;
+        Data* data;
+    };
+
+    // Interns value, trigger and action names to dense ids, so that contexts can
+    // look objects up by array index instead of walking string maps every tick.
+    // Only plain names get ids: a qualified name ("name::qualifier") is NAMED_OBJECT_NO_ID
+    // and is looked up by name in the contexts of the bot, so the id space stays as
+    // small as the set of names used in the code.
+    template <class T> class NamedObjectIds
+    {
+    public:
+        static uint32 Intern(const string& name)
+        {
+            if (name.find("::") != string::npos)
+            {
+                return NAMED_OBJECT_NO_ID;
+            }
+
+            // every thread keeps the ids it has seen, the shared table is only locked on a thread's first use of a name
+            static thread_local unordered_map<string, uint32> known;
+            unordered_map<string, uint32>::const_iterator found = known.find(name);
+            if (found != known.end())
+            {
+                return found->second;
+            }
+
+            uint32 id = GetRegistry().Intern(name);
+            known[name] = id;
+            return id;
+        }
+        static string GetName(uint32 id) { return GetRegistry().GetName(id); }
+
+    private:
+        static NamedObjectRegistry& GetRegistry()
+        {
+            static NamedObjectRegistry registry;
+            return registry;
+        }
+    };
+
+    template <class T> struct IsNameLiteral : is_array<typename remove_reference<T>::type> {};
+
+    // both branches of AI_NAMED_VALUE are compiled for either kind of name
+    inline char const* NameChars(char const* name) { return name; }
+    inline char const* NameChars(const string& name) { return name.c_str(); }
+}
+
+// value of the given name, string literal names are interned once per call site
+#define AI_NAMED_VALUE(type, name) \
+    ([&]() -> ai::Value<type>* \
+    { \
+        if constexpr (ai::IsNameLiteral<decltype(name)>::value) \
+        { \
+            static const uint32 id = ai::NamedObjectIds<ai::UntypedValue>::Intern(name); \
+            return context->GetValue<type>(id, ai::NameChars(name)); \
+        } \
+        else \
+        { \
+            return context->GetValue<type>(name); \
+        } \
+    }())
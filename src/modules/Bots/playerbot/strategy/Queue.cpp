@@ -10,10 +10,15 @@ void Queue::Push(ActionBasket *action)
 {
     if (action)
     {
+        // qualified names ("name::qualifier") have no id, those are told apart by name
+        uint32 id = action->getAction()->getId();
         for (std::list<ActionBasket*>::iterator iter = actions.begin(); iter != actions.end(); iter++)
         {
             ActionBasket* basket = *iter;
-            if (action->getAction()->getName() == basket->getAction()->getName())
+            uint32 basketId = basket->getAction()->getId();
+            bool same = id != NAMED_OBJECT_NO_ID && basketId != NAMED_OBJECT_NO_ID ? id == basketId :
+                        action->getAction()->getName() == basket->getAction()->getName();
+            if (same)
             {
                 if (basket->getRelevance() < action->getRelevance())
                 {
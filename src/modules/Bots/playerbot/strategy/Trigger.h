@@ -61,6 +61,7 @@ namespace ai
         TriggerNode(string name, NextAction** handlers = NULL)
         {
             this->name = name;
+            this->id = NamedObjectIds<Trigger>::Intern(name);
             this->handlers = handlers;
             this->trigger = NULL;
         }
@@ -73,6 +74,7 @@ namespace ai
         Trigger* getTrigger() { return trigger; }
         void setTrigger(Trigger* trigger) { this->trigger = trigger; }
         string getName() { return name; }
+        uint32 getId() { return id; }
 
     public:
         NextAction** getHandlers() { return NextAction::merge(NextAction::clone(handlers), trigger->getHandlers()); }
@@ -81,5 +83,6 @@ namespace ai
         Trigger* trigger;
         NextAction** handlers;
         std::string name;
+        uint32 id;
     };
 }
@@ -126,7 +126,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nHolderConns /*= 0*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -178,6 +178,19 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         return false;
     }
 
+    // create connections for the queries of async query holders
+    for (int i = 0; i < std::min(nHolderConns, MAX_CONNECTION_POOL_SIZE); ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pHolderConnections.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -200,6 +213,13 @@ void Database::StopServer()
     }
 
     m_pQueryConnections.clear();
+
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+    {
+        delete m_pHolderConnections[i];
+    }
+
+    m_pHolderConnections.clear();
 }
 
 SqlDelayThread* Database::CreateDelayThread()
@@ -216,6 +236,13 @@ void Database::InitDelayThread()
     m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
     m_TransStorage = new ACE_TSS<Database::TransHelper>();
     m_delayThread = new ACE_Based::Thread(m_threadBody);
+
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+    {
+        SqlHolderThread* body = new SqlHolderThread(&m_holderTasks, m_pHolderConnections[i]);
+        m_holderBodies.push_back(body);
+        m_holderThreads.push_back(new ACE_Based::Thread(body));
+    }
 }
 
 void Database::HaltDelayThread()
@@ -232,6 +259,17 @@ void Database::HaltDelayThread()
     m_delayThread = NULL;
     m_threadBody = NULL;
     m_TransStorage=NULL;
+
+    // the delay thread queued its last holder queries, let the holder threads finish them
+    for (size_t i = 0; i < m_holderThreads.size(); ++i)
+    {
+        m_holderBodies[i]->Stop();
+        m_holderThreads[i]->wait();
+        delete m_holderThreads[i];                          // This also deletes m_holderBodies[i]
+    }
+
+    m_holderThreads.clear();
+    m_holderBodies.clear();
 }
 
 void Database::ThreadStart()
@@ -294,6 +332,12 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+    {
+        SqlConnection::Lock guard(m_pHolderConnections[i]);
+        delete guard->Query(sql);
+    }
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -363,6 +407,28 @@ QueryResult* Database::PQuery(const char* format, ...)
     return Query(szQuery);
 }
 
+QueryResult* Database::PQueryBinary(const char* format, ...)
+{
+    if (!format)
+    {
+        return NULL;
+    }
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return NULL;
+    }
+
+    return QueryBinary(szQuery);
+}
+
 QueryNamedResult* Database::PQueryNamed(const char* format, ...)
 {
     if (!format)
@@ -85,6 +85,15 @@ class SqlConnection
          * @return QueryNamedResult
          */
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        /**
+         * @brief query over the binary protocol, values are decoded once into typed fields
+         *
+         * Falls back to the text protocol for backends without one.
+         *
+         * @param sql
+         * @return QueryResult
+         */
+        virtual QueryResult* QueryBinary(const char* sql) { return Query(sql); }
 
         /**
          * @brief public methods for making requests
@@ -234,9 +243,10 @@ class Database
          *
          * @param infoString
          * @param nConns
+         * @param nHolderConns connections for the queries of async query holders, 0 to run them on the async connection
          * @return bool
          */
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nHolderConns = 0);
         /**
          * @brief start worker thread for async DB request execution
          *
@@ -272,6 +282,21 @@ class Database
             return guard->QueryNamed(sql);
         }
 
+        /**
+         * @brief Synchronous query whose rows are read over the binary protocol.
+         *
+         * Same results as Query(), but numeric columns arrive as typed values instead of text,
+         * which saves a string parse per value in large loads.
+         *
+         * @param sql
+         * @return QueryResult
+         */
+        inline QueryResult* QueryBinary(const char* sql)
+        {
+            SqlConnection::Lock guard(getQueryConnection());
+            return guard->QueryBinary(sql);
+        }
+
         /**
          * @brief
          *
@@ -279,6 +304,13 @@ class Database
          * @return QueryResult
          */
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
+        /**
+         * @brief
+         *
+         * @param format...
+         * @return QueryResult
+         */
+        QueryResult* PQueryBinary(const char* format, ...) ATTR_PRINTF(2, 3);
         /**
          * @brief
          *
@@ -652,6 +684,19 @@ class Database
          */
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
 
+        /**
+         * @brief queue of the holder threads
+         *
+         * @return SqlHolderTaskQueue NULL when holders run on the async connection
+         */
+        SqlHolderTaskQueue* GetHolderTaskQueue() { return m_holderThreads.empty() ? NULL : &m_holderTasks; }
+        /**
+         * @brief time async query holders took from queueing until all results were in
+         *
+         * @return SqlLatencyHistogram
+         */
+        SqlLatencyHistogram& GetHolderLatency() { return m_holderLatency; }
+
     protected:
         /**
          * @brief
@@ -792,6 +837,13 @@ class Database
         SqlDelayThread*     m_threadBody;                   /**< Pointer to delay sql executer (owned by m_delayThread) */
         ACE_Based::Thread*  m_delayThread;                  /**< Pointer to executer thread */
 
+        // connections and threads running the queries of async query holders
+        SqlConnectionContainer m_pHolderConnections; /**< TODO */
+        std::vector<SqlHolderThread*> m_holderBodies;       /**< owned by m_holderThreads */
+        std::vector<ACE_Based::Thread*> m_holderThreads; /**< TODO */
+        SqlHolderTaskQueue m_holderTasks; /**< TODO */
+        SqlLatencyHistogram m_holderLatency; /**< TODO */
+
         bool m_bAllowAsyncTransactions;                     /**< flag which specifies if async transactions are enabled */
 
         // PREPARED STATEMENT REGISTRY
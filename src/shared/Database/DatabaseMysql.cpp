@@ -281,6 +281,62 @@ QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
     return new QueryNamedResult(queryResult, names);
 }
 
+QueryResult* MySQLConnection::QueryBinary(const char* sql)
+{
+    if (!mMysql)
+    {
+        return NULL;
+    }
+
+    uint32 _s = getMSTime();
+
+    MYSQL_STMT* stmt = mysql_stmt_init(mMysql);
+    if (!stmt)
+    {
+        sLog.outError("SQL: mysql_stmt_init() failed ");
+        return NULL;
+    }
+
+    // let the client library compute the longest value of each column, to size the text buffers
+    MySqlBool updateMaxLength = 1;
+
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)) ||
+        mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength) ||
+        mysql_stmt_execute(stmt) ||
+        mysql_stmt_store_result(stmt))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return NULL;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", getMSTimeDiff(_s, getMSTime()), sql);
+
+    QueryResultMysqlStmt* queryResult = NULL;
+    uint64 rowCount = mysql_stmt_num_rows(stmt);
+    MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+    if (metadata)
+    {
+        if (rowCount)
+        {
+            // the rows are read here, while the connection is still locked
+            queryResult = new QueryResultMysqlStmt(stmt, metadata, rowCount, mysql_num_fields(metadata));
+        }
+        mysql_free_result(metadata);
+    }
+
+    mysql_stmt_close(stmt);
+
+    if (queryResult && !queryResult->NextRow())
+    {
+        delete queryResult;
+        return NULL;
+    }
+
+    return queryResult;
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!mMysql)
@@ -153,6 +153,13 @@ class MySQLConnection : public SqlConnection
          * @return QueryNamedResult
          */
         QueryNamedResult* QueryNamed(const char* sql) override;
+        /**
+         * @brief
+         *
+         * @param sql
+         * @return QueryResult
+         */
+        QueryResult* QueryBinary(const char* sql) override;
         /**
          * @brief
          *
@@ -23,3 +23,24 @@
  */
 
 //#include "DatabaseEnv.h"
+#include "Field.h"
+#include <float.h>
+
+void Field::FormatBinaryValue() const
+{
+    switch (mBinary)
+    {
+        case BINARY_INT:
+            snprintf(mText, sizeof(mText), SI64FMTD, mNumber.i);
+            break;
+        case BINARY_UINT:
+            snprintf(mText, sizeof(mText), UI64FMTD, static_cast<uint64>(mNumber.i));
+            break;
+        case BINARY_DOUBLE:
+            // FLOAT columns only hold FLT_DIG significant digits, print them the way the text protocol does
+            snprintf(mText, sizeof(mText), "%.*g", mType == MYSQL_TYPE_FLOAT ? FLT_DIG : DBL_DIG, mNumber.d);
+            break;
+        default:
+            break;
+    }
+}
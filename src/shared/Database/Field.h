@@ -49,18 +49,30 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
+        /**
+         * @brief how a value read over the binary protocol is held
+         *
+         */
+        enum BinaryTypes
+        {
+            BINARY_NONE     = 0x00,                         // text protocol, mValue is the column text
+            BINARY_INT      = 0x01,
+            BINARY_UINT     = 0x02,
+            BINARY_DOUBLE   = 0x03
+        };
+
         /**
          * @brief
          *
          */
-        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL) {}
+        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL), mBinary(BINARY_NONE) {}
         /**
          * @brief
          *
          * @param value
          * @param type
          */
-        Field(const char* value, enum_field_types type) : mValue(value), mType(type) {}
+        Field(const char* value, enum_field_types type) : mValue(value), mType(type), mBinary(BINARY_NONE) {}
 
         /**
          * @brief
@@ -86,7 +98,14 @@ class Field
          *
          * @return const char
          */
-        const char* GetString() const { return mValue; }
+        const char* GetString() const
+        {
+            if (mBinary != BINARY_NONE)
+            {
+                FormatBinaryValue();
+            }
+            return mValue;
+        }
         /**
          * @brief
          *
@@ -94,62 +113,63 @@ class Field
          */
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
         }
         /**
          * @brief
          *
          * @return float
          */
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
+        float GetFloat() const { return mBinary ? static_cast<float>(GetBinaryDouble()) : (mValue ? static_cast<float>(atof(mValue)) : 0.0f); }
         /**
          * @brief
          *
          * @return bool
          */
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
+        bool GetBool() const { return mBinary ? GetBinaryInt() > 0 : (mValue ? atoi(mValue) > 0 : false); }
         /**
         * @brief
         *
         * @return double
         */
-        double GetDouble() const { return mValue ? static_cast<double>(atof(mValue)) : 0.0f; }
+        double GetDouble() const { return mBinary ? GetBinaryDouble() : (mValue ? static_cast<double>(atof(mValue)) : 0.0f); }
         /**
         * @brief
         *
         * @return int8
         */
-        int8 GetInt8() const { return mValue ? static_cast<int8>(atol(mValue)) : int8(0); }
+        int8 GetInt8() const { return mBinary ? static_cast<int8>(GetBinaryInt()) : (mValue ? static_cast<int8>(atol(mValue)) : int8(0)); }
         /**
          * @brief
          *
          * @return int32
          */
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        int32 GetInt32() const { return mBinary ? static_cast<int32>(GetBinaryInt()) : (mValue ? static_cast<int32>(atol(mValue)) : int32(0)); }
         /**
          * @brief
          *
          * @return uint8
          */
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint8 GetUInt8() const { return mBinary ? static_cast<uint8>(GetBinaryInt()) : (mValue ? static_cast<uint8>(atol(mValue)) : uint8(0)); }
         /**
          * @brief
          *
          * @return uint16
          */
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        uint16 GetUInt16() const { return mBinary ? static_cast<uint16>(GetBinaryInt()) : (mValue ? static_cast<uint16>(atol(mValue)) : uint16(0)); }
         /**
          * @brief
          *
          * @return int16
          */
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        int16 GetInt16() const { return mBinary ? static_cast<int16>(GetBinaryInt()) : (mValue ? static_cast<int16>(atol(mValue)) : int16(0)); }
         /**
          * @brief
          *
          * @return uint32
          */
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        uint32 GetUInt32() const { return mBinary ? static_cast<uint32>(GetBinaryInt()) : (mValue ? static_cast<uint32>(atol(mValue)) : uint32(0)); }
         /**
          * @brief
          *
@@ -157,6 +177,11 @@ class Field
          */
         uint64 GetUInt64() const
         {
+            if (mBinary)
+            {
+                return static_cast<uint64>(GetBinaryInt());
+            }
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
             {
@@ -172,6 +197,11 @@ class Field
         */
         uint64 GetInt64() const
         {
+            if (mBinary)
+            {
+                return GetBinaryInt();
+            }
+
             int64 value = 0;
             if (!mValue || sscanf(mValue, SI64FMTD, &value) == -1)
             {
@@ -195,7 +225,32 @@ class Field
          *
          * @param value
          */
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mBinary = BINARY_NONE; }
+
+        /**
+         * @brief store an integer decoded from a binary protocol row
+         *
+         * @param value
+         * @param isUnsigned
+         */
+        void SetBinaryValue(int64 value, bool isUnsigned)
+        {
+            mNumber.i = value;
+            mBinary = isUnsigned ? BINARY_UINT : BINARY_INT;
+            mValue = mText;                                 // not NULL, text is formatted on demand
+        }
+
+        /**
+         * @brief store a floating point value decoded from a binary protocol row
+         *
+         * @param value
+         */
+        void SetBinaryValue(double value)
+        {
+            mNumber.d = value;
+            mBinary = BINARY_DOUBLE;
+            mValue = mText;
+        }
 
     private:
         /**
@@ -212,7 +267,39 @@ class Field
          */
         Field& operator=(Field const&);
 
+        /**
+         * @brief
+         *
+         * @return int64
+         */
+        int64 GetBinaryInt() const { return mBinary == BINARY_DOUBLE ? static_cast<int64>(mNumber.d) : mNumber.i; }
+        /**
+         * @brief
+         *
+         * @return double
+         */
+        double GetBinaryDouble() const
+        {
+            if (mBinary == BINARY_DOUBLE)
+            {
+                return mNumber.d;
+            }
+            return mBinary == BINARY_UINT ? static_cast<double>(static_cast<uint64>(mNumber.i)) : static_cast<double>(mNumber.i);
+        }
+        /**
+         * @brief writes the text of a binary value to mText, for the few callers reading numbers as strings
+         *
+         */
+        void FormatBinaryValue() const;
+
         const char* mValue; /**< TODO */
         enum_field_types mType; /**< TODO */
+        BinaryTypes mBinary; /**< BINARY_NONE unless the value came from a binary protocol row */
+        union
+        {
+            int64 i;
+            double d;
+        } mNumber; /**< binary value */
+        mutable char mText[32]; /**< text of the binary value */
 };
 #endif
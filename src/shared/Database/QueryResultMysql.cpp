@@ -80,6 +80,179 @@ void QueryResultMysql::EndQuery()
     }
 }
 
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mColumnTypes(fieldCount, Field::BINARY_NONE), mNextRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    // integers and floats are converted by the client library, everything else is read as text
+    MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<Cell> row(mFieldCount);
+    std::vector<std::vector<char> > texts(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::vector<MySqlBool> nulls(mFieldCount);
+    std::vector<MySqlBool> truncated(mFieldCount);
+    memset(&binds[0], 0, sizeof(MYSQL_BIND) * mFieldCount);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(fields[i].type);
+
+        MYSQL_BIND& bind = binds[i];
+        bind.length = &lengths[i];
+        bind.is_null = &nulls[i];
+        bind.error = &truncated[i];
+
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+                mColumnTypes[i] = (fields[i].flags & UNSIGNED_FLAG) ? Field::BINARY_UINT : Field::BINARY_INT;
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                bind.buffer = &row[i].value.i;
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+            case MYSQL_TYPE_DECIMAL:
+            case MYSQL_TYPE_NEWDECIMAL:
+                mColumnTypes[i] = Field::BINARY_DOUBLE;
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &row[i].value.d;
+                break;
+            default:
+                // max_length is filled in because the statement was stored with STMT_ATTR_UPDATE_MAX_LENGTH
+                texts[i].resize(fields[i].max_length + 1);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &texts[i][0];
+                bind.buffer_length = texts[i].size();
+                break;
+        }
+    }
+
+    if (mysql_stmt_bind_result(stmt, &binds[0]))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mRowCount = 0;
+        return;
+    }
+
+    mCells.reserve(mRowCount * mFieldCount);
+    uint64 readRows = 0;
+    int status;
+    while ((status = mysql_stmt_fetch(stmt)) == 0 || status == MYSQL_DATA_TRUNCATED)
+    {
+        bool rebind = false;
+        bool failed = false;
+        for (uint32 i = 0; i < mFieldCount && !failed; ++i)
+        {
+            // text longer than max_length promised: grow the buffer and read the column again,
+            // truncated numbers are the intended conversion of decimals to double
+            if (status == MYSQL_DATA_TRUNCATED && truncated[i] && mColumnTypes[i] == Field::BINARY_NONE)
+            {
+                texts[i].resize(lengths[i] + 1);
+                binds[i].buffer = &texts[i][0];
+                binds[i].buffer_length = texts[i].size();
+                failed = mysql_stmt_fetch_column(stmt, &binds[i], i, 0) != 0;
+                rebind = true;
+            }
+
+            row[i].isNull = nulls[i] != 0;
+            if (!row[i].isNull && mColumnTypes[i] == Field::BINARY_NONE)
+            {
+                unsigned long length = std::min<unsigned long>(lengths[i], texts[i].size() - 1);
+                row[i].value.offset = mText.size();
+                mText.insert(mText.end(), texts[i].begin(), texts[i].begin() + length);
+                mText.push_back('\0');
+            }
+            mCells.push_back(row[i]);
+        }
+
+        // later rows are fetched into the grown buffers
+        if (failed || (rebind && mysql_stmt_bind_result(stmt, &binds[0])))
+        {
+            status = 1;
+            break;
+        }
+        ++readRows;
+    }
+
+    // a partial result would look like a successful query to the loaders, fail the whole query instead
+    if (status != MYSQL_NO_DATA)
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_fetch() failed after " UI64FMTD " rows", readRows);
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mCells.clear();
+        mText.clear();
+        readRows = 0;
+    }
+
+    mRowCount = readRows;
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (!mCurrentRow)
+    {
+        return false;
+    }
+
+    if (mNextRow >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    Cell const* row = &mCells[mNextRow * mFieldCount];
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        if (row[i].isNull)
+        {
+            mCurrentRow[i].SetValue(NULL);
+            continue;
+        }
+
+        switch (mColumnTypes[i])
+        {
+            case Field::BINARY_INT:
+                mCurrentRow[i].SetBinaryValue(row[i].value.i, false);
+                break;
+            case Field::BINARY_UINT:
+                mCurrentRow[i].SetBinaryValue(row[i].value.i, true);
+                break;
+            case Field::BINARY_DOUBLE:
+                mCurrentRow[i].SetBinaryValue(row[i].value.d);
+                break;
+            default:
+                mCurrentRow[i].SetValue(&mText[row[i].value.offset]);
+                break;
+        }
+    }
+
+    ++mNextRow;
+    return true;
+}
+
+void QueryResultMysqlStmt::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = 0;
+
+    std::vector<Cell>().swap(mCells);
+    std::vector<char>().swap(mText);
+}
+
 Field::SimpleDataTypes QueryResultMysql::GetSimpleType(enum_field_types type)
 {
     switch (type)
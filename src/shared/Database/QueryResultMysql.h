@@ -34,6 +34,7 @@
 #endif
 
 #include <mysql.h>
+#include <type_traits>
 
 /**
  * @brief
@@ -82,6 +83,72 @@ class QueryResultMysql : public QueryResult
 
         MYSQL_RES* mResult; /**< TODO */
 };
+
+/**
+ * @brief flag type the client library uses in MYSQL_BIND (my_bool or bool, depending on its version)
+ *
+ */
+typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type MySqlBool;
+
+/**
+ * @brief result of a query run over the binary (prepared statement) protocol
+ *
+ * All rows are fetched and decoded into typed cells while the connection is held,
+ * so the Field getters of the loaders do not parse the column text again for every value.
+ */
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        /**
+         * @brief reads every row of an executed and stored statement
+         *
+         * @param stmt
+         * @param metadata
+         * @param rowCount
+         * @param fieldCount
+         */
+        QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount);
+
+        /**
+         * @brief
+         *
+         */
+        ~QueryResultMysqlStmt();
+
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        bool NextRow() override;
+
+    private:
+        /**
+         * @brief one decoded column value
+         *
+         */
+        struct Cell
+        {
+            union
+            {
+                int64 i;
+                double d;
+                size_t offset;                              // of the text in mText
+            } value;
+            bool isNull;
+        };
+
+        /**
+         * @brief
+         *
+         */
+        void EndQuery();
+
+        std::vector<Field::BinaryTypes> mColumnTypes; /**< BINARY_NONE for columns kept as text */
+        std::vector<Cell> mCells; /**< rows one after another */
+        std::vector<char> mText; /**< zero terminated texts of all text cells */
+        uint64 mNextRow; /**< TODO */
+};
 #endif
 
 #endif
@@ -29,6 +29,8 @@
 #include "Database/DatabaseEnv.h"
 #include "DataStores/DBCFileLoader.h"
 
+class SQLStorageSnapshot;
+
 /**
  * @brief
  *
@@ -720,6 +722,38 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        /**
+         * @brief
+         *
+         * @param store
+         * @return uint32
+         */
+        uint32 calculateRecordSize(StorageClass& store);
+        template<class R>
+        /**
+         * @brief
+         *
+         * @param store
+         * @param row
+         */
+        void storeRow(StorageClass& store, R const& row);
+        /**
+         * @brief
+         *
+         * @param store
+         * @param snapshot
+         * @param error_at_empty
+         * @return bool
+         */
+        bool loadFromSnapshot(StorageClass& store, SQLStorageSnapshot& snapshot, bool error_at_empty);
+        /**
+         * @brief reports an empty table, as an error unless empty tables are expected
+         *
+         * @param store
+         * @param error_at_empty
+         */
+        static void reportEmpty(StorageClass const& store, bool error_at_empty);
+
         template<class V>
         /**
          * @brief
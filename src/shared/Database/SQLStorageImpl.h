@@ -28,6 +28,7 @@
 #include "Utilities/ProgressBar.h"
 #include "Log/Log.h"
 #include "DataStores/DBCFileLoader.h"
+#include "Database/SQLStorageSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>
@@ -257,6 +258,191 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
     }
 }
 
+/**
+ * @brief Row accessor over a database result row, see SQLStorageSnapshot for the other source
+ *
+ */
+class SQLStorageFieldRow
+{
+    public:
+        explicit SQLStorageFieldRow(Field* fields) : m_fields(fields) {}
+
+        uint32 GetUInt32(uint32 idx) const { return m_fields[idx].GetUInt32(); }
+        uint8 GetUInt8(uint32 idx) const { return m_fields[idx].GetUInt8(); }
+        float GetFloat(uint32 idx) const { return m_fields[idx].GetFloat(); }
+        char const* GetString(uint32 idx) const { return m_fields[idx].GetString(); }
+
+    private:
+        Field* m_fields;
+};
+
+template<class DerivedLoader, class StorageClass>
+/**
+ * @brief
+ *
+ * @param store
+ * @return uint32
+ */
+uint32 SQLStorageLoaderBase<DerivedLoader, StorageClass>::calculateRecordSize(StorageClass& store)
+{
+    uint32 recordsize = 0;
+    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            case DBC_FF_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case DBC_FF_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_INT:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_STRING:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_NA:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_NA_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_NA_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_NA_POINTER:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_IND:
+            case DBC_FF_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+
+    return recordsize;
+}
+
+template<class DerivedLoader, class StorageClass>
+template<class R>
+/**
+ * @brief R row-type, either SQLStorageFieldRow or SQLStorageSnapshot
+ *
+ * @param store
+ * @param row
+ */
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeRow(StorageClass& store, R const& row)
+{
+    char* record = store.createRecord(row.GetUInt32(0));
+    uint32 offset = 0;
+
+    // dependend on dest-size
+    // iterate two indexes: x over dest, y over source
+    //                      y++ If and only If x != FT_NA*
+    //                      x++ If and only If a value is stored
+    for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            // For default fill continue and do not increase y
+            case DBC_FF_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
+            case DBC_FF_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
+            case DBC_FF_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
+            case DBC_FF_NA_POINTER: storeValue((char const*)NULL, store, record, x, offset); ++x; continue;
+            default:
+                break;
+        }
+
+        // It is required that the input has at least as many columns set as the output requires
+        if (y >= store.GetSrcFieldCount())
+        {
+            assert(false && "SQL storage has too few columns!");
+        }
+
+        switch (store.GetSrcFormat(y))
+        {
+            case DBC_FF_LOGIC:  storeValue((bool)(row.GetUInt32(y) > 0), store, record, x, offset);  ++x; break;
+            case DBC_FF_BYTE:   storeValue((char)row.GetUInt8(y), store, record, x, offset);         ++x; break;
+            case DBC_FF_INT:    storeValue((uint32)row.GetUInt32(y), store, record, x, offset);      ++x; break;
+            case DBC_FF_FLOAT:  storeValue((float)row.GetFloat(y), store, record, x, offset);        ++x; break;
+            case DBC_FF_STRING: storeValue((char const*)row.GetString(y), store, record, x, offset); ++x; break;
+            case DBC_FF_NA:
+            case DBC_FF_NA_BYTE:
+            case DBC_FF_NA_FLOAT:
+                // Do Not increase x
+                break;
+            case DBC_FF_IND:
+            case DBC_FF_SORT:
+            case DBC_FF_NA_POINTER:
+                assert(false && "SQL storage not have sort or pointer field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+        }
+        ++y;
+    }
+}
+
+template<class DerivedLoader, class StorageClass>
+/**
+ * @brief
+ *
+ * @param store
+ * @param error_at_empty
+ */
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::reportEmpty(StorageClass const& store, bool error_at_empty)
+{
+    if (error_at_empty)
+    {
+        sLog.outError("%s table is empty!\n", store.GetTableName());
+    }
+    else
+    {
+        sLog.outString("%s table is empty!\n", store.GetTableName());
+    }
+}
+
+template<class DerivedLoader, class StorageClass>
+/**
+ * @brief
+ *
+ * @param store
+ * @param snapshot
+ * @param error_at_empty
+ * @return bool
+ */
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::loadFromSnapshot(StorageClass& store, SQLStorageSnapshot& snapshot, bool error_at_empty)
+{
+    if (!snapshot.Open())
+    {
+        return false;
+    }
+
+    if (!snapshot.GetRecordCount())
+    {
+        reportEmpty(store, error_at_empty);
+        return true;
+    }
+
+    store.prepareToLoad(snapshot.GetMaxEntry(), snapshot.GetRecordCount(), calculateRecordSize(store));
+
+    BarGoLink bar(snapshot.GetRecordCount());
+    for (uint32 i = 0; i < snapshot.GetRecordCount(); ++i)
+    {
+        bar.step();
+
+        if (!snapshot.NextRow())
+        {
+            // Checksum matched, so only a changed row layout can get us here
+            sLog.outError("Snapshot of %s table is malformed, loading from the database instead", store.GetTableName());
+            return false;
+        }
+
+        storeRow(store, snapshot);
+    }
+
+    sLog.outString("Loaded %s table from snapshot", store.GetTableName());
+    return true;
+}
+
 template<class DerivedLoader, class StorageClass>
 /**
  * @brief
@@ -266,6 +452,12 @@ template<class DerivedLoader, class StorageClass>
  */
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    SQLStorageSnapshot snapshot(store.GetTableName(), store.GetSrcFormat());
+    if (SQLStorageSnapshot::IsEnabled() && loadFromSnapshot(store, snapshot, error_at_empty))
+    {
+        return;
+    }
+
     Field* fields = NULL;
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(`%s`) FROM `%s`", store.EntryFieldName(), store.GetTableName());
     if (!result)
@@ -277,7 +469,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
 
     uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
     uint32 recordCount = 0;
-    uint32 recordsize = 0;
+    bool counted = false;
     delete result;
 
     result = WorldDatabase.PQuery("SELECT COUNT(*) FROM `%s`", store.GetTableName());
@@ -285,23 +477,21 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     {
         fields = result->Fetch();
         recordCount = fields[0].GetUInt32();
+        counted = true;
         delete result;
     }
 
-    result = WorldDatabase.PQuery("SELECT * FROM `%s`", store.GetTableName());
+    result = WorldDatabase.PQueryBinary("SELECT * FROM `%s`", store.GetTableName());
 
     if (!result)
     {
-        if (error_at_empty)
-        {
-            sLog.outError("%s table is empty!\n", store.GetTableName());
-        }
-        else
+        reportEmpty(store, error_at_empty);
+
+        // an empty snapshot, so the next start reports the table from loadFromSnapshot() without querying it
+        if (SQLStorageSnapshot::IsEnabled() && counted && !recordCount)
         {
-            sLog.outString("%s table is empty!\n", store.GetTableName());
+            snapshot.Save(maxRecordId);
         }
-
-        recordCount = 0;
         return;
     }
 
@@ -314,42 +504,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case DBC_FF_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case DBC_FF_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_INT:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_STRING:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_NA:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_IND:
-            case DBC_FF_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
-
     // Prepare data storage and lookup storage
-    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+    store.prepareToLoad(maxRecordId, recordCount, calculateRecordSize(store));
 
     BarGoLink bar(recordCount);
     do
@@ -357,58 +513,21 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         fields = result->Fetch();
         bar.step();
 
-        char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
+        storeRow(store, SQLStorageFieldRow(fields));
 
-        // dependend on dest-size
-        // iterate two indexes: x over dest, y over source
-        //                      y++ If and only If x != FT_NA*
-        //                      x++ If and only If a value is stored
-        for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
+        if (SQLStorageSnapshot::IsEnabled())
         {
-            switch (store.GetDstFormat(x))
-            {
-                // For default fill continue and do not increase y
-                case DBC_FF_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
-                case DBC_FF_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
-                case DBC_FF_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
-                case DBC_FF_NA_POINTER: storeValue((char const*)NULL, store, record, x, offset); ++x; continue;
-                default:
-                    break;
-            }
-
-            // It is required that the input has at least as many columns set as the output requires
-            if (y >= store.GetSrcFieldCount())
-            {
-                assert(false && "SQL storage has too few columns!");
-            }
-
-            switch (store.GetSrcFormat(y))
-            {
-                case DBC_FF_LOGIC:  storeValue((bool)(fields[y].GetUInt32() > 0), store, record, x, offset);  ++x; break;
-                case DBC_FF_BYTE:   storeValue((char)fields[y].GetUInt8(), store, record, x, offset);         ++x; break;
-                case DBC_FF_INT:    storeValue((uint32)fields[y].GetUInt32(), store, record, x, offset);      ++x; break;
-                case DBC_FF_FLOAT:  storeValue((float)fields[y].GetFloat(), store, record, x, offset);        ++x; break;
-                case DBC_FF_STRING: storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
-                case DBC_FF_NA:
-                case DBC_FF_NA_BYTE:
-                case DBC_FF_NA_FLOAT:
-                    // Do Not increase x
-                    break;
-                case DBC_FF_IND:
-                case DBC_FF_SORT:
-                case DBC_FF_NA_POINTER:
-                    assert(false && "SQL storage not have sort or pointer field types");
-                    break;
-                default:
-                    assert(false && "unknown format character");
-            }
-            ++y;
+            snapshot.AppendRow(fields);
         }
     }
     while (result->NextRow());
 
     delete result;
+
+    if (SQLStorageSnapshot::IsEnabled())
+    {
+        snapshot.Save(maxRecordId);
+    }
 }
 
 #endif
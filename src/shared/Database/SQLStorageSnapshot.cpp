@@ -0,0 +1,357 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "Database/DatabaseEnv.h"
+#include "DataStores/DBCFileLoader.h"
+#include "Log/Log.h"
+
+#include <cstdio>
+
+// Increase when the file layout below changes
+#define SQL_STORAGE_SNAPSHOT_VERSION 1
+
+static char const SNAPSHOT_MAGIC[4] = { 'S', 'Q', 'L', 'S' };
+static uint32 const SNAPSHOT_NULL_STRING = 0xFFFFFFFF;
+
+/**
+ * @brief File header, followed by the source format string and the row payload.
+ *
+ */
+struct SQLStorageSnapshotHeader
+{
+    char magic[4];
+    uint32 version;
+    uint64 sourceChecksum;
+    uint32 formatLength;
+    uint32 maxEntry;
+    uint32 recordCount;
+    uint32 payloadSize;
+    uint32 payloadHash;
+};
+
+static uint32 HashPayload(char const* data, size_t size)
+{
+    // FNV-1a
+    uint32 hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= uint8(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template<class T>
+static void AppendValue(std::vector<char>& buffer, T value)
+{
+    char const* raw = reinterpret_cast<char const*>(&value);
+    buffer.insert(buffer.end(), raw, raw + sizeof(T));
+}
+
+template<class T>
+static T ReadValue(char const* pos)
+{
+    T value;
+    memcpy(&value, pos, sizeof(T));                         // payload is not aligned
+    return value;
+}
+
+std::string SQLStorageSnapshot::m_directory;
+
+SQLStorageSnapshot::SQLStorageSnapshot(char const* tableName, char const* srcFormat) :
+    m_tableName(tableName),
+    m_srcFormat(srcFormat),
+    m_srcFieldCount(strlen(srcFormat)),
+    m_hasChecksum(false),
+    m_sourceChecksum(0),
+    m_cursor(NULL),
+    m_end(NULL),
+    m_maxEntry(0),
+    m_recordCount(0),
+    m_row(m_srcFieldCount, (char const*)NULL),
+    m_appendedRows(0)
+{
+}
+
+SQLStorageSnapshot::~SQLStorageSnapshot()
+{
+    m_file.close();
+}
+
+void SQLStorageSnapshot::SetDirectory(std::string const& dir)
+{
+    m_directory = dir;
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/' && m_directory[m_directory.size() - 1] != '\\')
+    {
+        m_directory.push_back('/');
+    }
+}
+
+std::string SQLStorageSnapshot::GetFileName() const
+{
+    return m_directory + m_tableName + ".snapshot";
+}
+
+bool SQLStorageSnapshot::ReadSourceChecksum()
+{
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE `%s`", m_tableName.c_str());
+    if (!result)
+    {
+        return false;
+    }
+
+    Field* fields = result->Fetch();
+    m_hasChecksum = !fields[1].IsNULL();
+    m_sourceChecksum = fields[1].GetUInt64();
+    delete result;
+
+    return m_hasChecksum;
+}
+
+bool SQLStorageSnapshot::Open()
+{
+    if (!IsEnabled() || !ReadSourceChecksum())
+    {
+        return false;
+    }
+
+    std::string fileName = GetFileName();
+    if (m_file.map(fileName.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+    {
+        return false;
+    }
+
+    char const* data = static_cast<char const*>(m_file.addr());
+    size_t size = m_file.size();
+    if (size < sizeof(SQLStorageSnapshotHeader))
+    {
+        m_file.close();
+        return false;
+    }
+
+    SQLStorageSnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    size_t payloadOffset = sizeof(header) + header.formatLength;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SQL_STORAGE_SNAPSHOT_VERSION ||
+        header.sourceChecksum != m_sourceChecksum || header.formatLength != m_srcFormat.size() ||
+        size != payloadOffset + header.payloadSize || m_srcFormat.compare(0, std::string::npos, data + sizeof(header), header.formatLength) != 0)
+    {
+        DEBUG_LOG("Snapshot %s is outdated or belongs to another build, table %s will be loaded from the database", fileName.c_str(), m_tableName.c_str());
+        m_file.close();
+        return false;
+    }
+
+    if (HashPayload(data + payloadOffset, header.payloadSize) != header.payloadHash)
+    {
+        sLog.outError("Snapshot %s is corrupted, table %s will be loaded from the database", fileName.c_str(), m_tableName.c_str());
+        m_file.close();
+        return false;
+    }
+
+    m_maxEntry = header.maxEntry;
+    m_recordCount = header.recordCount;
+    m_cursor = data + payloadOffset;
+    m_end = m_cursor + header.payloadSize;
+    return true;
+}
+
+bool SQLStorageSnapshot::NextRow()
+{
+    if (!m_cursor || m_cursor >= m_end)
+    {
+        return false;
+    }
+
+    char const* pos = m_cursor;
+    for (uint32 y = 0; y < m_srcFieldCount; ++y)
+    {
+        size_t length = 0;
+        switch (m_srcFormat[y])
+        {
+            case DBC_FF_LOGIC:
+            case DBC_FF_INT:
+                length = sizeof(uint32);
+                break;
+            case DBC_FF_BYTE:
+                length = sizeof(uint8);
+                break;
+            case DBC_FF_FLOAT:
+                length = sizeof(float);
+                break;
+            case DBC_FF_STRING:
+            {
+                if (pos + sizeof(uint32) > m_end)
+                {
+                    return Invalidate();
+                }
+                uint32 strLength = ReadValue<uint32>(pos);
+                length = sizeof(uint32) + (strLength == SNAPSHOT_NULL_STRING ? 0 : strLength + 1);
+                break;
+            }
+            default:
+                // Skipped source columns are not stored
+                m_row[y] = NULL;
+                continue;
+        }
+
+        if (pos + length > m_end)
+        {
+            return Invalidate();
+        }
+
+        m_row[y] = pos;
+        pos += length;
+    }
+
+    m_cursor = pos;
+    return true;
+}
+
+bool SQLStorageSnapshot::Invalidate()
+{
+    m_file.close();
+    m_cursor = NULL;
+    m_end = NULL;
+    return false;
+}
+
+uint32 SQLStorageSnapshot::GetUInt32(uint32 idx) const
+{
+    return m_row[idx] ? ReadValue<uint32>(m_row[idx]) : 0;
+}
+
+uint8 SQLStorageSnapshot::GetUInt8(uint32 idx) const
+{
+    return m_row[idx] ? ReadValue<uint8>(m_row[idx]) : uint8(0);
+}
+
+float SQLStorageSnapshot::GetFloat(uint32 idx) const
+{
+    return m_row[idx] ? ReadValue<float>(m_row[idx]) : 0.0f;
+}
+
+char const* SQLStorageSnapshot::GetString(uint32 idx) const
+{
+    if (!m_row[idx] || ReadValue<uint32>(m_row[idx]) == SNAPSHOT_NULL_STRING)
+    {
+        return NULL;
+    }
+
+    return m_row[idx] + sizeof(uint32);                     // stored with terminating zero
+}
+
+void SQLStorageSnapshot::AppendRow(Field* fields)
+{
+    if (!m_hasChecksum)
+    {
+        return;
+    }
+
+    for (uint32 y = 0; y < m_srcFieldCount; ++y)
+    {
+        switch (m_srcFormat[y])
+        {
+            case DBC_FF_LOGIC:
+            case DBC_FF_INT:
+                AppendValue<uint32>(m_payload, fields[y].GetUInt32());
+                break;
+            case DBC_FF_BYTE:
+                AppendValue<uint8>(m_payload, fields[y].GetUInt8());
+                break;
+            case DBC_FF_FLOAT:
+                AppendValue<float>(m_payload, fields[y].GetFloat());
+                break;
+            case DBC_FF_STRING:
+            {
+                char const* str = fields[y].GetString();
+                if (!str)
+                {
+                    AppendValue<uint32>(m_payload, SNAPSHOT_NULL_STRING);
+                    break;
+                }
+
+                uint32 length = strlen(str);
+                AppendValue<uint32>(m_payload, length);
+                m_payload.insert(m_payload.end(), str, str + length + 1);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    ++m_appendedRows;
+}
+
+void SQLStorageSnapshot::Save(uint32 maxEntry)
+{
+    // Only write when the source checksum was known before the rows were read
+    if (!IsEnabled() || !m_hasChecksum)
+    {
+        return;
+    }
+
+    SQLStorageSnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SQL_STORAGE_SNAPSHOT_VERSION;
+    header.sourceChecksum = m_sourceChecksum;
+    header.formatLength = m_srcFormat.size();
+    header.maxEntry = maxEntry;
+    header.recordCount = m_appendedRows;
+    header.payloadSize = m_payload.size();
+    header.payloadHash = m_payload.empty() ? HashPayload(NULL, 0) : HashPayload(&m_payload[0], m_payload.size());
+
+    // Write to a temporary file first, so a crash never leaves a half written snapshot behind
+    std::string fileName = GetFileName();
+    std::string tmpName = fileName + ".tmp";
+    FILE* f = fopen(tmpName.c_str(), "wb");
+    if (!f)
+    {
+        sLog.outError("Can't create snapshot file %s", tmpName.c_str());
+        return;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(m_srcFormat.c_str(), 1, m_srcFormat.size(), f) == m_srcFormat.size() &&
+              (m_payload.empty() || fwrite(&m_payload[0], 1, m_payload.size(), f) == m_payload.size());
+    ok = fclose(f) == 0 && ok;
+
+    if (ok && rename(tmpName.c_str(), fileName.c_str()) != 0)
+    {
+        // rename does not replace existing files everywhere
+        remove(fileName.c_str());
+        ok = rename(tmpName.c_str(), fileName.c_str()) == 0;
+    }
+
+    if (!ok)
+    {
+        sLog.outError("Can't write snapshot file %s", fileName.c_str());
+        remove(tmpName.c_str());
+        return;
+    }
+
+    DEBUG_LOG("Wrote snapshot %s (%u rows)", fileName.c_str(), m_appendedRows);
+}
@@ -0,0 +1,145 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef SQLSTORAGE_SNAPSHOT_H
+#define SQLSTORAGE_SNAPSHOT_H
+
+#include "Common/Common.h"
+#include "Database/Field.h"
+
+#include <ace/Mem_Map.h>
+
+/**
+ * @brief Binary cache of the source rows of one SQLStorage table.
+ *
+ * After a table was read from the world database its rows are written to
+ * <dir>/<table>.snapshot together with the CHECKSUM TABLE value of the
+ * source. On the next start the file is memory-mapped and its rows are fed
+ * through the regular loader conversions instead of the MySQL text
+ * protocol, as long as the table checksum still matches.
+ *
+ * Rows are stored in source format, so loader specific conversions (like
+ * script name lookups) are always redone and stay valid.
+ */
+class SQLStorageSnapshot
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param tableName
+         * @param srcFormat
+         */
+        SQLStorageSnapshot(char const* tableName, char const* srcFormat);
+        /**
+         * @brief
+         *
+         */
+        ~SQLStorageSnapshot();
+
+        /**
+         * @brief Set the directory for snapshot files, empty disables snapshots.
+         *
+         * @param dir
+         */
+        static void SetDirectory(std::string const& dir);
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        static bool IsEnabled() { return !m_directory.empty(); }
+
+        /**
+         * @brief Map the snapshot file if it is valid and matches the current table.
+         *
+         * @return bool true when rows can be read from the snapshot
+         */
+        bool Open();
+        /**
+         * @brief
+         *
+         * @return uint32
+         */
+        uint32 GetMaxEntry() const { return m_maxEntry; }
+        /**
+         * @brief
+         *
+         * @return uint32
+         */
+        uint32 GetRecordCount() const { return m_recordCount; }
+        /**
+         * @brief Advance to the next row of an opened snapshot.
+         *
+         * @return bool false if no rows are left or the data is malformed
+         */
+        bool NextRow();
+
+        // Row access with the same semantics as the Field getters used by the loader
+        uint32 GetUInt32(uint32 idx) const;
+        uint8 GetUInt8(uint32 idx) const;
+        float GetFloat(uint32 idx) const;
+        char const* GetString(uint32 idx) const;
+
+        /**
+         * @brief Append one database row to the snapshot being written.
+         *
+         * @param fields
+         */
+        void AppendRow(Field* fields);
+        /**
+         * @brief Write the appended rows to disk.
+         *
+         * @param maxEntry
+         */
+        void Save(uint32 maxEntry);
+
+    private:
+        bool ReadSourceChecksum();
+        bool Invalidate();
+        std::string GetFileName() const;
+
+        static std::string m_directory; /**< snapshot directory with trailing slash */
+
+        std::string m_tableName; /**< TODO */
+        std::string m_srcFormat; /**< TODO */
+        uint32 m_srcFieldCount; /**< TODO */
+
+        bool m_hasChecksum; /**< CHECKSUM TABLE returned a usable value */
+        uint64 m_sourceChecksum; /**< TODO */
+
+        // Reading
+        ACE_Mem_Map m_file; /**< TODO */
+        char const* m_cursor; /**< next unread row */
+        char const* m_end; /**< end of the row payload */
+        uint32 m_maxEntry; /**< TODO */
+        uint32 m_recordCount; /**< TODO */
+        std::vector<char const*> m_row; /**< field positions of the current row */
+
+        // Writing
+        std::vector<char> m_payload; /**< TODO */
+        uint32 m_appendedRows; /**< TODO */
+};
+
+#endif
@@ -79,6 +79,117 @@ void SqlDelayThread::ProcessRequests()
     while (m_sqlQueue.next(s))
     {
         s->Execute(m_dbConnection);
-        delete s;
+        s->OnRemove();
     }
 }
+
+SqlHolderThread::SqlHolderThread(SqlHolderTaskQueue* queue, SqlConnection* conn) : m_taskQueue(queue), m_dbConnection(conn), m_running(true)
+{
+}
+
+SqlHolderThread::~SqlHolderThread()
+{
+    // the delay thread is stopped first, nothing gets queued anymore
+    ProcessTasks();
+}
+
+void SqlHolderThread::run()
+{
+#ifndef DO_POSTGRESQL
+    mysql_thread_init();
+#endif
+
+    // a login waits for its slowest query, so poll more often than the delay thread
+    const uint32 loopSleepms = 1;
+
+    while (m_running)
+    {
+        if (!ProcessTasks())
+        {
+            ACE_Based::Thread::Sleep(loopSleepms);
+        }
+    }
+
+#ifndef DO_POSTGRESQL
+    mysql_thread_end();
+#endif
+}
+
+void SqlHolderThread::Stop()
+{
+    m_running = false;
+}
+
+bool SqlHolderThread::ProcessTasks()
+{
+    bool processed = false;
+    SqlHolderTask task;
+    while (m_taskQueue->next(task))
+    {
+        task.first->ExecuteQuery(m_dbConnection, task.second);
+        processed = true;
+    }
+
+    return processed;
+}
+
+const uint32 SqlLatencyHistogram::BucketLimits[SqlLatencyHistogram::BUCKET_COUNT - 1] = { 5, 10, 25, 50, 100, 250, 500, 1000, 2500 };
+
+void SqlLatencyHistogram::Add(uint32 ms)
+{
+    uint32 bucket = 0;
+    while (bucket < BUCKET_COUNT - 1 && ms >= BucketLimits[bucket])
+    {
+        ++bucket;
+    }
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+    ++m_buckets[bucket];
+    ++m_count;
+    m_total += ms;
+    if (ms > m_max)
+    {
+        m_max = ms;
+    }
+}
+
+uint64 SqlLatencyHistogram::GetCount() const
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+    return m_count;
+}
+
+uint32 SqlLatencyHistogram::GetAverage() const
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+    return m_count ? uint32(m_total / m_count) : 0;
+}
+
+uint32 SqlLatencyHistogram::GetMax() const
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+    return m_max;
+}
+
+uint32 SqlLatencyHistogram::GetPercentile(uint32 percent) const
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+    if (!m_count)
+    {
+        return 0;
+    }
+
+    // rank of the wanted entry, rounded up
+    uint64 rank = (m_count * percent + 99) / 100;
+    uint64 counted = 0;
+    for (uint32 bucket = 0; bucket < BUCKET_COUNT - 1; ++bucket)
+    {
+        counted += m_buckets[bucket];
+        if (counted >= rank)
+        {
+            return std::min(BucketLimits[bucket], m_max);
+        }
+    }
+
+    return m_max;
+}
@@ -26,12 +26,15 @@
 #define MANGOS_H_SQLDELAYTHREAD
 
 #include <ace/Thread_Mutex.h>
+#include "Platform/Define.h"
 #include "LockedQueue/LockedQueue.h"
 #include "Threading/Threading.h"
+#include <cstring>
 
 class Database;
 class SqlOperation;
 class SqlConnection;
+class SqlQueryHolderEx;
 
 /**
  * @brief
@@ -90,4 +93,126 @@ class SqlDelayThread : public ACE_Based::Runnable
          */
         virtual void run();
 };
+
+/**
+ * @brief one query of an async query holder, by index in the holder
+ *
+ */
+typedef std::pair<SqlQueryHolderEx*, size_t> SqlHolderTask;
+/**
+ * @brief queue shared by all holder threads of a database
+ *
+ */
+typedef ACE_Based::LockedQueue<SqlHolderTask, ACE_Thread_Mutex> SqlHolderTaskQueue;
+
+/**
+ * @brief Runs the queries of async query holders on an own connection
+ *
+ * The delay thread splits each holder into one task per query, so the
+ * queries of a holder run at the same time on all holder threads instead
+ * of one after another on the async connection.
+ *
+ */
+class SqlHolderThread : public ACE_Based::Runnable
+{
+    private:
+        SqlHolderTaskQueue* m_taskQueue;                    /**< Queue of holder queries, shared by all holder threads */
+        SqlConnection* m_dbConnection;                      /**< Pointer to DB connection, used by this thread only */
+        volatile bool m_running; /**< TODO */
+
+        /**
+         * @brief process all enqueued queries
+         *
+         * @return bool false if there was nothing to do
+         */
+        bool ProcessTasks();
+
+    public:
+        /**
+         * @brief
+         *
+         * @param queue
+         * @param conn
+         */
+        SqlHolderThread(SqlHolderTaskQueue* queue, SqlConnection* conn);
+        /**
+         * @brief
+         *
+         */
+        ~SqlHolderThread();
+
+        /**
+         * @brief Stop event
+         *
+         */
+        virtual void Stop();
+        /**
+         * @brief Main Thread loop
+         *
+         */
+        virtual void run();
+};
+
+/**
+ * @brief Counts how long async query holders took, from queueing until all results were in
+ *
+ */
+class SqlLatencyHistogram
+{
+    public:
+        /**
+         * @brief upper bounds of the buckets in milliseconds, the last bucket has none
+         *
+         */
+        enum
+        {
+            BUCKET_COUNT = 10
+        };
+        static const uint32 BucketLimits[BUCKET_COUNT - 1];
+
+        /**
+         * @brief
+         *
+         */
+        SqlLatencyHistogram() : m_count(0), m_total(0), m_max(0) { memset(m_buckets, 0, sizeof(m_buckets)); }
+
+        /**
+         * @brief
+         *
+         * @param ms
+         */
+        void Add(uint32 ms);
+        /**
+         * @brief
+         *
+         * @return uint64
+         */
+        uint64 GetCount() const;
+        /**
+         * @brief
+         *
+         * @return uint32 average in milliseconds, 0 if nothing was counted
+         */
+        uint32 GetAverage() const;
+        /**
+         * @brief
+         *
+         * @return uint32
+         */
+        uint32 GetMax() const;
+        /**
+         * @brief upper bound of the bucket holding the given percentile
+         *
+         * @param percent
+         * @return uint32 milliseconds, the maximum for the last bucket
+         */
+        uint32 GetPercentile(uint32 percent) const;
+
+    private:
+        mutable ACE_Thread_Mutex m_lock; /**< TODO */
+        uint64 m_buckets[BUCKET_COUNT]; /**< TODO */
+        uint64 m_count; /**< TODO */
+        uint64 m_total; /**< TODO */
+        uint32 m_max; /**< TODO */
+};
 #endif                                                      //__SQLDELAYTHREAD_H
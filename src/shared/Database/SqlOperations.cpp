@@ -26,6 +26,7 @@
 #include "SqlDelayThread.h"
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
+#include "Utilities/Timer.h"
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
@@ -117,16 +118,16 @@ void SqlResultQueue::Update()
     }
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlDelayThread* thread, SqlResultQueue* queue)
 {
-    if (!callback || !thread || !queue)
+    if (!callback || !db || !thread || !queue)
     {
         return false;
     }
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
+    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue, db);
     thread->Delay(holderEx);
     return true;
 }
@@ -222,6 +223,12 @@ void SqlQueryHolder::SetSize(size_t size)
     m_queries.resize(size);
 }
 
+SqlQueryHolderEx::SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, Database* db)
+    : m_holder(holder), m_callback(callback), m_queue(queue), m_db(db), m_queueTime(getMSTime())
+{
+    m_pending = 1;
+}
+
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
 {
     if (!m_holder || !m_callback || !m_queue)
@@ -229,9 +236,26 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
         return false;
     }
 
-    LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
+
+    /// all writes queued before the holder are done at this point, so the
+    /// holder threads read the same data the async connection would
+    if (SqlHolderTaskQueue* tasks = m_db->GetHolderTaskQueue())
+    {
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            if (queries[i].first)
+            {
+                ++m_pending;
+                tasks->add(SqlHolderTask(this, i));
+            }
+        }
+
+        return true;
+    }
+
+    LOCK_DB_CONN(conn);
     for (size_t i = 0; i < queries.size(); ++i)
     {
         /// execute all queries in the holder and pass the results
@@ -242,8 +266,34 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
         }
     }
 
-    /// sync with the caller thread
-    m_queue->add(m_callback);
-
     return true;
 }
+
+void SqlQueryHolderEx::ExecuteQuery(SqlConnection* conn, size_t index)
+{
+    {
+        LOCK_DB_CONN(conn);
+        /// every thread writes its own slot, the vector itself is not resized
+        m_holder->SetResult(index, conn->Query(m_holder->m_queries[index].first));
+    }
+
+    Release();
+}
+
+void SqlQueryHolderEx::Release()
+{
+    if (--m_pending > 0)
+    {
+        return;
+    }
+
+    if (m_callback && m_queue && m_holder)
+    {
+        m_db->GetHolderLatency().Add(getMSTimeDiff(m_queueTime, getMSTime()));
+
+        /// sync with the caller thread
+        m_queue->add(m_callback);
+    }
+
+    delete this;
+}
@@ -28,6 +28,7 @@
 #include "Common/Common.h"
 
 #include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 #include "LockedQueue/LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
@@ -292,16 +293,22 @@ class SqlQueryHolder
          * @brief
          *
          * @param callback
+         * @param db
          * @param thread
          * @param queue
          * @return bool
          */
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        bool Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlDelayThread* thread, SqlResultQueue* queue);
 };
 
 /**
  * @brief
  *
+ * Runs the queries of a holder on the delay thread. When the database has
+ * holder threads, every query is handed to them instead and the callback
+ * is queued by whoever finishes the last one: the delay thread itself or
+ * one of the holder threads. The object deletes itself at that point.
+ *
  */
 class SqlQueryHolderEx : public SqlOperation
 {
@@ -309,6 +316,15 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder; /**< TODO */
         MaNGOS::IQueryCallback* m_callback; /**< TODO */
         SqlResultQueue* m_queue; /**< TODO */
+        Database* m_db; /**< TODO */
+        uint32 m_queueTime;                                 /**< getMSTime() when the holder was queued */
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_pending;    /**< queries still running, plus one for the delay thread */
+
+        /**
+         * @brief drops one reference, the last one queues the callback and deletes the object
+         *
+         */
+        void Release();
     public:
         /**
          * @brief
@@ -316,9 +332,9 @@ class SqlQueryHolderEx : public SqlOperation
          * @param holder
          * @param callback
          * @param queue
+         * @param db
          */
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, Database* db);
         /**
          * @brief
          *
@@ -326,5 +342,17 @@ class SqlQueryHolderEx : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        /**
+         * @brief called by the delay thread once Execute returned
+         *
+         */
+        void OnRemove() override { Release(); }
+        /**
+         * @brief runs one query of the holder, called by the holder threads
+         *
+         * @param conn
+         * @param index
+         */
+        void ExecuteQuery(SqlConnection* conn, size_t index);
 };
 #endif                                                      //__SQLOPERATIONS_H
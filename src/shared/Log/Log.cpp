@@ -24,6 +24,7 @@
 
 #include "Common/Common.h"
 #include "Log.h"
+#include "Log/LogWriter.h"
 #include "Policies/Singleton.h"
 #include "Config/Config.h"
 #include "Utilities/Util.h"
@@ -78,7 +79,7 @@ Log::Log() :
 #endif /* ENABLE_ELUNA */
 
     eventAiErLogfile(NULL), scriptErrLogFile(NULL), worldLogfile(NULL), wardenLogfile(NULL), m_colored(false),
-    m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(NULL)
+    m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(NULL), m_asyncWriter(NULL), m_asyncThread(NULL)
 {
     Initialize();
 }
@@ -317,6 +318,18 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    // Asynchronous file output
+    if (sConfig.GetBoolDefault("LogAsync", false) && !m_asyncWriter)
+    {
+        int bufferSize = sConfig.GetIntDefault("LogAsyncBufferSize", 256);
+        int flushInterval = sConfig.GetIntDefault("LogAsyncFlushInterval", 1000);
+
+        m_asyncWriter = new LogWriter(size_t(bufferSize < 16 ? 16 : bufferSize) * 1024, uint32(flushInterval < 10 ? 10 : flushInterval),
+                                      sConfig.GetBoolDefault("LogAsyncDropOnFull", false));
+        m_asyncWriter->incReference();                      // outlives its thread, see StopAsyncWriter
+        m_asyncThread = new ACE_Based::Thread(m_asyncWriter);
+    }
 }
 
 FILE* Log::openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode)
@@ -355,7 +368,7 @@ FILE* Log::openGmlogPerAccount(uint32 account)
     return fopen(namebuf, "a");
 }
 
-void Log::outTimestamp(FILE* file)
+size_t Log::formatTimestamp(char* buf, size_t size)
 {
     time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     std::tm aTm = safe_localtime(tt);
@@ -366,7 +379,121 @@ void Log::outTimestamp(FILE* file)
     //       HH     hour (2 digits 00-23)
     //       MM     minutes (2 digits 00-59)
     //       SS     seconds (2 digits 00-59)
-    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
+    int len = snprintf(buf, size, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
+    return len < 0 ? 0 : std::min(size_t(len), size - 1);
+}
+
+void Log::outTimestamp(FILE* file)
+{
+    char buf[32];
+    size_t len = formatTimestamp(buf, sizeof(buf));
+    fwrite(buf, 1, len, file);
+}
+
+void Log::writeLogLine(FILE* file, char const* prefix, char const* format, va_list* ap)
+{
+    // most lines fit into the stack buffer, longer ones are formatted a second time into a string
+    char buf[1024];
+    size_t len = formatTimestamp(buf, sizeof(buf));
+
+    if (prefix)
+    {
+        size_t prefixLen = std::min(strlen(prefix), sizeof(buf) - len - 1);
+        memcpy(buf + len, prefix, prefixLen);
+        len += prefixLen;
+    }
+
+    std::string longLine;
+    if (format)
+    {
+        va_list apCopy;
+        va_copy(apCopy, *ap);
+        int msgLen = vsnprintf(buf + len, sizeof(buf) - len, format, apCopy);
+        va_end(apCopy);
+
+        if (msgLen > 0 && len + msgLen + 1 >= sizeof(buf))
+        {
+            longLine.assign(buf, len);
+            longLine.resize(len + msgLen + 1);
+            vsnprintf(&longLine[len], msgLen + 1, format, *ap);
+            longLine[len + msgLen] = '\n';
+            writeLogText(file, longLine.c_str(), longLine.size());
+            return;
+        }
+
+        if (msgLen > 0)
+        {
+            len += msgLen;
+        }
+    }
+
+    buf[len++] = '\n';
+    writeLogText(file, buf, len);
+}
+
+void Log::writeLogText(FILE* file, char const* text, size_t size)
+{
+    if (m_asyncWriter)
+    {
+        m_asyncWriter->Write(file, text, size);
+        return;
+    }
+
+    fwrite(text, 1, size, file);
+    fflush(file);
+}
+
+void Log::Flush()
+{
+    if (m_asyncWriter)
+    {
+        m_asyncWriter->Flush();
+    }
+}
+
+void Log::FlushOnCrash()
+{
+    if (m_asyncWriter)
+    {
+        m_asyncWriter->FlushOnCrash();
+    }
+}
+
+void Log::StopAsyncWriter()
+{
+    if (!m_asyncThread)
+    {
+        return;
+    }
+
+    m_asyncWriter->Stop();
+    m_asyncThread->wait();
+
+    // other threads may still be logging through the writer, which now lets them write directly;
+    // it is only deleted with the log itself
+    delete m_asyncThread;
+    m_asyncThread = NULL;
+}
+
+void Log::ReleaseAsyncWriter()
+{
+    if (!m_asyncWriter)
+    {
+        return;
+    }
+
+    m_asyncWriter->decReference();
+    m_asyncWriter = NULL;
+}
+
+uint64 Log::GetAsyncDroppedCount() const
+{
+    return m_asyncWriter ? m_asyncWriter->GetDroppedCount() : 0;
+}
+
+uint64 Log::GetAsyncOverflowCount() const
+{
+    return m_asyncWriter ? m_asyncWriter->GetOverflowCount() : 0;
 }
 
 void Log::outTime()
@@ -409,9 +536,7 @@ void Log::outString()
     printf("\n");
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        writeLogLine(logfile, NULL);
     }
 
     fflush(stdout);
@@ -449,14 +574,9 @@ void Log::outString(const char* str, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        writeLogLine(logfile, NULL, str, &ap);
         va_end(ap);
-
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -493,15 +613,9 @@ void Log::outError(const char* err, ...)
     fprintf(stderr, "\n");
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        writeLogLine(logfile, "ERROR:", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stderr);
@@ -518,16 +632,12 @@ void Log::outErrorDb()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n");
-        fflush(logfile);
+        writeLogLine(logfile, "ERROR:");
     }
 
     if (dberLogfile)
     {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
+        writeLogLine(dberLogfile, NULL);
     }
 
     fflush(stderr);
@@ -565,28 +675,17 @@ void Log::outErrorDb(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        writeLogLine(logfile, "ERROR:", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (dberLogfile)
     {
-        outTimestamp(dberLogfile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
+        writeLogLine(dberLogfile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
     }
 
     fflush(stderr);
@@ -604,16 +703,12 @@ void Log::outErrorEluna()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR Eluna\n");
-        fflush(logfile);
+        writeLogLine(logfile, "ERROR Eluna");
     }
 
     if (elunaErrLogfile)
     {
-        outTimestamp(elunaErrLogfile);
-        fprintf(elunaErrLogfile, "\n");
-        fflush(elunaErrLogfile);
+        writeLogLine(elunaErrLogfile, NULL);
     }
 
     fflush(stderr);
@@ -656,28 +751,17 @@ void Log::outErrorEluna(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR Eluna: ");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        writeLogLine(logfile, "ERROR Eluna: ", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (elunaErrLogfile)
     {
-        outTimestamp(elunaErrLogfile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(elunaErrLogfile, err, ap);
+        writeLogLine(elunaErrLogfile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(elunaErrLogfile, "\n");
-        fflush(elunaErrLogfile);
     }
 
     fflush(stderr);
@@ -698,16 +782,12 @@ void Log::outErrorEventAI()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI\n");
-        fflush(logfile);
+        writeLogLine(logfile, "ERROR CreatureEventAI");
     }
 
     if (eventAiErLogfile)
     {
-        outTimestamp(eventAiErLogfile);
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
+        writeLogLine(eventAiErLogfile, NULL);
     }
 
     fflush(stderr);
@@ -745,28 +825,17 @@ void Log::outErrorEventAI(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI: ");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        writeLogLine(logfile, "ERROR CreatureEventAI: ", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (eventAiErLogfile)
     {
-        outTimestamp(eventAiErLogfile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(eventAiErLogfile, err, ap);
+        writeLogLine(eventAiErLogfile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
     }
 
     fflush(stderr);
@@ -807,12 +876,9 @@ void Log::outBasic(const char* str, ...)
     if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        writeLogLine(logfile, NULL, str, &ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -852,15 +918,10 @@ void Log::outDetail(const char* str, ...)
 
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        writeLogLine(logfile, NULL, str, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -900,15 +961,10 @@ void Log::outDebug(const char* str, ...)
 
     if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        writeLogLine(logfile, NULL, str, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -949,12 +1005,9 @@ void Log::outCommand(uint32 account, const char* str, ...)
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        writeLogLine(logfile, NULL, str, &ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     if (m_gmlog_per_account)
@@ -973,12 +1026,9 @@ void Log::outCommand(uint32 account, const char* str, ...)
     else if (gmLogfile)
     {
         va_list ap;
-        outTimestamp(gmLogfile);
         va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n");
+        writeLogLine(gmLogfile, NULL, str, &ap);
         va_end(ap);
-        fflush(gmLogfile);
     }
 
     fflush(stdout);
@@ -993,9 +1043,7 @@ void Log::outWarden()
     printf("\n");
     if (wardenLogfile)
     {
-        outTimestamp(wardenLogfile);
-        fprintf(wardenLogfile, "\n");
-        fflush(wardenLogfile);
+        writeLogLine(wardenLogfile, NULL);
     }
 
     fflush(stdout);
@@ -1037,15 +1085,9 @@ void Log::outWarden(const char* str, ...)
     {
         va_list ap;
 
-        outTimestamp(wardenLogfile);
-        fprintf(wardenLogfile, "[Warden]: ");
-
         va_start(ap, str);
-        vfprintf(wardenLogfile, str, ap);
-        fprintf(wardenLogfile, "\n");
+        writeLogLine(wardenLogfile, "[Warden]: ", str, &ap);
         va_end(ap);
-
-        fflush(wardenLogfile);
     }
 
     fflush(stdout);
@@ -1061,12 +1103,9 @@ void Log::outChar(const char* str, ...)
     if (charLogfile)
     {
         va_list ap;
-        outTimestamp(charLogfile);
         va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n");
+        writeLogLine(charLogfile, NULL, str, &ap);
         va_end(ap);
-        fflush(charLogfile);
     }
 }
 
@@ -1081,23 +1120,23 @@ void Log::outErrorScriptLib()
 
     if (logfile)
     {
-        outTimestamp(logfile);
+        // timestamp and prefix only, without a line end
+        char buf[32];
+        std::string text(buf, formatTimestamp(buf, sizeof(buf)));
         if (m_scriptLibName)
         {
-            fprintf(logfile, "<%s ERROR:> ", m_scriptLibName);
+            text = text + "<" + m_scriptLibName + " ERROR:> ";
         }
         else
         {
-            fprintf(logfile, "<Scripting Library ERROR>: ");
+            text += "<Scripting Library ERROR>: ";
         }
-        fflush(logfile);
+        writeLogText(logfile, text.c_str(), text.size());
     }
 
     if (scriptErrLogFile)
     {
-        outTimestamp(scriptErrLogFile);
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        writeLogLine(scriptErrLogFile, NULL);
     }
 
     fflush(stderr);
@@ -1135,35 +1174,19 @@ void Log::outErrorScriptLib(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-        {
-            fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
-        }
-        else
-        {
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        }
+        std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR>: " : std::string("<Scripting Library ERROR>: ");
 
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        writeLogLine(logfile, prefix.c_str(), err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (scriptErrLogFile)
     {
-        outTimestamp(scriptErrLogFile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(scriptErrLogFile, err, ap);
+        writeLogLine(scriptErrLogFile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
     }
 
     fflush(stderr);
@@ -1176,35 +1199,50 @@ void Log::outWorldPacketDump(uint32 socket, uint32 opcode, char const* opcodeNam
         return;
     }
 
-    ACE_GUARD(ACE_Thread_Mutex, GuardObj, m_worldLogMtx);
+    char header[256];
+    int len = snprintf(header, sizeof(header), "\n%s:\nSOCKET: %u\nLENGTH: %zu\nOPCODE: %s (0x%.4X)\nDATA:\n",
+                       incoming ? "CLIENT" : "SERVER",
+                       socket, packet->size(), opcodeName, opcode);
+
+    char timestamp[32];
+    size_t timestampLen = formatTimestamp(timestamp, sizeof(timestamp));
 
-    outTimestamp(worldLogfile);
+    std::string text;
+    text.reserve(timestampLen + sizeof(header) + packet->size() * 3 + packet->size() / 16 + 3);
+    text.append(timestamp, timestampLen);
+    text.append(header, std::min(size_t(std::max(len, 0)), sizeof(header) - 1));
 
-    fprintf(worldLogfile, "\n%s:\nSOCKET: %u\nLENGTH: %zu\nOPCODE: %s (0x%.4X)\nDATA:\n",
-            incoming ? "CLIENT" : "SERVER",
-            socket, packet->size(), opcodeName, opcode);
+    static char const hex[] = "0123456789ABCDEF";
 
     size_t p = 0;
     while (p < packet->size())
     {
         for (size_t j = 0; j < 16 && p < packet->size(); ++j)
         {
-            fprintf(worldLogfile, "%.2X ", (*packet)[p++]);
+            uint8 value = (*packet)[p++];
+            text += hex[value >> 4];
+            text += hex[value & 0x0F];
+            text += ' ';
         }
 
-        fprintf(worldLogfile, "\n");
+        text += '\n';
     }
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    text += "\n\n";
+
+    // keeps dumps of different sockets from interleaving in synchronous mode
+    ACE_GUARD(ACE_Thread_Mutex, GuardObj, m_worldLogMtx);
+    writeLogText(worldLogfile, text.c_str(), text.size());
 }
 
 void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
 {
     if (charLogfile)
     {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n", account_id, guid, name, str);
-        fflush(charLogfile);
+        std::ostringstream ss;
+        ss << "== START DUMP == (account: " << account_id << " guid: " << guid << " name: " << name << " )\n" << str << "\n== END DUMP ==\n";
+        std::string text = ss.str();
+        writeLogText(charLogfile, text.c_str(), text.size());
     }
 }
 
@@ -1218,12 +1256,9 @@ void Log::outRALog(const char* str, ...)
     if (raLogfile)
     {
         va_list ap;
-        outTimestamp(raLogfile);
         va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n");
+        writeLogLine(raLogfile, NULL, str, &ap);
         va_end(ap);
-        fflush(raLogfile);
     }
 
     fflush(stdout);
@@ -1258,6 +1293,11 @@ void Log::setScriptLibraryErrorFile(char const* fname, char const* libName)
 
     if (scriptErrLogFile)
     {
+        // lines still queued for the old file have to reach it before it is closed
+        if (m_asyncWriter)
+        {
+            m_asyncWriter->Flush();
+        }
         fclose(scriptErrLogFile);
     }
 
@@ -28,8 +28,16 @@
 #include "Common/Common.h"
 #include "Policies/Singleton.h"
 
+#include <cstdarg>
+
 class Config;
 class ByteBuffer;
+class LogWriter;
+
+namespace ACE_Based
+{
+    class Thread;
+}
 
 /**
  * @brief various levels for logging
@@ -129,6 +137,9 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
          */
         ~Log()
         {
+            StopAsyncWriter();
+            ReleaseAsyncWriter();
+
             if (logfile != NULL)
             {
                 fclose(logfile);
@@ -383,6 +394,33 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
          * @return std::string
          */
         static std::string GetTimestampStr();
+        /**
+         * @brief writes all lines queued for the log files and flushes them
+         *
+         */
+        void Flush();
+        /**
+         * @brief best effort flush of the queued lines from a crash handler
+         *
+         */
+        void FlushOnCrash();
+        /**
+         * @brief stops the asynchronous writer thread, lines are written directly afterwards
+         *
+         */
+        void StopAsyncWriter();
+        /**
+         * @brief lines dropped because a per thread log buffer was full
+         *
+         * @return uint64
+         */
+        uint64 GetAsyncDroppedCount() const;
+        /**
+         * @brief lines written by the logging thread because its log buffer was full
+         *
+         * @return uint64
+         */
+        uint64 GetAsyncOverflowCount() const;
         /**
          * @brief
          *
@@ -432,6 +470,11 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         void setScriptLibraryErrorFile(char const* fname, char const* libName);
 
     private:
+        /**
+         * @brief deletes the stopped asynchronous writer, writing out what is still queued
+         *
+         */
+        void ReleaseAsyncWriter();
         /**
          * @brief
          *
@@ -448,6 +491,31 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
          * @return FILE
          */
         FILE* openGmlogPerAccount(uint32 account);
+        /**
+         * @brief
+         *
+         * @param buf
+         * @param size
+         * @return size_t length of the timestamp written to buf
+         */
+        static size_t formatTimestamp(char* buf, size_t size);
+        /**
+         * @brief writes timestamp, prefix, formatted message and a line end to the file
+         *
+         * @param file
+         * @param prefix may be NULL
+         * @param format may be NULL
+         * @param ap
+         */
+        void writeLogLine(FILE* file, char const* prefix, char const* format = NULL, va_list* ap = NULL);
+        /**
+         * @brief hands already formatted text to the asynchronous writer, or writes it directly
+         *
+         * @param file
+         * @param text
+         * @param size
+         */
+        void writeLogText(FILE* file, char const* text, size_t size);
 
         FILE* raLogfile; /**< TODO */
         FILE* logfile; /**< TODO */
@@ -483,6 +551,10 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         std::string m_gmlog_filename_format; /**< TODO */
 
         char const* m_scriptLibName; /**< TODO */
+
+        // asynchronous file output
+        LogWriter* m_asyncWriter; /**< NULL when LogAsync is off */
+        ACE_Based::Thread* m_asyncThread; /**< TODO */
 };
 
 #define sLog MaNGOS::Singleton<Log>::Instance()
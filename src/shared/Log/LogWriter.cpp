@@ -0,0 +1,381 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#include "Log/LogWriter.h"
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <errno.h>
+#include <ace/OS_NS_Thread.h>
+
+namespace
+{
+    std::atomic<uint32> s_nextGeneration(0);
+
+    /**
+     * @brief per thread handle of the ring buffer owned by the current writer
+     *
+     * Marks the ring as released when the thread exits so the writer can free it.
+     * The flag is owned by the ring and the thread together, so a thread exiting
+     * after the writer freed its rings only touches its own reference.
+     */
+    struct ThreadRing
+    {
+        ThreadRing() : generation(0), ring(NULL) {}
+        ~ThreadRing()
+        {
+            if (released)
+            {
+                released->store(true, std::memory_order_release);
+            }
+        }
+
+        uint32 generation;
+        void* ring;
+        std::shared_ptr<std::atomic<bool> > released;
+    };
+
+    thread_local ThreadRing t_threadRing;
+
+    /**
+     * @brief writes to a file descriptor with async signal safe calls only
+     */
+    void WriteRaw(int fd, char const* data, size_t size)
+    {
+        while (size)
+        {
+#ifdef WIN32
+            int written = _write(fd, data, unsigned(size));
+#else
+            ssize_t written = write(fd, data, size);
+#endif
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                return;
+            }
+
+            data += written;
+            size -= size_t(written);
+        }
+    }
+}
+
+/**
+ * @brief makes the caller the only consumer of the rings
+ *
+ * Consumers serialize on m_drainLock and additionally claim m_draining, which is
+ * all the crash handler can check without risking a deadlock.
+ */
+class LogWriter::DrainGuard
+{
+    public:
+        explicit DrainGuard(LogWriter& writer) : m_writer(writer)
+        {
+            m_writer.m_drainLock.acquire();
+
+            // only fails while the crash handler writes, the process is about to end then
+            bool expected = false;
+            while (!m_writer.m_draining.compare_exchange_weak(expected, true, std::memory_order_acquire))
+            {
+                expected = false;
+                ACE_OS::thr_yield();
+            }
+        }
+
+        ~DrainGuard()
+        {
+            m_writer.m_draining.store(false, std::memory_order_release);
+            m_writer.m_drainLock.release();
+        }
+
+    private:
+        LogWriter& m_writer;
+};
+
+LogWriter::RingBuffer::RingBuffer(size_t size) : data(new char[size]), capacity(size), head(0), tail(0),
+    released(std::make_shared<std::atomic<bool> >(false)), next(NULL)
+{
+}
+
+LogWriter::RingBuffer::~RingBuffer()
+{
+    delete[] data;
+}
+
+LogWriter::LogWriter(size_t bufferSize, uint32 flushInterval, bool dropOnFull) :
+    m_bufferSize(bufferSize), m_flushInterval(flushInterval), m_dropOnFull(dropOnFull),
+    m_generation(++s_nextGeneration), m_running(true), m_buffers(NULL), m_draining(false), m_dropped(0), m_overflow(0)
+{
+}
+
+LogWriter::~LogWriter()
+{
+    {
+        DrainGuard guard(*this);
+        DrainAll();
+        FlushFiles();
+    }
+
+    RingBuffer* ring = m_buffers.load(std::memory_order_acquire);
+    while (ring)
+    {
+        RingBuffer* next = ring->next;
+        delete ring;
+        ring = next;
+    }
+}
+
+void LogWriter::run()
+{
+    const uint32 loopSleepms = 10;
+
+    uint32 sinceFlush = 0;
+    while (m_running)
+    {
+        ACE_Based::Thread::Sleep(loopSleepms);
+        sinceFlush += loopSleepms;
+
+        DrainGuard guard(*this);
+        DrainAll();
+
+        if (sinceFlush >= m_flushInterval)
+        {
+            FlushFiles();
+            sinceFlush = 0;
+        }
+    }
+
+    // write out what was queued while stopping
+    DrainGuard guard(*this);
+    DrainAll();
+    FlushFiles();
+}
+
+void LogWriter::Write(FILE* file, char const* data, size_t size)
+{
+    RingBuffer* ring = GetThreadBuffer();
+    size_t need = sizeof(RecordHeader) + size;
+
+    // once stopped, and for lines not fitting into a ring at all, the logging thread writes itself, after its queued lines
+    bool stopped = !m_running.load(std::memory_order_acquire);
+    if (stopped || need > ring->capacity)
+    {
+        if (!stopped)
+        {
+            ++m_overflow;
+        }
+
+        DrainGuard guard(*this);
+        DrainBuffer(ring);
+        fwrite(data, 1, size, file);
+        m_dirtyFiles.insert(file);
+
+        if (stopped)
+        {
+            FlushFiles();
+        }
+        return;
+    }
+
+    size_t head = ring->head.load(std::memory_order_relaxed);
+    if (ring->capacity - (head - ring->tail.load(std::memory_order_acquire)) < need)
+    {
+        if (m_dropOnFull)
+        {
+            ++m_dropped;
+            return;
+        }
+
+        // the writer fell behind, make room by draining the own ring
+        ++m_overflow;
+
+        DrainGuard guard(*this);
+        DrainBuffer(ring);
+    }
+
+    RecordHeader header;
+    header.file = file;
+    header.fd = fileno(file);
+    header.size = size;
+
+    CopyIn(ring, head, reinterpret_cast<char const*>(&header), sizeof(RecordHeader));
+    CopyIn(ring, head + sizeof(RecordHeader), data, size);
+    ring->head.store(head + need, std::memory_order_release);
+}
+
+void LogWriter::Flush()
+{
+    DrainGuard guard(*this);
+    DrainAll();
+    FlushFiles();
+}
+
+void LogWriter::FlushOnCrash()
+{
+    // the crashing thread may be a consumer itself, never wait for it
+    bool expected = false;
+    if (!m_draining.compare_exchange_strong(expected, true, std::memory_order_acquire))
+    {
+        return;
+    }
+
+    for (RingBuffer* ring = m_buffers.load(std::memory_order_acquire); ring; ring = ring->next)
+    {
+        DrainOnCrash(ring);
+    }
+
+    m_draining.store(false, std::memory_order_release);
+}
+
+LogWriter::RingBuffer* LogWriter::GetThreadBuffer()
+{
+    if (t_threadRing.generation == m_generation)
+    {
+        return static_cast<RingBuffer*>(t_threadRing.ring);
+    }
+
+    RingBuffer* ring = new RingBuffer(m_bufferSize);
+
+    ring->next = m_buffers.load(std::memory_order_relaxed);
+    while (!m_buffers.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+
+    t_threadRing.generation = m_generation;
+    t_threadRing.ring = ring;
+    t_threadRing.released = ring->released;
+    return ring;
+}
+
+void LogWriter::CopyIn(RingBuffer* ring, size_t pos, char const* src, size_t size)
+{
+    size_t offset = pos % ring->capacity;
+    size_t first = std::min(size, ring->capacity - offset);
+
+    memcpy(ring->data + offset, src, first);
+    memcpy(ring->data, src + first, size - first);
+}
+
+void LogWriter::CopyOut(RingBuffer* ring, size_t pos, char* dst, size_t size)
+{
+    size_t offset = pos % ring->capacity;
+    size_t first = std::min(size, ring->capacity - offset);
+
+    memcpy(dst, ring->data + offset, first);
+    memcpy(dst + first, ring->data, size - first);
+}
+
+void LogWriter::WriteOut(RingBuffer* ring, size_t pos, FILE* file, size_t size)
+{
+    size_t offset = pos % ring->capacity;
+    size_t first = std::min(size, ring->capacity - offset);
+
+    fwrite(ring->data + offset, 1, first, file);
+    if (first < size)
+    {
+        fwrite(ring->data, 1, size - first, file);
+    }
+}
+
+void LogWriter::DrainBuffer(RingBuffer* ring)
+{
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    size_t head = ring->head.load(std::memory_order_acquire);
+
+    while (tail != head)
+    {
+        RecordHeader header;
+        CopyOut(ring, tail, reinterpret_cast<char*>(&header), sizeof(RecordHeader));
+        WriteOut(ring, tail + sizeof(RecordHeader), header.file, header.size);
+        m_dirtyFiles.insert(header.file);
+
+        tail += sizeof(RecordHeader) + header.size;
+    }
+
+    ring->tail.store(tail, std::memory_order_release);
+}
+
+void LogWriter::DrainAll()
+{
+    RingBuffer* prev = NULL;
+    RingBuffer* ring = m_buffers.load(std::memory_order_acquire);
+    while (ring)
+    {
+        DrainBuffer(ring);
+
+        RingBuffer* next = ring->next;
+
+        // rings of exited threads are freed once empty, the list head belongs to the producers
+        if (prev && ring->released->load(std::memory_order_acquire) &&
+            ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire))
+        {
+            prev->next = next;
+            delete ring;
+        }
+        else
+        {
+            prev = ring;
+        }
+
+        ring = next;
+    }
+}
+
+void LogWriter::FlushFiles()
+{
+    for (std::set<FILE*>::const_iterator itr = m_dirtyFiles.begin(); itr != m_dirtyFiles.end(); ++itr)
+    {
+        fflush(*itr);
+    }
+
+    m_dirtyFiles.clear();
+}
+
+void LogWriter::DrainOnCrash(RingBuffer* ring)
+{
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    size_t head = ring->head.load(std::memory_order_acquire);
+
+    while (tail != head)
+    {
+        RecordHeader header;
+        CopyOut(ring, tail, reinterpret_cast<char*>(&header), sizeof(RecordHeader));
+
+        size_t pos = tail + sizeof(RecordHeader);
+        size_t offset = pos % ring->capacity;
+        size_t first = std::min(header.size, ring->capacity - offset);
+        WriteRaw(header.fd, ring->data + offset, first);
+        WriteRaw(header.fd, ring->data, header.size - first);
+
+        tail = pos + header.size;
+    }
+
+    ring->tail.store(tail, std::memory_order_release);
+}
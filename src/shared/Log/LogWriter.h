@@ -0,0 +1,154 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#ifndef MANGOSSERVER_LOGWRITER_H
+#define MANGOSSERVER_LOGWRITER_H
+
+#include "Common/Common.h"
+#include "Threading/Threading.h"
+
+#include <ace/Thread_Mutex.h>
+#include <atomic>
+#include <memory>
+#include <set>
+
+/**
+ * @brief Background writer for the log files.
+ *
+ * Every thread that logs gets its own single producer / single consumer ring
+ * buffer, so formatting a line never takes a lock shared with other threads.
+ * The writer thread drains all rings into the stdio buffers of the target files
+ * and flushes them to disk on a timer.
+ */
+class LogWriter : public ACE_Based::Runnable
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param bufferSize size in bytes of every per thread ring buffer
+         * @param flushInterval time in ms between two flushes of the log files
+         * @param dropOnFull drop lines when a ring is full instead of waiting for the writer
+         */
+        LogWriter(size_t bufferSize, uint32 flushInterval, bool dropOnFull);
+        /**
+         * @brief writes out everything still queued
+         *
+         */
+        ~LogWriter();
+
+        /**
+         * @brief drains the ring buffers until stopped
+         *
+         */
+        void run() override;
+        /**
+         * @brief ends run(), lines are written directly by the logging threads afterwards
+         *
+         */
+        void Stop() { m_running.store(false); }
+
+        /**
+         * @brief queues an already formatted line for the given file
+         *
+         * @param file
+         * @param data
+         * @param size
+         */
+        void Write(FILE* file, char const* data, size_t size);
+        /**
+         * @brief writes all queued lines and flushes the files, from any thread
+         *
+         */
+        void Flush();
+        /**
+         * @brief best effort write of the queued lines from a crash handler
+         *
+         * Only async signal safe calls are used: nothing is written if another thread
+         * is draining the rings, and lines already in the stdio buffers are lost.
+         */
+        void FlushOnCrash();
+
+        /**
+         * @brief lines lost because a ring buffer was full
+         *
+         * @return uint64
+         */
+        uint64 GetDroppedCount() const { return m_dropped; }
+        /**
+         * @brief lines written by the logging thread itself because a ring was full or the line too big
+         *
+         * @return uint64
+         */
+        uint64 GetOverflowCount() const { return m_overflow; }
+
+    private:
+        struct RecordHeader
+        {
+            FILE* file;
+            int fd;                                         // for the crash handler, which can not use stdio
+            size_t size;
+        };
+
+        struct RingBuffer
+        {
+            explicit RingBuffer(size_t size);
+            ~RingBuffer();
+
+            char* data;
+            size_t capacity;
+            std::atomic<size_t> head;                       // bytes written, owned by the producer
+            std::atomic<size_t> tail;                       // bytes read, owned by the consumer
+            std::shared_ptr<std::atomic<bool> > released;   // the producer thread has exited, shared with the thread so it outlives the ring
+            RingBuffer* next;
+        };
+
+        class DrainGuard;
+
+        RingBuffer* GetThreadBuffer();
+        void CopyIn(RingBuffer* ring, size_t pos, char const* src, size_t size);
+        void CopyOut(RingBuffer* ring, size_t pos, char* dst, size_t size);
+        void WriteOut(RingBuffer* ring, size_t pos, FILE* file, size_t size);
+
+        // callers hold a DrainGuard
+        void DrainBuffer(RingBuffer* ring);
+        void DrainAll();
+        void FlushFiles();
+        void DrainOnCrash(RingBuffer* ring);
+
+        size_t m_bufferSize;
+        uint32 m_flushInterval;
+        bool m_dropOnFull;
+        uint32 m_generation;                                // tells apart rings of an earlier writer
+        std::atomic<bool> m_running;
+
+        std::atomic<RingBuffer*> m_buffers;                 // pushed by producers, unlinked by the consumer
+        ACE_Thread_Mutex m_drainLock;                       // only one consumer at a time
+        std::atomic<bool> m_draining;                       // set by the consumer holding m_drainLock, or the crash handler
+        std::set<FILE*> m_dirtyFiles;
+
+        std::atomic<uint64> m_dropped;
+        std::atomic<uint64> m_overflow;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_INLINEVECTOR_H
+#define MANGOS_INLINEVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * Vector keeping its first N elements inside the object, for short lists that are
+ * filled and dropped very often (spell targets). Only grows on the heap beyond N.
+ *
+ * Elements must be default constructible and copyable. Pointers and iterators are
+ * invalidated by push_back() once the inline capacity is exceeded, like std::vector.
+ */
+template<class T, size_t N>
+class InlineVector
+{
+    public:
+        typedef T value_type;
+        typedef T* iterator;
+        typedef T const* const_iterator;
+
+        InlineVector() : m_data(m_inline), m_size(0), m_capacity(N) {}
+        ~InlineVector() { FreeHeap(); }
+
+        iterator begin() { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end() const { return m_data + m_size; }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        T& operator[](size_t index) { return m_data[index]; }
+        T const& operator[](size_t index) const { return m_data[index]; }
+
+        void push_back(T const& value)
+        {
+            if (m_size == m_capacity)
+            {
+                T* data = new T[m_capacity * 2];
+                std::copy(m_data, m_data + m_size, data);
+                FreeHeap();
+                m_data = data;
+                m_capacity *= 2;
+            }
+
+            m_data[m_size++] = value;
+        }
+
+        // keeps heap storage if any, the list is usually refilled right after
+        void clear() { m_size = 0; }
+
+    private:
+        InlineVector(InlineVector const&);
+        InlineVector& operator=(InlineVector const&);
+
+        void FreeHeap()
+        {
+            if (m_data != m_inline)
+            {
+                delete[] m_data;
+            }
+        }
+
+        T m_inline[N];
+        T* m_data;
+        size_t m_size;
+        size_t m_capacity;
+};
+
+#endif